@@ -597,6 +597,10 @@ namespace Temp::AudioSystem
 
   void ReadAudioFiles(Data& data, const GlobalDynamicArray<GlobalString>& files)
   {
+    if (data.isNull)
+    {
+      return;
+    }
     MemoryManager::ScopedTempMemory temp;
 
     data.buffers.Fill(GlobalDynamicArray<short>(true));
@@ -630,6 +634,10 @@ namespace Temp::AudioSystem
 
   void PlayAudio(Data& data, int audioIndex, std::atomic<bool>& stopHandle)
   {
+    if (data.isNull)
+    {
+      return;
+    }
     int usedIndex = -1;
     for (size_t currTask = 0; currTask < globalTaskDatas.size; ++currTask)
     {
@@ -657,6 +665,10 @@ namespace Temp::AudioSystem
 
   void PlayAudioLoop(Data& data, int audioIndex, std::atomic<bool>& stopHandle)
   {
+    if (data.isNull)
+    {
+      return;
+    }
     int usedIndex = -1;
     for (size_t currTask = 0; currTask < globalTaskDatas.size; ++currTask)
     {
@@ -695,6 +707,10 @@ namespace Temp::AudioSystem
 
   void Destruct(Data& data)
   {
+    if (data.isNull)
+    {
+      return;
+    }
     data.stop = true;
     ThreadPool::Destruct(threadPool);
   }
@@ -16,6 +16,8 @@ namespace Temp::AudioSystem
     GlobalArray<bool, MAX_AUDIO_FILES> currentlyPlayedAudio{};
     std::atomic<bool> stop{false};
     std::mutex mtx{};
+    // Null sink, files aren't read and nothing gets played (headless runs)
+    bool isNull{false};
   };
 
   void ReadAudioFiles(Data& data, const GlobalDynamicArray<GlobalString>& files);
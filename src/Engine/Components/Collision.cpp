@@ -0,0 +1,517 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#include "Collision.hpp"
+#include "ComponentType.hpp"
+#include "Logger.hpp"
+#include "Scene.hpp"
+#include "ThreadPool.hpp"
+
+namespace Temp::Component::Collision
+{
+  namespace
+  {
+    struct Job
+    {
+      const Data* collisions{nullptr};
+      size_t begin{0};
+      size_t end{0};
+      SceneDynamicArray<Contact>* contacts{nullptr};
+      size_t count{0};
+    };
+
+    void RunJob(void* data)
+    {
+      auto& job = *static_cast<Job*>(data);
+      job.count = Sweep(*job.collisions,
+                        job.begin,
+                        job.end,
+                        job.contacts->buffer,
+                        job.contacts->capacity);
+    }
+
+    template <typename T>
+    void Resize(SceneDynamicArray<T>& array, size_t size)
+    {
+      array.Reserve(size);
+      array.size = size;
+    }
+
+    template <typename T>
+    Math::Vec2f Scale(const T& scaleArray, Entity::id entity)
+    {
+      size_t index = scaleArray.sparseIndices[entity];
+      return index != SIZE_MAX ? scaleArray.array[index] : Math::Vec2f{1.f, 1.f};
+    }
+
+    [[nodiscard]] constexpr uint64_t PairKey(Entity::id a, Entity::id b)
+    {
+      return a < b ? (uint64_t)a << 32 | b : (uint64_t)b << 32 | a;
+    }
+
+    // Sorts order by bodies' minX. Last frame's order is nearly sorted so insertion sort is
+    // about linear, teleporting lots of bodies falls back to std::sort.
+    void SortOrder(Data& collisions)
+    {
+      auto& order = collisions.order;
+      const auto& bodies = collisions.bodies;
+      size_t numBodies = bodies.size;
+      auto less = [&bodies](uint32_t a, uint32_t b) { return bodies[a].bounds.x < bodies[b].bounds.x; };
+
+      if (order.size != numBodies)
+      {
+        Resize(order, numBodies);
+        for (size_t i = 0; i < numBodies; ++i)
+        {
+          order[i] = (uint32_t)i;
+        }
+        std::sort(order.begin(), order.end(), less);
+        return;
+      }
+
+      size_t budget = numBodies * 8;
+      for (size_t i = 1; i < numBodies; ++i)
+      {
+        uint32_t body = order[i];
+        size_t j = i;
+        for (; j > 0 && less(body, order[j - 1]) && budget > 0; --j, --budget)
+        {
+          order[j] = order[j - 1];
+        }
+        order[j] = body;
+        if (budget == 0)
+        {
+          std::sort(order.begin(), order.end(), less);
+          return;
+        }
+      }
+    }
+  }
+
+  void Init(Data& collisions)
+  {
+    collisions.bodies = SceneDynamicArray<Body>(true, Entity::PAGE_SIZE);
+    collisions.order = SceneDynamicArray<uint32_t>(true, Entity::PAGE_SIZE);
+    collisions.entities = SceneDynamicArray<Entity::id>(true, Entity::PAGE_SIZE);
+    for (auto* array : {&collisions.minX,
+                        &collisions.minY,
+                        &collisions.maxX,
+                        &collisions.maxY,
+                        &collisions.centerX,
+                        &collisions.centerY,
+                        &collisions.radius})
+    {
+      *array = SceneDynamicArray<float>(true, Entity::PAGE_SIZE);
+    }
+    for (auto* array : {&collisions.shapes, &collisions.layers, &collisions.masks})
+    {
+      *array = SceneDynamicArray<uint32_t>(true, Entity::PAGE_SIZE);
+    }
+    for (auto& contacts : collisions.chunkContacts)
+    {
+      contacts = SceneDynamicArray<Contact>(true, 256);
+    }
+    collisions.pairs = SceneDynamicArray<uint64_t>(true, Entity::PAGE_SIZE);
+    collisions.lastPairs = SceneDynamicArray<uint64_t>(true, Entity::PAGE_SIZE);
+    collisions.events = SceneDynamicArray<Event>(true, Entity::PAGE_SIZE);
+  }
+
+  void AddListener(Data& collisions, ListenerFunction func)
+  {
+    if (collisions.numListeners == MAX_LISTENERS)
+    {
+      Logger::LogErr("[Collision] AddListener: Too many listeners!");
+      assert(false);
+      return;
+    }
+    collisions.listeners[collisions.numListeners++] = func;
+  }
+
+  void RemoveListener(Data& collisions, ListenerFunction func)
+  {
+    for (size_t i = 0; i < collisions.numListeners; ++i)
+    {
+      if (collisions.listeners[i] == func)
+      {
+        collisions.listeners[i] = collisions.listeners[--collisions.numListeners];
+        collisions.listeners[collisions.numListeners] = nullptr;
+        return;
+      }
+    }
+  }
+
+  void ClearListeners(Data& collisions)
+  {
+    for (auto& listener : collisions.listeners)
+    {
+      listener = nullptr;
+    }
+    collisions.numListeners = 0;
+  }
+
+  size_t Update(Scene::Data& scene, Data& collisions)
+  {
+    const auto& positionArray = Scene::GetComponentArray<Type::POSITION2D>(scene);
+    const auto& scaleArray = Scene::GetComponentArray<Type::SCALE>(scene);
+    const auto& aabbArray = Scene::GetComponentArray<Type::AABB_COLLIDER>(scene);
+    const auto& circleArray = Scene::GetComponentArray<Type::CIRCLE_COLLIDER>(scene);
+    if (aabbArray.size + circleArray.size == 0 && collisions.pairs.size == 0)
+    {
+      return 0;
+    }
+    if (!IsInitialized(collisions))
+    {
+      Init(collisions);
+    }
+
+    // Gather
+    auto& bodies = collisions.bodies;
+    bodies.Clear();
+    bodies.Reserve(aabbArray.size + circleArray.size);
+    for (size_t i = 0; i < aabbArray.size; ++i)
+    {
+      Entity::id entity = aabbArray.sparseEntities[i];
+      size_t positionIndex = positionArray.sparseIndices[entity];
+      if (positionIndex == SIZE_MAX)
+      {
+        continue;
+      }
+      const auto& aabb = aabbArray.array[i];
+      auto scale = Scale(scaleArray, entity);
+      float centerX = positionArray.array[positionIndex].x + aabb.offset.x * scale.x;
+      float centerY = positionArray.array[positionIndex].y + aabb.offset.y * scale.y;
+      float halfX = Math::Abs(aabb.halfExtents.x * scale.x);
+      float halfY = Math::Abs(aabb.halfExtents.y * scale.y);
+      bodies.PushBack({entity,
+                       SHAPE_AABB,
+                       {centerX - halfX, centerY - halfY, centerX + halfX, centerY + halfY},
+                       {centerX, centerY},
+                       0,
+                       aabb.layer,
+                       aabb.mask});
+    }
+    for (size_t i = 0; i < circleArray.size; ++i)
+    {
+      Entity::id entity = circleArray.sparseEntities[i];
+      size_t positionIndex = positionArray.sparseIndices[entity];
+      if (positionIndex == SIZE_MAX)
+      {
+        continue;
+      }
+      const auto& circle = circleArray.array[i];
+      auto scale = Scale(scaleArray, entity);
+      float centerX = positionArray.array[positionIndex].x + circle.offset.x * scale.x;
+      float centerY = positionArray.array[positionIndex].y + circle.offset.y * scale.y;
+      float radius = circle.radius * Math::Max(Math::Abs(scale.x), Math::Abs(scale.y));
+      bodies.PushBack({entity,
+                       SHAPE_CIRCLE,
+                       {centerX - radius, centerY - radius, centerX + radius, centerY + radius},
+                       {centerX, centerY},
+                       radius,
+                       circle.layer,
+                       circle.mask});
+    }
+
+    // Sort along x and scatter into the sweep arrays
+    SortOrder(collisions);
+    size_t numBodies = bodies.size;
+    size_t padded = numBodies + 3;
+    Resize(collisions.entities, padded);
+    for (auto* array : {&collisions.minX,
+                        &collisions.minY,
+                        &collisions.maxX,
+                        &collisions.maxY,
+                        &collisions.centerX,
+                        &collisions.centerY,
+                        &collisions.radius})
+    {
+      Resize(*array, padded);
+    }
+    for (auto* array : {&collisions.shapes, &collisions.layers, &collisions.masks})
+    {
+      Resize(*array, padded);
+    }
+    for (size_t i = 0; i < numBodies; ++i)
+    {
+      const auto& body = bodies[collisions.order[i]];
+      collisions.entities[i] = body.entity;
+      collisions.minX[i] = body.bounds.x;
+      collisions.minY[i] = body.bounds.y;
+      collisions.maxX[i] = body.bounds.z;
+      collisions.maxY[i] = body.bounds.w;
+      collisions.centerX[i] = body.center.x;
+      collisions.centerY[i] = body.center.y;
+      collisions.radius[i] = body.radius;
+      collisions.shapes[i] = body.shape;
+      collisions.layers[i] = body.layer;
+      collisions.masks[i] = body.mask;
+    }
+    // Padding never overlaps anything on x so sweeps stop there
+    for (size_t i = numBodies; i < padded; ++i)
+    {
+      collisions.entities[i] = Entity::MAX;
+      collisions.minX[i] = FLT_MAX;
+      collisions.minY[i] = FLT_MAX;
+      collisions.maxX[i] = -FLT_MAX;
+      collisions.maxY[i] = -FLT_MAX;
+      collisions.centerX[i] = 0;
+      collisions.centerY[i] = 0;
+      collisions.radius[i] = 0;
+      collisions.shapes[i] = SHAPE_AABB;
+      collisions.layers[i] = 0;
+      collisions.masks[i] = 0;
+    }
+
+    // Sweep
+    auto& threadPool = Scene::GetThreadPool();
+    size_t numChunks = Math::Min(threadPool.threads.size + 1, MAX_CHUNKS);
+    numChunks = Math::Max(Math::Min(numChunks, numBodies / MIN_CHUNK_SIZE), (size_t)1);
+    size_t stride = (numBodies + numChunks - 1) / numChunks;
+    Job jobs[MAX_CHUNKS];
+    for (size_t chunk = 0; chunk < numChunks; ++chunk)
+    {
+      jobs[chunk] = {&collisions,
+                     Math::Min(chunk * stride, numBodies),
+                     Math::Min((chunk + 1) * stride, numBodies),
+                     &collisions.chunkContacts[chunk]};
+    }
+    for (size_t chunk = 1; chunk < numChunks; ++chunk)
+    {
+      ThreadPool::Enqueue(threadPool, RunJob, &jobs[chunk]);
+    }
+    RunJob(&jobs[0]);
+    if (numChunks > 1)
+    {
+      ThreadPool::Wait(threadPool);
+    }
+
+    // Chunks that ran out of room are grown and swept again
+    for (size_t chunk = 0; chunk < numChunks; ++chunk)
+    {
+      auto& job = jobs[chunk];
+      if (job.count > job.contacts->capacity)
+      {
+        job.contacts->Reserve(job.count * 2);
+        RunJob(&job);
+      }
+      job.contacts->size = job.count;
+    }
+
+    // Pair up with the last Update for BEGIN/STAY/END, in sweep order
+    std::swap(collisions.pairs, collisions.lastPairs);
+    auto& pairs = collisions.pairs;
+    const auto& lastPairs = collisions.lastPairs;
+    auto& events = collisions.events;
+    pairs.Clear();
+    events.Clear();
+    for (size_t chunk = 0; chunk < numChunks; ++chunk)
+    {
+      for (const auto& contact : collisions.chunkContacts[chunk])
+      {
+        Entity::id a = collisions.entities[contact.i];
+        Entity::id b = collisions.entities[contact.j];
+        uint64_t key = PairKey(a, b);
+        bool isStay = std::binary_search(lastPairs.begin(), lastPairs.end(), key);
+        pairs.PushBack(key);
+        events.PushBack({Math::Min(a, b),
+                         Math::Max(a, b),
+                         a < b ? contact.normal : contact.normal * -1.f,
+                         contact.depth,
+                         isStay ? Phase::STAY : Phase::BEGIN});
+      }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    for (uint64_t key : lastPairs)
+    {
+      if (!std::binary_search(pairs.begin(), pairs.end(), key))
+      {
+        events.PushBack({(Entity::id)(key >> 32), (Entity::id)key, {}, 0, Phase::END});
+      }
+    }
+
+    for (size_t i = 0; i < collisions.numListeners && events.size > 0; ++i)
+    {
+      collisions.listeners[i](scene, events.buffer, events.size);
+    }
+    return pairs.size;
+  }
+
+  size_t Sweep(const Data& collisions,
+               size_t begin,
+               size_t end,
+               Contact* contacts,
+               size_t capacity)
+  {
+    const float* minX = collisions.minX.buffer;
+    const float* minY = collisions.minY.buffer;
+    const float* maxY = collisions.maxY.buffer;
+    const float* centerX = collisions.centerX.buffer;
+    const float* centerY = collisions.centerY.buffer;
+    const float* radius = collisions.radius.buffer;
+    const uint32_t* shapes = collisions.shapes.buffer;
+    const uint32_t* layers = collisions.layers.buffer;
+    const uint32_t* masks = collisions.masks.buffer;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i circle = _mm_set1_epi32(SHAPE_CIRCLE);
+
+    size_t numBodies = collisions.bodies.size;
+    size_t count = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+      const __m128 maxXi = _mm_set1_ps(collisions.maxX[i]);
+      const __m128 minYi = _mm_set1_ps(minY[i]);
+      const __m128 maxYi = _mm_set1_ps(maxY[i]);
+      const __m128i layerI = _mm_set1_epi32((int)layers[i]);
+      const __m128i maskI = _mm_set1_epi32((int)masks[i]);
+      const bool isCircle = shapes[i] == SHAPE_CIRCLE;
+      const __m128 centerXi = _mm_set1_ps(centerX[i]);
+      const __m128 centerYi = _mm_set1_ps(centerY[i]);
+      const __m128 radiusI = _mm_set1_ps(radius[i]);
+
+      // Bodies after i start at or after its minX, they overlap on x until one starts past maxX
+      for (size_t j = i + 1; j < numBodies; j += 4)
+      {
+        __m128 isOverlapX = _mm_cmple_ps(_mm_loadu_ps(minX + j), maxXi);
+        int overlapXBits = _mm_movemask_ps(isOverlapX);
+        if (overlapXBits == 0)
+        {
+          break;
+        }
+
+        __m128 isHit = _mm_and_ps(isOverlapX, _mm_cmple_ps(_mm_loadu_ps(minY + j), maxYi));
+        isHit = _mm_and_ps(isHit, _mm_cmpge_ps(_mm_loadu_ps(maxY + j), minYi));
+
+        __m128i layerJ = _mm_loadu_si128((const __m128i*)(layers + j));
+        __m128i maskJ = _mm_loadu_si128((const __m128i*)(masks + j));
+        __m128i isFiltered = _mm_or_si128(_mm_cmpeq_epi32(_mm_and_si128(layerI, maskJ), zero),
+                                          _mm_cmpeq_epi32(_mm_and_si128(layerJ, maskI), zero));
+        isHit = _mm_andnot_ps(_mm_castsi128_ps(isFiltered), isHit);
+
+        if (isCircle)
+        {
+          // Circle pairs need their centers closer than the sum of the radii
+          __m128 dx = _mm_sub_ps(_mm_loadu_ps(centerX + j), centerXi);
+          __m128 dy = _mm_sub_ps(_mm_loadu_ps(centerY + j), centerYi);
+          __m128 distance = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+          __m128 sum = _mm_add_ps(_mm_loadu_ps(radius + j), radiusI);
+          __m128 isTouching = _mm_cmple_ps(distance, _mm_mul_ps(sum, sum));
+          __m128 isCircleJ = _mm_castsi128_ps(
+            _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(shapes + j)), circle));
+          isHit = _mm_andnot_ps(_mm_andnot_ps(isTouching, isCircleJ), isHit);
+        }
+
+        for (int bits = _mm_movemask_ps(isHit); bits; bits &= bits - 1)
+        {
+          Contact contact;
+          if (Narrow(collisions, (uint32_t)i, (uint32_t)(j + std::countr_zero((uint32_t)bits)), contact))
+          {
+            if (count < capacity)
+            {
+              contacts[count] = contact;
+            }
+            ++count;
+          }
+        }
+
+        if (overlapXBits != 0xF)
+        {
+          break;
+        }
+      }
+    }
+    return count;
+  }
+
+  bool Narrow(const Data& collisions, uint32_t i, uint32_t j, Contact& contact)
+  {
+    contact.i = i;
+    contact.j = j;
+    bool isCircleI = collisions.shapes[i] == SHAPE_CIRCLE;
+    bool isCircleJ = collisions.shapes[j] == SHAPE_CIRCLE;
+    Math::Vec2f centerI{collisions.centerX[i], collisions.centerY[i]};
+    Math::Vec2f centerJ{collisions.centerX[j], collisions.centerY[j]};
+
+    if (isCircleI && isCircleJ)
+    {
+      Math::Vec2f delta = centerJ - centerI;
+      float sum = collisions.radius[i] + collisions.radius[j];
+      float distanceSquared = delta.x * delta.x + delta.y * delta.y;
+      if (distanceSquared > sum * sum)
+      {
+        return false;
+      }
+      float distance = sqrtf(distanceSquared);
+      contact.normal = distance > 0 ? delta / distance : Math::Vec2f{1, 0};
+      contact.depth = sum - distance;
+      return true;
+    }
+
+    if (!isCircleI && !isCircleJ)
+    {
+      float overlapX = Math::Min(collisions.maxX[i], collisions.maxX[j]) -
+                       Math::Max(collisions.minX[i], collisions.minX[j]);
+      float overlapY = Math::Min(collisions.maxY[i], collisions.maxY[j]) -
+                       Math::Max(collisions.minY[i], collisions.minY[j]);
+      if (overlapX < 0 || overlapY < 0)
+      {
+        return false;
+      }
+      // Push out along the axis of least penetration
+      if (overlapX < overlapY)
+      {
+        contact.normal = {centerJ.x >= centerI.x ? 1.f : -1.f, 0};
+        contact.depth = overlapX;
+      }
+      else
+      {
+        contact.normal = {0, centerJ.y >= centerI.y ? 1.f : -1.f};
+        contact.depth = overlapY;
+      }
+      return true;
+    }
+
+    // Box against circle, solved from the box and flipped when the circle comes first
+    uint32_t box = isCircleI ? j : i;
+    uint32_t ball = isCircleI ? i : j;
+    Math::Vec2f center{collisions.centerX[ball], collisions.centerY[ball]};
+    float radius = collisions.radius[ball];
+    float minX = collisions.minX[box];
+    float minY = collisions.minY[box];
+    float maxX = collisions.maxX[box];
+    float maxY = collisions.maxY[box];
+    Math::Vec2f closest{Math::Min(Math::Max(center.x, minX), maxX),
+                        Math::Min(Math::Max(center.y, minY), maxY)};
+    Math::Vec2f delta = center - closest;
+    float distanceSquared = delta.x * delta.x + delta.y * delta.y;
+    if (distanceSquared > radius * radius)
+    {
+      return false;
+    }
+
+    if (distanceSquared > 0)
+    {
+      float distance = sqrtf(distanceSquared);
+      contact.normal = delta / distance;
+      contact.depth = radius - distance;
+    }
+    else
+    {
+      // Center inside the box, push out through the nearest edge
+      float left = center.x - minX;
+      float right = maxX - center.x;
+      float bottom = center.y - minY;
+      float top = maxY - center.y;
+      float nearest = Math::Min(Math::Min(left, right), Math::Min(bottom, top));
+      contact.normal = nearest == left    ? Math::Vec2f{-1, 0}
+                       : nearest == right ? Math::Vec2f{1, 0}
+                       : nearest == bottom ? Math::Vec2f{0, -1}
+                                           : Math::Vec2f{0, 1};
+      contact.depth = radius + nearest;
+    }
+    if (isCircleI)
+    {
+      contact.normal = contact.normal * -1.f;
+    }
+    return true;
+  }
+}
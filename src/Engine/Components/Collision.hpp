@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "STDPCH.hpp" // IWYU pragma: keep
+#include "Entity.hpp"
+#include "Math.hpp"
+#include "MemoryManager.hpp"
+
+namespace Temp::Scene
+{
+  struct Data;
+}
+
+// 2D contacts between AABB_COLLIDER and CIRCLE_COLLIDER entities. Colliders are centered on
+// POSITION2D plus their offset and scaled by SCALE when the entity has one.
+//
+// Every Update gathers the bodies, sorts them along x (insertion sort on last frame's order)
+// and sweeps them in chunks on the thread pool. Each body tests the following ones that
+// overlap it on x four at a time with SSE, the survivors get an exact shape test.
+//
+// Contacts are handed to the listeners once per Update as one batch of events, on the
+// calling thread.
+namespace Temp::Component::Collision
+{
+  // Two colliders touch when each one's layer shares a bit with the other's mask
+  struct AABB
+  {
+    Math::Vec2f halfExtents{0.5f, 0.5f};
+    Math::Vec2f offset{};
+    uint32_t layer{1};
+    uint32_t mask{UINT32_MAX};
+
+    bool operator==(const AABB& other) const = default;
+  };
+
+  struct Circle
+  {
+    float radius{0.5f};
+    Math::Vec2f offset{};
+    uint32_t layer{1};
+    uint32_t mask{UINT32_MAX};
+
+    bool operator==(const Circle& other) const = default;
+  };
+
+  inline Stream& operator<<(Stream& os, const AABB& aabb)
+  {
+    os << String("AABB(") << aabb.halfExtents << " " << aabb.offset << " " << aabb.layer << " "
+       << aabb.mask << ")\n";
+    return os;
+  }
+
+  inline Stream& operator<<(Stream& os, const Circle& circle)
+  {
+    os << String("Circle(") << circle.radius << " " << circle.offset << " " << circle.layer << " "
+       << circle.mask << ")\n";
+    return os;
+  }
+
+  enum Shape : uint32_t
+  {
+    SHAPE_AABB = 0,
+    SHAPE_CIRCLE,
+  };
+
+  enum class Phase : uint8_t
+  {
+    BEGIN,
+    STAY,
+    END,
+  };
+
+  struct Event
+  {
+    // a < b
+    Entity::id a{Entity::MAX};
+    Entity::id b{Entity::MAX};
+    // Points from a to b, zero for END
+    Math::Vec2f normal{};
+    float depth{0};
+    Phase phase{Phase::BEGIN};
+
+    bool operator==(const Event& other) const = default;
+  };
+
+  struct Body
+  {
+    Entity::id entity{Entity::MAX};
+    uint32_t shape{SHAPE_AABB};
+    Math::Vec4f bounds{};
+    Math::Vec2f center{};
+    // Circles only
+    float radius{0};
+    uint32_t layer{1};
+    uint32_t mask{UINT32_MAX};
+
+    bool operator==(const Body& other) const = default;
+  };
+
+  // Contact between two bodies in sweep order
+  struct Contact
+  {
+    uint32_t i{0};
+    uint32_t j{0};
+    Math::Vec2f normal{};
+    float depth{0};
+
+    bool operator==(const Contact& other) const = default;
+  };
+
+  typedef void (*ListenerFunction)(Scene::Data& scene, const Event* events, size_t count);
+
+  constexpr size_t MAX_LISTENERS = 16;
+  // Upper bound on how many chunks the sweep is split into
+  constexpr size_t MAX_CHUNKS = 64;
+  // Below this many bodies per chunk it's not worth waking up workers
+  constexpr size_t MIN_CHUNK_SIZE = 1024;
+
+  struct Data
+  {
+    // Value = Body | Index = Gather order (AABB_COLLIDER then CIRCLE_COLLIDER dense order)
+    SceneDynamicArray<Body> bodies{};
+    // Value = Body index | Index = Sweep order, kept to sort the next Update in ~linear time
+    SceneDynamicArray<uint32_t> order{};
+    // Value = Body | Index = Sweep order, padded by 3 so the last group of 4 can be loaded
+    SceneDynamicArray<Entity::id> entities{};
+    SceneDynamicArray<float> minX{};
+    SceneDynamicArray<float> minY{};
+    SceneDynamicArray<float> maxX{};
+    SceneDynamicArray<float> maxY{};
+    SceneDynamicArray<float> centerX{};
+    SceneDynamicArray<float> centerY{};
+    SceneDynamicArray<float> radius{};
+    SceneDynamicArray<uint32_t> shapes{};
+    SceneDynamicArray<uint32_t> layers{};
+    SceneDynamicArray<uint32_t> masks{};
+    // Contacts of every chunk, sized on the calling thread
+    SceneDynamicArray<Contact> chunkContacts[MAX_CHUNKS]{};
+    // Sorted (a << 32 | b) of the pairs touching this and the previous Update
+    SceneDynamicArray<uint64_t> pairs{};
+    SceneDynamicArray<uint64_t> lastPairs{};
+    SceneDynamicArray<Event> events{};
+    ListenerFunction listeners[MAX_LISTENERS]{};
+    size_t numListeners{0};
+  };
+
+  // Listeners are kept, they're registered by the game and cleared on Scene::Destruct
+  void Init(Data& collisions);
+  [[nodiscard]] inline bool IsInitialized(const Data& collisions)
+  {
+    return collisions.events.buffer != nullptr;
+  }
+  void AddListener(Data& collisions, ListenerFunction func);
+  void RemoveListener(Data& collisions, ListenerFunction func);
+  void ClearListeners(Data& collisions);
+  // Finds this frame's contacts, fills events and calls the listeners. Returns the number of
+  // touching pairs.
+  size_t Update(Scene::Data& scene, Data& collisions);
+  // Tests the bodies [begin, end) in sweep order against the ones after them, writing contacts
+  // while there's room. Returns how many contacts were found.
+  size_t Sweep(const Data& collisions,
+               size_t begin,
+               size_t end,
+               Contact* contacts,
+               size_t capacity);
+  // Exact test of two bodies in sweep order, the normal points from i to j
+  bool Narrow(const Data& collisions, uint32_t i, uint32_t j, Contact& contact);
+}
@@ -54,6 +54,29 @@ namespace Temp::Component::Container
       Reset<E>(data);
     }
 
+    template <uint8_t E>
+    void TrimRemovedEnum(Data& data, uint32_t tick)
+    {
+      if constexpr (std::is_same<MapToComponentDataType<E>, Null>::value)
+      {
+        return;
+      }
+      Component::TrimRemoved(GetComponentArray<E>(data), tick);
+    }
+
+    template <uint8_t E>
+    void ReserveEnum(Data& data, const ComponentBits& bits, size_t count)
+    {
+      if constexpr (std::is_same<MapToComponentDataType<E>, Null>::value)
+      {
+        return;
+      }
+      if (Test(bits, E))
+      {
+        Component::Reserve(GetComponentArray<E>(data), count);
+      }
+    }
+
     template <uint8_t E, uint8_t ENUM_MAX>
     struct EnumRange
     {
@@ -84,6 +107,20 @@ namespace Temp::Component::Container
         if constexpr (E < ENUM_MAX)
           EnumRange<E + 1, ENUM_MAX>::ResetEnums(data);
       }
+
+      static void TrimRemovedEnums(Data& data, uint32_t tick)
+      {
+        TrimRemovedEnum<E>(data, tick);
+        if constexpr (E < ENUM_MAX)
+          EnumRange<E + 1, ENUM_MAX>::TrimRemovedEnums(data, tick);
+      }
+
+      static void ReserveEnums(Data& data, const ComponentBits& bits, size_t count)
+      {
+        ReserveEnum<E>(data, bits, count);
+        if constexpr (E < ENUM_MAX)
+          EnumRange<E + 1, ENUM_MAX>::ReserveEnums(data, bits, count);
+      }
     };
   }
 
@@ -97,29 +134,26 @@ namespace Temp::Component::Container
   }
 
   void Reset(Data& data) { EnumRange<ENUM_MIN, ENUM_MAX>::ResetEnums(data); }
+
+  void TrimRemoved(Data& data, uint32_t tick)
+  {
+    EnumRange<ENUM_MIN, ENUM_MAX>::TrimRemovedEnums(data, tick);
+  }
+
+  void Reserve(Data& data, const ComponentBits& bits, size_t count)
+  {
+    EnumRange<ENUM_MIN, ENUM_MAX>::ReserveEnums(data, bits, count);
+  }
 }
 
 namespace Temp
 {
-  template struct Array<Component::Null, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-  template struct Array<Entity::id, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-  template struct Array<std::size_t, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-  template struct Array<Component::CacheData<Component::Null>, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-
-  template struct Array<Math::Vec2f, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-  template struct Array<Component::CacheData<Math::Vec2f>, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-
-  template struct Array<Component::Drawable::Data, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-  template struct Array<Component::CacheData<Component::Drawable::Data>, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-
-  template struct Array<SceneString, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-  template struct Array<Component::CacheData<SceneString>, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-
-  template struct Array<Component::Hoverable::Data, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-  template struct Array<Component::CacheData<Component::Hoverable::Data>, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-
-  template struct Array<Component::Updateable::Data, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-  template struct Array<Component::CacheData<Component::Updateable::Data>, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
+  template struct DynamicArray<Component::Null, MemoryManager::Data::Type::SCENE_ARENA>;
+  template struct DynamicArray<Math::Vec2f, MemoryManager::Data::Type::SCENE_ARENA>;
+  template struct DynamicArray<Component::Drawable::Data, MemoryManager::Data::Type::SCENE_ARENA>;
+  template struct DynamicArray<SceneString, MemoryManager::Data::Type::SCENE_ARENA>;
+  template struct DynamicArray<Component::Hoverable::Data, MemoryManager::Data::Type::SCENE_ARENA>;
+  template struct DynamicArray<Component::Updateable::Data, MemoryManager::Data::Type::SCENE_ARENA>;
 
   template Temp::Math::Vec2<float> Temp::Component::dummy<Temp::Math::Vec2<float>>;
   template Temp::BaseString<Temp::MemoryManager::Data::Type::SCENE_ARENA> Temp::Component::dummy<Temp::BaseString<Temp::MemoryManager::Data::Type::SCENE_ARENA>>;
@@ -79,33 +79,30 @@ namespace Temp::Component::Container
     Component::Remove(GetComponentArray<T>(data), entity);
   }
 
+  template <uint8_t T>
+  constexpr void MarkChanged(Data& data, Entity::id entity)
+  {
+    Component::MarkChanged(GetComponentArray<T>(data), entity);
+  }
+
   void Init(Data& data);
   void Destruct(Data& data);
   void EntityDestroyed(Data& data, Entity::id entity);
   void Reset(Data& data);
+  // Drops removed events older than tick from every component array
+  void TrimRemoved(Data& data, uint32_t tick);
+  // Makes room for count more of every component in bits
+  void Reserve(Data& data, const ComponentBits& bits, size_t count);
 }
 
 namespace Temp
 {
-  extern template struct Array<Component::Null, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-  extern template struct Array<Entity::id, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-  extern template struct Array<std::size_t, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-  extern template struct Array<Component::CacheData<Component::Null>, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-
-  extern template struct Array<Math::Vec2f, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-  extern template struct Array<Component::CacheData<Math::Vec2f>, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-
-  extern template struct Array<Component::Drawable::Data, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-  extern template struct Array<Component::CacheData<Component::Drawable::Data>, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-
-  extern template struct Array<SceneString, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-  extern template struct Array<Component::CacheData<SceneString>, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-
-  extern template struct Array<Component::Hoverable::Data, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-  extern template struct Array<Component::CacheData<Component::Hoverable::Data>, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-
-  extern template struct Array<Component::Updateable::Data, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
-  extern template struct Array<Component::CacheData<Component::Updateable::Data>, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA>;
+  extern template struct DynamicArray<Component::Null, MemoryManager::Data::Type::SCENE_ARENA>;
+  extern template struct DynamicArray<Math::Vec2f, MemoryManager::Data::Type::SCENE_ARENA>;
+  extern template struct DynamicArray<Component::Drawable::Data, MemoryManager::Data::Type::SCENE_ARENA>;
+  extern template struct DynamicArray<SceneString, MemoryManager::Data::Type::SCENE_ARENA>;
+  extern template struct DynamicArray<Component::Hoverable::Data, MemoryManager::Data::Type::SCENE_ARENA>;
+  extern template struct DynamicArray<Component::Updateable::Data, MemoryManager::Data::Type::SCENE_ARENA>;
 
   extern template Temp::Math::Vec2<float> Temp::Component::dummy<Temp::Math::Vec2<float>>;
   extern template Temp::BaseString<Temp::MemoryManager::Data::Type::SCENE_ARENA> Temp::Component::dummy<Temp::BaseString<Temp::MemoryManager::Data::Type::SCENE_ARENA>>;
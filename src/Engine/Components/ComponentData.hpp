@@ -34,37 +34,75 @@
 #pragma once
 
 #include "Entity.hpp"
+#include "PagedArray.hpp"
 
 namespace Temp
 {
   namespace Component
   {
+    // Dense arrays start small and grow with the number of components actually added
+    constexpr std::size_t INITIAL_CAPACITY = 64;
+
     template <typename T>
     inline T dummy{};
 
-    template <typename T>
-    struct CacheData
+    // Every component write is stamped with the current tick so systems can ask what changed
+    // since the last time they ran. 0 is never a valid tick.
+    // Workers read it while stamping writes, only the main thread advances it between frames, so
+    // relaxed ordering is enough.
+    inline std::atomic<uint32_t> changeTick{1};
+
+    [[nodiscard]] inline uint32_t Tick() { return changeTick.load(std::memory_order_relaxed); }
+
+    // Called once per frame, returns the tick that just ended
+    inline uint32_t AdvanceTick() { return changeTick.fetch_add(1, std::memory_order_relaxed); }
+
+    struct RemovedData
     {
-      T component{dummy<T>};
-      bool cached{false};
+      Entity::id entity{Entity::MAX};
+      uint32_t tick{0};
 
-      bool operator==(const CacheData&) const = default;
+      bool operator==(const RemovedData&) const = default;
     };
 
     template <typename T>
     struct ArrayData
     {
       // This is using Indexes not Entities!
-      Array<T, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA> array{};
+      SceneDynamicArray<T> array{};
       // Value = Entity::id | Index = Data Index
-      Array<Entity::id, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA> sparseEntities{};
+      SceneDynamicArray<Entity::id> sparseEntities{};
       // Value = Data Index | Index = Entity
-      Array<std::size_t, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA> sparseIndices{};
-      // Value = Component | Index = Data Index
-      Array<CacheData<T>, Entity::MAX, MemoryManager::Data::Type::SCENE_ARENA> cacheEntities{};
+      ScenePagedArray<std::size_t, Entity::PAGE_SIZE, Entity::NUM_PAGES> sparseIndices{};
+      // Disabled (cached) components live in their own small pool instead of the dense array
+      // Value = Component | Index = Disabled Index
+      SceneDynamicArray<T> disabled{};
+      // Value = Entity::id | Index = Disabled Index
+      SceneDynamicArray<Entity::id> disabledEntities{};
+      // Value = Disabled Index | Index = Entity
+      ScenePagedArray<std::size_t, Entity::PAGE_SIZE, Entity::NUM_PAGES> disabledIndices{};
+      // Tick of the last Set or mutable Get | Index = Data Index
+      SceneDynamicArray<uint32_t> changed{};
+      // Tick the component was added | Index = Data Index
+      SceneDynamicArray<uint32_t> added{};
+      // Removed components, oldest first. Trimmed with TrimRemoved
+      SceneDynamicArray<RemovedData> removed{};
+      // Tick of the last Sort that moved rows, anything indexed by Data Index is stale after it
+      uint32_t sorted{0};
       std::size_t size{};
     };
 
+    // Makes room for count more components so adding them doesn't grow the arrays repeatedly
+    template <typename T>
+    inline void Reserve(ArrayData<T>& data, size_t count)
+    {
+      size_t size = data.size + count;
+      data.array.Reserve(size);
+      data.sparseEntities.Reserve(size);
+      data.changed.Reserve(size);
+      data.added.Reserve(size);
+    }
+
     template <typename T>
     inline void Reset(ArrayData<T>& data)
     {
@@ -77,14 +115,27 @@ namespace Temp
     {
       if (!data.array.buffer)
       {
-        data.array = {};
-        data.sparseEntities = {};
-        data.sparseIndices = {};
-        data.cacheEntities = {};
+        data.array = SceneDynamicArray<T>(true, INITIAL_CAPACITY);
+        data.sparseEntities = SceneDynamicArray<Entity::id>(true, INITIAL_CAPACITY);
+        data.changed = SceneDynamicArray<uint32_t>(true, INITIAL_CAPACITY);
+        data.added = SceneDynamicArray<uint32_t>(true, INITIAL_CAPACITY);
+        data.removed = SceneDynamicArray<RemovedData>(true, INITIAL_CAPACITY);
+        data.disabled = SceneDynamicArray<T>();
+        data.disabledEntities = SceneDynamicArray<Entity::id>();
+        data.sparseIndices.Init(SIZE_MAX);
+        data.disabledIndices.Init(SIZE_MAX);
+        data.array.Fill({});
       }
-      data.sparseEntities.Fill({Entity::MAX});
-      data.sparseIndices.Fill({SIZE_MAX});
-      data.cacheEntities.Fill({});
+      data.array.Clear();
+      data.sparseEntities.Clear();
+      data.changed.Clear();
+      data.added.Clear();
+      data.removed.Clear();
+      data.disabled.Clear();
+      data.disabledEntities.Clear();
+      data.sparseIndices.Fill(SIZE_MAX);
+      data.disabledIndices.Fill(SIZE_MAX);
+      data.sorted = 0;
       data.size = 0;
     }
 
@@ -93,35 +144,62 @@ namespace Temp
     {
       assert(entity < Entity::MAX && "[ComponentData] Set: Entity::id not valid!");
 
-      if (data.sparseIndices[entity] < Entity::MAX)
+      if (data.sparseIndices[entity] != SIZE_MAX)
       {
         data.array[data.sparseIndices[entity]] = component;
+        data.changed[data.sparseIndices[entity]] = Tick();
       }
       else
       {
-        std::size_t newIndex = data.size;
-        data.sparseIndices[entity] = newIndex;
-        data.sparseEntities[newIndex] = entity;
-        data.array[newIndex] = std::move(component);
+        data.sparseIndices.At(entity) = data.size;
+        data.sparseEntities.PushBack(entity);
+        data.array.PushBack(std::move(component));
+        data.changed.PushBack(Tick());
+        data.added.PushBack(Tick());
         ++data.size;
       }
     }
 
+    // Caches a component that isn't stored in this array (used by archetype storage)
     template <typename T>
-    inline void SetCache(ArrayData<T>& data, Entity::id entity)
+    inline void SetCache(ArrayData<T>& data, Entity::id entity, T component)
     {
       assert(entity < Entity::MAX && "[ComponentData] SetCache: Entity::id not valid!");
-      data.cacheEntities[entity].component = std::move(data.array[data.sparseIndices[entity]]);
-      data.cacheEntities[entity].cached = true;
+      assert(data.disabledIndices[entity] == SIZE_MAX && "[ComponentData] SetCache: Already cached!");
+      data.disabledIndices.At(entity) = data.disabled.size;
+      data.disabled.PushBack(std::move(component));
+      data.disabledEntities.PushBack(entity);
+    }
+
+    template <typename T>
+    inline void SetCache(ArrayData<T>& data, Entity::id entity)
+    {
+      SetCache(data, entity, std::move(data.array[data.sparseIndices[entity]]));
     }
 
     template <typename T>
     inline T GetCache(ArrayData<T>& data, Entity::id entity)
     {
       assert(entity < Entity::MAX && "[ComponentData] GetCache: Entity::id not valid!");
-      T out = std::move(data.cacheEntities[entity].component);
-      data.cacheEntities[entity] = {};
-      return std::move(out);
+      std::size_t index = data.disabledIndices[entity];
+      if (index == SIZE_MAX)
+      {
+        Logger::LogErr("[ComponentData] GetCache: Entity has no cached component!");
+        return {};
+      }
+
+      T out = std::move(data.disabled[index]);
+      std::size_t last = data.disabled.size - 1;
+      if (index != last)
+      {
+        data.disabled[index] = std::move(data.disabled[last]);
+        data.disabledEntities[index] = data.disabledEntities[last];
+        data.disabledIndices.At(data.disabledEntities[index]) = index;
+      }
+      data.disabled.PopBack();
+      data.disabledEntities.PopBack();
+      data.disabledIndices.At(entity) = SIZE_MAX;
+      return out;
     }
 
     template <typename T>
@@ -134,15 +212,20 @@ namespace Temp
       data.array[indexOfRemovedEntity] = std::move(data.array[indexOfLastElement]);
 
       Entity::id entityOfLastElement = data.sparseEntities[indexOfLastElement];
-      data.sparseIndices[entityOfLastElement] = indexOfRemovedEntity;
+      data.sparseIndices.At(entityOfLastElement) = indexOfRemovedEntity;
       data.sparseEntities[indexOfRemovedEntity] = entityOfLastElement;
+      data.changed[indexOfRemovedEntity] = data.changed[indexOfLastElement];
+      data.added[indexOfRemovedEntity] = data.added[indexOfLastElement];
 
-      data.sparseIndices[entity] = SIZE_MAX;
-      data.sparseEntities[indexOfLastElement] = Entity::MAX;
+      data.sparseIndices.At(entity) = SIZE_MAX;
 
       --data.size;
 
-      data.array[data.size] = {};
+      data.sparseEntities.PopBack();
+      data.changed.PopBack();
+      data.added.PopBack();
+      data.array.PopBack();
+      data.removed.PushBack({entity, Tick()});
     }
 
     template <typename T>
@@ -150,13 +233,13 @@ namespace Temp
     {
       assert(entity < Entity::MAX && "[ComponentData] Get const: Entity::id not valid!");
 
-      if (data.sparseIndices[entity] < Entity::MAX)
+      if (data.sparseIndices[entity] != SIZE_MAX)
       {
         return data.array[data.sparseIndices[entity]];
       }
-      else if(data.cacheEntities[entity].cached)
+      else if(data.disabledIndices[entity] != SIZE_MAX)
       {
-        return data.cacheEntities[entity].component;
+        return data.disabled[data.disabledIndices[entity]];
       }
       Logger::LogErr("[ComponentData] Get const: Warning! Accessing invalid entity!");
 #ifndef UT
@@ -170,13 +253,15 @@ namespace Temp
     {
       assert(entity < Entity::MAX && "[ComponentData] Get: Entity::id not valid!");
 
-      if (data.sparseIndices[entity] < Entity::MAX)
+      // Handing out a mutable reference counts as a change, use the const Get to only read
+      if (data.sparseIndices[entity] != SIZE_MAX)
       {
+        data.changed[data.sparseIndices[entity]] = Tick();
         return data.array[data.sparseIndices[entity]];
       }
-      else if(data.cacheEntities[entity].cached)
+      else if(data.disabledIndices[entity] != SIZE_MAX)
       {
-        return data.cacheEntities[entity].component;
+        return data.disabled[data.disabledIndices[entity]];
       }
       Logger::LogErr("[ComponentData] Get: Warning! Accessing invalid entity!");
 #ifndef UT
@@ -185,13 +270,193 @@ namespace Temp
       return dummy<T>;
     }
 
+    // For writes that go straight through data.array
+    template <typename T>
+    inline void MarkChanged(ArrayData<T>& data, Entity::id entity)
+    {
+      if (data.sparseIndices[entity] != SIZE_MAX)
+      {
+        data.changed[data.sparseIndices[entity]] = Tick();
+      }
+    }
+
+    // func(Entity::id, T&) for every component set or mutably accessed at or after tick
+    template <typename T, typename F>
+    inline void ChangedSince(ArrayData<T>& data, uint32_t tick, F&& func)
+    {
+      for (size_t i = 0; i < data.size; ++i)
+      {
+        if (data.changed[i] >= tick)
+        {
+          func(data.sparseEntities[i], data.array[i]);
+        }
+      }
+    }
+
+    // func(Entity::id, T&) for every component added at or after tick
+    template <typename T, typename F>
+    inline void AddedSince(ArrayData<T>& data, uint32_t tick, F&& func)
+    {
+      for (size_t i = 0; i < data.size; ++i)
+      {
+        if (data.added[i] >= tick)
+        {
+          func(data.sparseEntities[i], data.array[i]);
+        }
+      }
+    }
+
+    // func(Entity::id) for every component removed at or after tick, as long as it hasn't been
+    // trimmed yet
+    template <typename T, typename F>
+    inline void RemovedSince(const ArrayData<T>& data, uint32_t tick, F&& func)
+    {
+      for (size_t i = data.removed.size; i > 0 && data.removed[i - 1].tick >= tick; --i)
+      {
+        func(data.removed[i - 1].entity);
+      }
+    }
+
+    // Drops removed events older than tick
+    template <typename T>
+    inline void TrimRemoved(ArrayData<T>& data, uint32_t tick)
+    {
+      size_t count = 0;
+      while (count < data.removed.size && data.removed[count].tick < tick)
+      {
+        ++count;
+      }
+      if (count == 0)
+      {
+        return;
+      }
+      for (size_t i = count; i < data.removed.size; ++i)
+      {
+        data.removed[i - count] = data.removed[i];
+      }
+      data.removed.size -= count;
+    }
+
+    // Insertion sort gives up after shifting rows this many times per row on average
+    constexpr size_t MAX_SORT_SHIFTS_PER_ROW = 8;
+
+    // Stable merge sort of the dense rows by key(const T&), for when too many rows are out of
+    // place for Sort. Each row moves at most once. Returns the number of moved rows
+    template <typename T, typename F>
+    inline size_t SortShuffled(ArrayData<T>& data, F&& key)
+    {
+      using Key = std::decay_t<decltype(key(std::declval<const T&>()))>;
+      size_t size = data.size;
+      DynamicArray<Key> keys(true, size);
+      // Value = Row that ends up here | Index = Row
+      DynamicArray<size_t> order(true, size);
+      for (size_t i = 0; i < size; ++i)
+      {
+        keys.PushBack(key(std::as_const(data.array[i])));
+        order.PushBack(i);
+      }
+      std::stable_sort(
+        order.begin(), order.end(), [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+
+      // Applied cycle by cycle, rows that are in place point at themselves
+      size_t moved = 0;
+      for (size_t i = 0; i < size; ++i)
+      {
+        if (order[i] == i)
+        {
+          continue;
+        }
+        T component = std::move(data.array[i]);
+        Entity::id entity = data.sparseEntities[i];
+        uint32_t changed = data.changed[i];
+        uint32_t added = data.added[i];
+        size_t j = i;
+        while (order[j] != i)
+        {
+          size_t next = order[j];
+          data.array[j] = std::move(data.array[next]);
+          data.sparseEntities[j] = data.sparseEntities[next];
+          data.changed[j] = data.changed[next];
+          data.added[j] = data.added[next];
+          data.sparseIndices.At(data.sparseEntities[j]) = j;
+          order[j] = j;
+          j = next;
+          ++moved;
+        }
+        data.array[j] = std::move(component);
+        data.sparseEntities[j] = entity;
+        data.changed[j] = changed;
+        data.added[j] = added;
+        data.sparseIndices.At(entity) = j;
+        order[j] = j;
+        ++moved;
+      }
+      return moved;
+    }
+
+    // Stable insertion sort of the dense rows by key(const T&), sparse indices follow the rows.
+    // Only out of place rows move so keeping an already sorted array sorted is a single pass.
+    // Arrays that are too far out of order finish with SortShuffled instead of going O(n²).
+    // Returns the number of moved rows
+    template <typename T, typename F>
+    inline size_t Sort(ArrayData<T>& data, F&& key)
+    {
+      size_t moved = 0;
+      size_t maxMoved = data.size * MAX_SORT_SHIFTS_PER_ROW;
+      for (size_t i = 1; i < data.size; ++i)
+      {
+        if (moved > maxMoved)
+        {
+          moved += SortShuffled(data, key);
+          break;
+        }
+
+        auto rowKey = key(std::as_const(data.array[i]));
+        if (!(rowKey < key(std::as_const(data.array[i - 1]))))
+        {
+          continue;
+        }
+
+        T component = std::move(data.array[i]);
+        Entity::id entity = data.sparseEntities[i];
+        uint32_t changed = data.changed[i];
+        uint32_t added = data.added[i];
+        size_t j = i;
+        for (; j > 0 && rowKey < key(std::as_const(data.array[j - 1])); --j)
+        {
+          data.array[j] = std::move(data.array[j - 1]);
+          data.sparseEntities[j] = data.sparseEntities[j - 1];
+          data.changed[j] = data.changed[j - 1];
+          data.added[j] = data.added[j - 1];
+          data.sparseIndices.At(data.sparseEntities[j]) = j;
+        }
+        data.array[j] = std::move(component);
+        data.sparseEntities[j] = entity;
+        data.changed[j] = changed;
+        data.added[j] = added;
+        data.sparseIndices.At(entity) = j;
+        moved += i - j;
+      }
+
+      if (moved > 0)
+      {
+        data.sorted = Tick();
+      }
+      return moved;
+    }
+
     template <typename T>
     inline void EntityDestroyed(ArrayData<T>& data, Entity::id entity)
     {
-      if (data.sparseIndices[entity] < Entity::MAX)
+      if (data.sparseIndices[entity] != SIZE_MAX)
       {
         Remove<T>(data, entity);
       }
+      // Only drops it, anything it owns (like a drawable's GL objects) has to be released before
+      if (data.disabledIndices[entity] != SIZE_MAX)
+      {
+        [[maybe_unused]] T component = GetCache(data, entity);
+      }
     }
   }
 }
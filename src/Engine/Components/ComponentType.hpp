@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "Collision.hpp"
 #include "Drawable.hpp"
 #include "Hoverable.hpp"
 #include "Math.hpp"
@@ -22,6 +23,13 @@ namespace Temp::Component
       HOVERABLE,
       LUABLE,
       UPDATEABLE,
+      // Radians around the z axis, optional for the transform system
+      ROTATION,
+      // Shapes for the collision system
+      AABB_COLLIDER,
+      CIRCLE_COLLIDER,
+      // Entity the transform system places this one relative to
+      PARENT,
       MAX
     };
   }
@@ -38,11 +46,16 @@ namespace Temp::Component
   template <> struct MapToComponentDataType_t<Type::TEXT> { using type = SceneString; };
   template <> struct MapToComponentDataType_t<Type::HOVERABLE> { using type = Hoverable::Data; };
   template <> struct MapToComponentDataType_t<Type::UPDATEABLE> { using type = Updateable::Data; };
+  template <> struct MapToComponentDataType_t<Type::ROTATION> { using type = float; };
+  template <> struct MapToComponentDataType_t<Type::AABB_COLLIDER> { using type = Collision::AABB; };
+  template <> struct MapToComponentDataType_t<Type::CIRCLE_COLLIDER> { using type = Collision::Circle; };
+  template <> struct MapToComponentDataType_t<Type::PARENT> { using type = Entity::id; };
 
   template <uint8_t T> using MapToComponentDataType = typename MapToComponentDataType_t<T>::type;
   
   template <uint8_t T> constexpr MapToComponentDataType<T> GetDefaultValue() { return {}; }
   template <> inline Math::Vec2f GetDefaultValue<Type::SCALE>() { return {1.f, 1.f}; }
+  template <> inline Entity::id GetDefaultValue<Type::PARENT>() { return Entity::MAX; }
   
   // Used for Unit Tests
   template <uint8_t T> MapToComponentDataType<T> GetTestValue() { return {}; }
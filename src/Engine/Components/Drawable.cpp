@@ -183,9 +183,40 @@ namespace Temp::Component::Drawable
     using namespace Temp::Render;
 
     drawable.shaderIdx = shaderIdx;
+    drawable.translucent = true;
     Construct(drawable, shaderIdx, bufferDraw, numOfElements, vertexStride, UBO, "FontMatrices", 1);
   }
 
+  void Share(Data& instance, const Data& drawable)
+  {
+    // Scene arena arrays are never freed on their own, so aliasing the buffers is safe
+    auto alias = [](auto& dst, const auto& src) {
+      dst.buffer = src.buffer;
+      dst.size = src.size;
+      dst.capacity = src.capacity;
+      dst.offset = src.offset;
+      dst.prevOffset = src.prevOffset;
+    };
+    alias(instance.vertices, drawable.vertices);
+    alias(instance.indices, drawable.indices);
+    alias(instance.buffers, drawable.buffers);
+    instance.offset = drawable.offset;
+    instance.model = drawable.model;
+    instance.VAO = drawable.VAO;
+    instance.VBO = drawable.VBO;
+    instance.EBO = drawable.EBO;
+    instance.texture = drawable.texture;
+    instance.shaderProgram = drawable.shaderProgram;
+    instance.numInstances = drawable.numInstances;
+    instance.indicesSize = drawable.indicesSize;
+    instance.bufferDraw = drawable.bufferDraw;
+    instance.visible = drawable.visible;
+    instance.disableDepth = drawable.disableDepth;
+    instance.translucent = drawable.translucent;
+    instance.shaderIdx = drawable.shaderIdx;
+    instance.shared = true;
+  }
+
   void Draw(Scene::Data& scene, SceneObject::Data& object, Data& drawable, int polyMode)
   {
     using namespace Temp::Render;
@@ -254,6 +285,11 @@ namespace Temp::Component::Drawable
   {
     using namespace Temp::Render::OpenGLWrapper;
 
+    if (drawable.shared)
+    {
+      return;
+    }
+
     // IMPORTANT: Make sure to clean up buffers so that vector data can be released and destructed
     // Otherwise memory usage will slowly climb on every new instance of this object
     for (auto buffer : drawable.buffers)
@@ -36,7 +36,11 @@ namespace Temp::Component::Drawable
     int bufferDraw{GL_STATIC_DRAW};
     bool visible{true};
     bool disableDepth{false};
+    // Blends with what's behind it, e.g. text. Drawn after everything opaque.
+    bool translucent{false};
     int shaderIdx{-1};
+    // GL objects and vertex data belong to another drawable (prefab instances)
+    bool shared{false};
 
     // Needed for unit test
     bool operator==(const Data& other) const = default;
@@ -61,11 +65,33 @@ namespace Temp::Component::Drawable
        << "Buffer Draw: " << drawable.bufferDraw << "\n"
        << "Visible: " << drawable.visible << "\n"
        << "Disable depth: " << drawable.disableDepth << "\n"
+       << "Translucent: " << drawable.translucent << "\n"
        << "Shader Idx: " << drawable.shaderIdx << "\n"
+       << "Shared: " << drawable.shared << "\n"
        << ")\n";
     return os;
   }
 
+  // Drawables are kept sorted so that, from the top bit down:
+  //   1 bit   Opaque ones come first, translucent ones or ones not writing depth have to blend over
+  //           them
+  //   23 bits Blended ones only: back to front by depth (z translation), like Hoverable::Depth.
+  //           The depth buffer sorts out opaque ones, so they stay batched across layers
+  //   16 bits Shader
+  //   24 bits Texture, so Draw binds each as few times as possible
+  [[nodiscard]] inline uint64_t SortKey(const Data& drawable)
+  {
+    uint64_t key = (uint64_t)(drawable.shaderProgram & 0xFFFF) << 24 | (drawable.texture & 0xFFFFFF);
+    if (!drawable.translucent && !drawable.disableDepth)
+    {
+      return key;
+    }
+    // Flipped so comparing the bits as unsigned gives the same order as comparing the floats
+    uint32_t depth = std::bit_cast<uint32_t>(drawable.model.rows[2].w);
+    depth = depth & 0x80000000u ? ~depth : depth | 0x80000000u;
+    return 1ull << 63 | (uint64_t)(depth >> 9) << 40 | key;
+  }
+
   void Update(Data& drawable);
   
   void Scale(Data& drawable, const Math::Vec3f& scale);
@@ -86,6 +112,10 @@ namespace Temp::Component::Drawable
                      const DynamicArray<int>& numOfElements = {4},
                      int vertexStride = 4,
                      int UBO = Camera::FontUBO());
+  // Turns instance into a drawable that draws with the GL objects of drawable and aliases its
+  // vertex and index data instead of copying them. Destructing it releases nothing, so
+  // drawable has to outlive the instance.
+  void Share(Data& instance, const Data& drawable);
   void Draw(Scene::Data& scene, SceneObject::Data& object, Data& drawable, int polyMode = GL_FILL);
   void DrawUpdate(Scene::Data& scene, SceneObject::Data& object, Data& drawable);
   void UpdateData(Data& drawable);
@@ -3,7 +3,9 @@
 
 #include "Hoverable.hpp"
 #include "Camera.hpp"
+#include "ComponentType.hpp"
 #include "Entity.hpp"
+#include "Scene.hpp"
 #include "Shader.hpp"
 #ifdef EDITOR
 #include "Drawable.hpp"
@@ -58,7 +60,16 @@ namespace Temp::Component::Hoverable
 
   bool IsInside(const Data& hoverable, float x, float y)
   {
-    auto viewSpaceCoords = Camera::ConvertScreenCoordsToViewSpace(x, y);
+    return IsInside(hoverable, Camera::ConvertScreenCoordsToViewSpace(x, y));
+  }
+
+  bool IsInsideRaycast(const Data& hoverable, float x, float y)
+  {
+    return IsInsideRaycast(hoverable, Camera::ConvertScreenCoordsToViewSpace(x, y));
+  }
+
+  bool IsInside(const Data& hoverable, const Math::Vec4f& viewSpaceCoords)
+  {
     float offsetX = hoverable.offset.x * hoverable.scale.x;
     float offsetY = hoverable.offset.y * hoverable.scale.y;
     float beginX = hoverable.x + offsetX;
@@ -70,10 +81,27 @@ namespace Temp::Component::Hoverable
            viewSpaceCoords.y <= endY;
   }
 
-  bool IsInsideRaycast(const Data& hoverable, float x, float y)
+  bool IsInsideRaycast(const Data& hoverable, const Math::Vec4f& viewSpaceCoords)
+  {
+    if (hoverable.triangles.size == 0)
+    {
+      return false;
+    }
+    return Raycast(hoverable, hoverable.model.inverse(), viewSpaceCoords);
+  }
+
+  bool IsInsideRaycastCached(const Data& hoverable, const Math::Vec4f& viewSpaceCoords)
+  {
+    if (hoverable.triangles.size == 0)
+    {
+      return false;
+    }
+    return Raycast(hoverable, hoverable.inverseModel, viewSpaceCoords);
+  }
+
+  bool Raycast(const Data& hoverable, const Math::Mat4& inverseModel, const Math::Vec4f& viewSpaceCoords)
   {
-    auto viewSpaceCoords = Camera::ConvertScreenCoordsToViewSpace(x, y);
-    auto localSpaceCoords = hoverable.model.inverse() * viewSpaceCoords;
+    auto localSpaceCoords = inverseModel * viewSpaceCoords;
     auto rayOrigin = Math::Vec3f(localSpaceCoords.x, localSpaceCoords.y, 10.f);
     auto rayDirection = (Math::Vec3f(localSpaceCoords.x, localSpaceCoords.y, -10.f) - rayOrigin).normalize();
 
@@ -81,6 +109,251 @@ namespace Temp::Component::Hoverable
     return Math::RayMeshIntersect(rayOrigin, rayDirection, hoverable.triangles, intersectionPoint);
   }
 
+  Math::Vec4f Bounds(const Data& hoverable)
+  {
+    float offsetX = hoverable.offset.x * hoverable.scale.x;
+    float offsetY = hoverable.offset.y * hoverable.scale.y;
+    float beginX = hoverable.x + offsetX;
+    float beginY = hoverable.y + offsetY;
+    Math::Vec4f bounds{beginX,
+                       beginY,
+                       beginX + hoverable.width * hoverable.scale.x,
+                       beginY + hoverable.height * hoverable.scale.y};
+
+    const auto& model = hoverable.model;
+    for (const auto& triangle : hoverable.triangles)
+    {
+      for (const auto& vertex : triangle)
+      {
+        float x = model.rows[0].x * vertex.x + model.rows[0].y * vertex.y +
+                  model.rows[0].z * vertex.z + model.rows[0].w;
+        float y = model.rows[1].x * vertex.x + model.rows[1].y * vertex.y +
+                  model.rows[1].z * vertex.z + model.rows[1].w;
+        bounds.x = Math::Min(bounds.x, x);
+        bounds.y = Math::Min(bounds.y, y);
+        bounds.z = Math::Max(bounds.z, x);
+        bounds.w = Math::Max(bounds.w, y);
+      }
+    }
+    return bounds;
+  }
+
+  void UpdateCache(Data& hoverable)
+  {
+    hoverable.bounds = Bounds(hoverable);
+    if (hoverable.triangles.size == 0)
+    {
+      return;
+    }
+
+    const auto& model = hoverable.model;
+    bool isAxisAligned = model.rows[0].y == 0 && model.rows[0].z == 0 && model.rows[1].x == 0 &&
+                         model.rows[1].z == 0 && model.rows[2].x == 0 && model.rows[2].y == 0 &&
+                         model.rows[3] == Math::Vec4f{0, 0, 0, 1};
+    if (!isAxisAligned || model.rows[0].x == 0 || model.rows[1].y == 0 || model.rows[2].z == 0)
+    {
+      hoverable.inverseModel = model.inverse();
+      return;
+    }
+
+    // Scale then translate, undone by the reciprocal scale of the negated translation
+    auto& inverse = hoverable.inverseModel;
+    inverse = Math::Mat4{};
+    for (int i = 0; i < 3; ++i)
+    {
+      float scale = 1.f / model.rows[i].data[i];
+      inverse.rows[i].data[i] = scale;
+      inverse.rows[i].w = -model.rows[i].w * scale;
+    }
+  }
+
+  size_t HitMask(const float* minX,
+                 const float* minY,
+                 const float* maxX,
+                 const float* maxY,
+                 size_t count,
+                 const Math::Vec4f& viewSpaceCoords,
+                 uint32_t* mask)
+  {
+    const __m128 x = _mm_set1_ps(viewSpaceCoords.x);
+    const __m128 y = _mm_set1_ps(viewSpaceCoords.y);
+    size_t numHits = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+      __m128 inside = _mm_and_ps(_mm_cmpge_ps(x, _mm_loadu_ps(minX + i)),
+                                 _mm_cmpge_ps(y, _mm_loadu_ps(minY + i)));
+      inside = _mm_and_ps(inside, _mm_cmple_ps(x, _mm_loadu_ps(maxX + i)));
+      inside = _mm_and_ps(inside, _mm_cmple_ps(y, _mm_loadu_ps(maxY + i)));
+      uint32_t bits = (uint32_t)_mm_movemask_ps(inside);
+
+      // Groups of four never straddle a word
+      if (i % 32 == 0)
+      {
+        mask[i / 32] = 0;
+      }
+      mask[i / 32] |= bits << (i % 32);
+      numHits += (size_t)std::popcount(bits);
+    }
+
+    for (; i < count; ++i)
+    {
+      if (i % 32 == 0)
+      {
+        mask[i / 32] = 0;
+      }
+      bool isInside = viewSpaceCoords.x >= minX[i] && viewSpaceCoords.y >= minY[i] &&
+                      viewSpaceCoords.x <= maxX[i] && viewSpaceCoords.y <= maxY[i];
+      mask[i / 32] |= (uint32_t)isInside << (i % 32);
+      numHits += isInside;
+    }
+    return numHits;
+  }
+
+  void InitIndex(IndexData& index)
+  {
+    SpatialGrid::Init(index.grid);
+    index.minX = SceneDynamicArray<float>(true, Entity::PAGE_SIZE);
+    index.minY = SceneDynamicArray<float>(true, Entity::PAGE_SIZE);
+    index.maxX = SceneDynamicArray<float>(true, Entity::PAGE_SIZE);
+    index.maxY = SceneDynamicArray<float>(true, Entity::PAGE_SIZE);
+    index.mask = SceneDynamicArray<uint32_t>(true, Entity::PAGE_SIZE / 32);
+    index.hovered = SceneDynamicArray<Entity::id>();
+    index.nextHovered = SceneDynamicArray<Entity::id>();
+    index.candidates = SceneDynamicArray<size_t>();
+    index.lastTick = 0;
+  }
+
+  void UpdateIndex(Scene::Data& scene, IndexData& index)
+  {
+    auto& hoverableArray = Scene::GetComponentArray<Type::HOVERABLE>(scene);
+    const auto& positionArray = Scene::GetComponentArray<Type::POSITION2D>(scene);
+    const auto& scaleArray = Scene::GetComponentArray<Type::SCALE>(scene);
+    if (!SpatialGrid::IsInitialized(index.grid))
+    {
+      InitIndex(index);
+    }
+    uint32_t tick = index.lastTick;
+
+    // Removing or sorting hoverables moves rows around, the SoA bounds have to follow
+    bool isRebuild = index.minX.size != hoverableArray.size || hoverableArray.sorted >= tick;
+    RemovedSince(hoverableArray, tick, [&index, &hoverableArray, &isRebuild](Entity::id entity) {
+      isRebuild = true;
+      if (hoverableArray.sparseIndices[entity] == SIZE_MAX)
+      {
+        SpatialGrid::Remove(index.grid, entity);
+      }
+    });
+    if (isRebuild)
+    {
+      for (auto* bounds : {&index.minX, &index.minY, &index.maxX, &index.maxY})
+      {
+        bounds->Reserve(hoverableArray.size);
+        bounds->size = hoverableArray.size;
+      }
+    }
+
+    auto isChanged = [tick](const auto& data, Entity::id entity) {
+      size_t i = data.sparseIndices[entity];
+      return i != SIZE_MAX && data.changed[i] >= tick;
+    };
+    for (size_t i = 0; i < hoverableArray.size; ++i)
+    {
+      Entity::id entity = hoverableArray.sparseEntities[i];
+      auto& hoverable = hoverableArray.array[i];
+      if (hoverableArray.changed[i] >= tick || hoverableArray.added[i] >= tick ||
+          isChanged(positionArray, entity) || isChanged(scaleArray, entity))
+      {
+        UpdateCache(hoverable);
+        SpatialGrid::Update(index.grid, entity, hoverable.bounds);
+      }
+      else if (!isRebuild)
+      {
+        continue;
+      }
+      index.minX[i] = hoverable.bounds.x;
+      index.minY[i] = hoverable.bounds.y;
+      index.maxX[i] = hoverable.bounds.z;
+      index.maxY[i] = hoverable.bounds.w;
+    }
+    index.lastTick = Tick();
+  }
+
+  const SceneDynamicArray<size_t>& Query(Scene::Data& scene,
+                                         IndexData& index,
+                                         const Math::Vec4f& viewSpaceCoords)
+  {
+    UpdateIndex(scene, index);
+
+    const auto& hoverableArray = Scene::GetComponentArray<Type::HOVERABLE>(scene);
+    index.candidates.Clear();
+    if (hoverableArray.size <= LINEAR_QUERY_MAX)
+    {
+      size_t numWords = (hoverableArray.size + 31) / 32;
+      index.mask.Reserve(numWords);
+      index.mask.size = numWords;
+      HitMask(index.minX.buffer,
+              index.minY.buffer,
+              index.maxX.buffer,
+              index.maxY.buffer,
+              hoverableArray.size,
+              viewSpaceCoords,
+              index.mask.buffer);
+      for (size_t word = 0; word < numWords; ++word)
+      {
+        for (uint32_t bits = index.mask[word]; bits; bits &= bits - 1)
+        {
+          index.candidates.PushBack(word * 32 + (size_t)std::countr_zero(bits));
+        }
+      }
+      return index.candidates;
+    }
+
+    SpatialGrid::Query(index.grid,
+                       viewSpaceCoords.x,
+                       viewSpaceCoords.y,
+                       [&index, &hoverableArray](Entity::id entity) {
+                         // Entities whose hoverable is gone stay in the grid until the next sync
+                         size_t i = hoverableArray.sparseIndices[entity];
+                         if (i != SIZE_MAX)
+                         {
+                           index.candidates.PushBack(i);
+                         }
+                       });
+    std::sort(index.candidates.begin(), index.candidates.end());
+    return index.candidates;
+  }
+
+  void Hover(Scene::Data& scene, IndexData& index, const Math::Vec4f& viewSpaceCoords)
+  {
+    auto& hoverableArray = Scene::GetComponentArray<Type::HOVERABLE>(scene);
+    index.nextHovered.Clear();
+    for (size_t i : Query(scene, index, viewSpaceCoords))
+    {
+      auto& hoverable = hoverableArray.array[i];
+      if (IsInside(hoverable, viewSpaceCoords) || IsInsideRaycastCached(hoverable, viewSpaceCoords))
+      {
+        HoverableEnter(scene, hoverable);
+        index.nextHovered.PushBack(hoverableArray.sparseEntities[i]);
+      }
+      else
+      {
+        HoverableLeave(scene, hoverable);
+      }
+    }
+
+    // Hoverables the mouse left aren't candidates anymore
+    for (Entity::id entity : index.hovered)
+    {
+      size_t i = hoverableArray.sparseIndices[entity];
+      if (i != SIZE_MAX && index.nextHovered.Find(entity) == SIZE_MAX)
+      {
+        HoverableLeave(scene, hoverableArray.array[i]);
+      }
+    }
+    std::swap(index.hovered, index.nextHovered);
+  }
+
   void HoverableEnter(Scene::Data& scene, Data& hoverable)
   {
     if (!hoverable.lastInside)
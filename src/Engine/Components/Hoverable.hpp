@@ -5,6 +5,7 @@
 
 #include "STDPCH.hpp" // IWYU pragma: keep
 #include "MemoryManager.hpp"
+#include "SpatialGrid.hpp"
 #ifdef EDITOR
 #include "Drawable.hpp"
 #endif
@@ -38,6 +39,9 @@ namespace Temp::Component::Hoverable
     DynamicArray<DynamicArray<Math::Vec3f, MemoryManager::Data::SCENE_ARENA>,
                  MemoryManager::Data::SCENE_ARENA>
       triangles{};
+    // Refreshed by UpdateCache when model or the rectangle changes
+    Math::Mat4 inverseModel{};
+    Math::Vec4f bounds{};
 #ifdef EDITOR
     Drawable::Data drawable{};
 #endif
@@ -90,10 +94,67 @@ namespace Temp::Component::Hoverable
   void UpdateDrawable(Hoverable::Data& hoverable);
 #endif
 
+  // Hoverables are kept sorted by depth (z translation), the last one is on top
+  [[nodiscard]] inline float Depth(const Data& hoverable) { return hoverable.model.rows[2].w; }
+
   // Only works for Rectangles
   // Add more interior detections as needed
   bool IsInside(const Data& hoverable, float x, float y);
   bool IsInsideRaycast(const Data& hoverable, float x, float y);
+  // Same as above with the point already converted to view space
+  bool IsInside(const Data& hoverable, const Math::Vec4f& viewSpaceCoords);
+  bool IsInsideRaycast(const Data& hoverable, const Math::Vec4f& viewSpaceCoords);
+  // Uses the cached inverseModel, only up to date for hoverables returned by Query
+  bool IsInsideRaycastCached(const Data& hoverable, const Math::Vec4f& viewSpaceCoords);
+  bool Raycast(const Data& hoverable, const Math::Mat4& inverseModel, const Math::Vec4f& viewSpaceCoords);
+  // View space (minX, minY, maxX, maxY) covering both the rectangle and the triangles
+  [[nodiscard]] Math::Vec4f Bounds(const Data& hoverable);
+  // Recomputes bounds and, for triangle hoverables, inverseModel. The full 4x4 inverse only
+  // runs for rotated models, translate/scale ones are inverted directly.
+  void UpdateCache(Data& hoverable);
+
+  // Tests one point against count SoA bounds four at a time with SSE. Bit i % 32 of
+  // mask[i / 32] is set when bounds i contain the point, mask needs (count + 31) / 32 words.
+  // Returns the number of hits.
+  size_t HitMask(const float* minX,
+                 const float* minY,
+                 const float* maxX,
+                 const float* maxY,
+                 size_t count,
+                 const Math::Vec4f& viewSpaceCoords,
+                 uint32_t* mask);
+
+  // Below this many hoverables Query scans the SoA bounds instead of the grid
+  constexpr size_t LINEAR_QUERY_MAX = 1024;
+
+  // Broadphase over the scene's hoverables so events only test the ones under the mouse
+  struct IndexData
+  {
+    SpatialGrid::Data grid{};
+    // Value = Cached bounds | Index = Hoverable dense index
+    SceneDynamicArray<float> minX{};
+    SceneDynamicArray<float> minY{};
+    SceneDynamicArray<float> maxX{};
+    SceneDynamicArray<float> maxY{};
+    SceneDynamicArray<uint32_t> mask{};
+    // Entities the mouse was inside of on the last Hover
+    SceneDynamicArray<Entity::id> hovered{};
+    SceneDynamicArray<Entity::id> nextHovered{};
+    // Dense hoverable indices of the last Query, ascending
+    SceneDynamicArray<size_t> candidates{};
+    uint32_t lastTick{0};
+  };
+
+  void InitIndex(IndexData& index);
+  // Refreshes the cache of and re-inserts hoverables whose HOVERABLE, POSITION2D or SCALE
+  // changed since the last sync
+  void UpdateIndex(Scene::Data& scene, IndexData& index);
+  // Dense indices of the hoverables whose bounds contain the point, lowest first
+  const SceneDynamicArray<size_t>& Query(Scene::Data& scene,
+                                         IndexData& index,
+                                         const Math::Vec4f& viewSpaceCoords);
+  // Calls HoverEnter/HoverLeave for the hoverables the mouse entered or left
+  void Hover(Scene::Data& scene, IndexData& index, const Math::Vec4f& viewSpaceCoords);
   void HoverableEnter(Scene::Data& scene, Data& hoverable);
   void HoverableLeave(Scene::Data& scene, Data& hoverable);
 
@@ -0,0 +1,612 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#include "Transform.hpp"
+#include "ComponentType.hpp"
+#include "Logger.hpp"
+#include "Scene.hpp"
+#include "ThreadPool.hpp"
+
+namespace Temp::Component::Transform
+{
+  namespace
+  {
+    template <typename T>
+    [[nodiscard]] inline bool IsChanged(const ArrayData<T>& data,
+                                        Entity::id entity,
+                                        uint32_t tick)
+    {
+      size_t index = data.sparseIndices[entity];
+      return index != SIZE_MAX && data.changed[index] >= tick;
+    }
+
+    constexpr size_t MIN_NODES_PER_JOB = 1024;
+    constexpr size_t MAX_JOBS = 32;
+
+    struct Entry
+    {
+      Entity::id root{Entity::MAX};
+      int depth{0};
+      Entity::id entity{Entity::MAX};
+    };
+
+    [[nodiscard]] bool IsInHierarchy(const Data& transforms, Entity::id entity)
+    {
+      uint32_t index = transforms.nodeIndices[entity];
+      return index != NONE && transforms.nodes[index].parent != NONE;
+    }
+
+    // Parents that were added, changed or removed, or a destroyed or removed root
+    [[nodiscard]] bool IsHierarchyChanged(Scene::Data& scene, const Data& transforms, uint32_t tick)
+    {
+      const auto& parentArray = Scene::GetComponentArray<Type::PARENT>(scene);
+      bool isChanged = transforms.isHierarchyChanged;
+      for (size_t i = 0; !isChanged && i < parentArray.size; ++i)
+      {
+        isChanged = parentArray.changed[i] >= tick;
+      }
+      RemovedSince(parentArray, tick, [&isChanged](Entity::id) { isChanged = true; });
+      RemovedSince(Scene::GetComponentArray<Type::POSITION2D>(scene),
+                   tick,
+                   [&isChanged, &transforms](Entity::id entity) {
+                     isChanged |= transforms.nodeIndices[entity] != NONE;
+                   });
+      return isChanged;
+    }
+
+    void AddNode(Data& transforms, Entity::id entity, uint32_t parent)
+    {
+      uint32_t index = (uint32_t)transforms.nodes.size;
+      transforms.nodeIndices.At(entity) = index;
+      transforms.nodes.PushBack({.entity = entity, .parent = parent});
+      if (parent != NONE)
+      {
+        transforms.nodes[index].nextSibling = transforms.nodes[parent].firstChild;
+        transforms.nodes[parent].firstChild = index;
+      }
+    }
+
+    // PARENTs set since the last Update aren't linked into the nodes yet, the ones pointing at a
+    // destroyed entity are dropped here. One pass a frame instead of one per destroyed entity.
+    void DetachFromDestroyed(Scene::Data& scene, uint32_t tick)
+    {
+      const auto& parentArray = Scene::GetComponentArray<Type::PARENT>(scene);
+      DynamicArray<Entity::id> orphans(true);
+      for (size_t i = 0; i < parentArray.size; ++i)
+      {
+        Entity::id parent = parentArray.array[i];
+        if (parentArray.changed[i] >= tick && parent < Entity::MAX &&
+            !Entity::IsAlive(scene.entityData, parent))
+        {
+          orphans.PushBack(parentArray.sparseEntities[i]);
+        }
+      }
+      for (auto orphan : orphans)
+      {
+        Scene::RemoveComponent<Type::PARENT>(scene, orphan);
+      }
+    }
+
+    void Rebuild(Scene::Data& scene, Data& transforms)
+    {
+      const auto& parentArray = Scene::GetComponentArray<Type::PARENT>(scene);
+      for (const auto& node : transforms.nodes)
+      {
+        transforms.nodeIndices.At(node.entity) = NONE;
+      }
+      transforms.nodes.Clear();
+      transforms.roots.Clear();
+      transforms.isHierarchyChanged = false;
+
+      DynamicArray<Entry> entries(true, parentArray.size);
+      for (size_t i = 0; i < parentArray.size; ++i)
+      {
+        if (parentArray.array[i] >= Entity::MAX)
+        {
+          continue;
+        }
+        // Walk up to the first entity without a parent
+        Entity::id root = parentArray.array[i];
+        int depth = 1;
+        for (; depth <= MAX_DEPTH; ++depth)
+        {
+          size_t index = parentArray.sparseIndices[root];
+          if (index == SIZE_MAX || parentArray.array[index] >= Entity::MAX)
+          {
+            break;
+          }
+          root = parentArray.array[index];
+        }
+        if (depth > MAX_DEPTH)
+        {
+          Logger::LogErr("[Transform] Parent chain is cyclic or too deep, leaving it out of the hierarchy");
+          continue;
+        }
+        entries.PushBack({root, depth, parentArray.sparseEntities[i]});
+      }
+      std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.root != b.root ? a.root < b.root : a.depth < b.depth;
+      });
+
+      for (size_t i = 0; i < entries.size; ++i)
+      {
+        const auto& entry = entries[i];
+        if (i == 0 || entry.root != entries[i - 1].root)
+        {
+          transforms.roots.PushBack((uint32_t)transforms.nodes.size);
+          AddNode(transforms, entry.root, NONE);
+        }
+        // Depth sorted, so the parent is already in
+        Entity::id parent = parentArray.array[parentArray.sparseIndices[entry.entity]];
+        AddNode(transforms, entry.entity, transforms.nodeIndices[parent]);
+      }
+      transforms.roots.PushBack((uint32_t)transforms.nodes.size);
+    }
+
+    // | sx * cos, -sy * sin, 0, x |
+    // | sx * sin,  sy * cos, 0, y |
+    // composed with the parent's world transform, when there is one
+    void World(const Node* parent,
+               Math::Vec2f position,
+               Math::Vec2f scale,
+               float rotation,
+               Math::Vec4f& row0,
+               Math::Vec4f& row1)
+    {
+      float c = cosf(rotation);
+      float s = sinf(rotation);
+      Math::Vec4f local0{scale.x * c, -scale.y * s, 0, position.x};
+      Math::Vec4f local1{scale.x * s, scale.y * c, 0, position.y};
+      if (!parent)
+      {
+        row0 = local0;
+        row1 = local1;
+        return;
+      }
+      const auto& p0 = parent->row0;
+      const auto& p1 = parent->row1;
+      row0 = {p0.x * local0.x + p0.y * local1.x,
+              p0.x * local0.y + p0.y * local1.y,
+              0,
+              p0.x * local0.w + p0.y * local1.w + p0.w};
+      row1 = {p1.x * local0.x + p1.y * local1.x,
+              p1.x * local0.y + p1.y * local1.y,
+              0,
+              p1.x * local0.w + p1.y * local1.w + p1.w};
+    }
+
+    struct Job
+    {
+      Scene::Data* scene{nullptr};
+      Data* transforms{nullptr};
+      // Range in roots
+      size_t begin{0};
+      size_t end{0};
+      uint32_t tick{0};
+      size_t count{0};
+    };
+
+    // Parents come before their children, so a single pass sees every dirty parent first
+    void UpdateNodes(Job& job)
+    {
+      auto& scene = *job.scene;
+      auto& transforms = *job.transforms;
+      auto& drawableArray = Scene::GetComponentArray<Type::DRAWABLE>(scene);
+      auto& hoverableArray = Scene::GetComponentArray<Type::HOVERABLE>(scene);
+      const auto& positionArray = Scene::GetComponentArray<Type::POSITION2D>(scene);
+      const auto& scaleArray = Scene::GetComponentArray<Type::SCALE>(scene);
+      const auto& rotationArray = Scene::GetComponentArray<Type::ROTATION>(scene);
+
+      uint32_t begin = transforms.roots[job.begin];
+      uint32_t end = transforms.roots[job.end];
+      for (uint32_t i = begin; i < end; ++i)
+      {
+        auto& node = transforms.nodes[i];
+        const Node* parent = node.parent != NONE ? &transforms.nodes[node.parent] : nullptr;
+        size_t drawableIndex = drawableArray.sparseIndices[node.entity];
+        node.isDirty = (parent && parent->isDirty) || IsChanged(positionArray, node.entity, job.tick) ||
+                       IsChanged(scaleArray, node.entity, job.tick) ||
+                       IsChanged(rotationArray, node.entity, job.tick) ||
+                       (drawableIndex != SIZE_MAX && drawableArray.added[drawableIndex] >= job.tick);
+        if (!node.isDirty)
+        {
+          continue;
+        }
+
+        size_t positionIndex = positionArray.sparseIndices[node.entity];
+        size_t scaleIndex = scaleArray.sparseIndices[node.entity];
+        size_t rotationIndex = rotationArray.sparseIndices[node.entity];
+        Math::Vec2f position = positionIndex != SIZE_MAX ? positionArray.array[positionIndex] : Math::Vec2f{};
+        Math::Vec2f scale = scaleIndex != SIZE_MAX ? scaleArray.array[scaleIndex] : Math::Vec2f{1, 1};
+        float rotation = rotationIndex != SIZE_MAX ? rotationArray.array[rotationIndex] : 0.f;
+        World(parent, position, scale, rotation, node.row0, node.row1);
+
+        // Roots are drawn by the flat pass
+        if (!parent || drawableIndex == SIZE_MAX)
+        {
+          continue;
+        }
+        auto& drawable = drawableArray.array[drawableIndex];
+        Math::Vec2f offset = {position.x + drawable.offset.x, position.y + drawable.offset.y};
+        World(parent, offset, scale, rotation, drawable.model.rows[0], drawable.model.rows[1]);
+        transforms.models[drawableIndex] = drawable.model;
+        ++job.count;
+
+        size_t hoverableIndex = hoverableArray.sparseIndices[node.entity];
+        if (hoverableIndex != SIZE_MAX)
+        {
+          hoverableArray.array[hoverableIndex].model = drawable.model;
+          MarkChanged(hoverableArray, node.entity);
+        }
+      }
+    }
+
+    size_t UpdateHierarchy(Scene::Data& scene, Data& transforms, uint32_t tick)
+    {
+      if (transforms.roots.size == 0)
+      {
+        return 0;
+      }
+      size_t numRoots = transforms.roots.size - 1;
+      auto& threadPool = Scene::GetThreadPool();
+      size_t numJobs = Math::Min(threadPool.threads.size + 1, MAX_JOBS);
+      numJobs = Math::Min(numJobs, transforms.nodes.size / MIN_NODES_PER_JOB);
+      if (numJobs <= 1)
+      {
+        Job job{&scene, &transforms, 0, numRoots, tick};
+        UpdateNodes(job);
+        return job.count;
+      }
+
+      // Cut between roots once a job has its share of the nodes
+      Job jobs[MAX_JOBS];
+      size_t numNodes = (transforms.nodes.size + numJobs - 1) / numJobs;
+      size_t count = 0;
+      size_t begin = 0;
+      for (size_t i = 1; i <= numRoots; ++i)
+      {
+        if (i == numRoots || transforms.roots[i] - transforms.roots[begin] >= numNodes)
+        {
+          jobs[count++] = {&scene, &transforms, begin, i, tick};
+          begin = i;
+        }
+      }
+      auto run = [](void* data) { UpdateNodes(*static_cast<Job*>(data)); };
+      for (size_t i = 1; i < count; ++i)
+      {
+        ThreadPool::Enqueue(threadPool, run, &jobs[i]);
+      }
+      run(&jobs[0]);
+      ThreadPool::Wait(threadPool);
+
+      size_t updated = 0;
+      for (size_t i = 0; i < count; ++i)
+      {
+        updated += jobs[i].count;
+      }
+      return updated;
+    }
+
+    struct Decomposed
+    {
+      float x{0};
+      float y{0};
+      float scaleX{1};
+      float scaleY{1};
+      float angle{0};
+    };
+
+    // Inverse of Compose, a shear a parent's non uniform scale adds is dropped
+    [[nodiscard]] Decomposed Decompose(const Math::Mat4& model)
+    {
+      const auto& row0 = model.rows[0];
+      const auto& row1 = model.rows[1];
+      Decomposed result;
+      result.x = row0.w;
+      result.y = row1.w;
+      result.scaleX = sqrtf(row0.x * row0.x + row1.x * row1.x);
+      result.angle = atan2f(row1.x, row0.x);
+      // Keeps the sign of a mirrored y
+      result.scaleY = row1.y * cosf(result.angle) - row0.y * sinf(result.angle);
+      return result;
+    }
+
+    void CopyModels(SceneDynamicArray<Math::Mat4>& to, const SceneDynamicArray<Math::Mat4>& from)
+    {
+      to.Reserve(from.size);
+      to.size = from.size;
+      memcpy(to.buffer, from.buffer, from.size * sizeof(Math::Mat4));
+    }
+  }
+
+  void Init(Data& transforms)
+  {
+    transforms.models = SceneDynamicArray<Math::Mat4>(true, Entity::PAGE_SIZE);
+    transforms.rows = SceneDynamicArray<uint32_t>(true, Entity::PAGE_SIZE);
+    transforms.x = SceneDynamicArray<float>(true, Entity::PAGE_SIZE);
+    transforms.y = SceneDynamicArray<float>(true, Entity::PAGE_SIZE);
+    transforms.scaleX = SceneDynamicArray<float>(true, Entity::PAGE_SIZE);
+    transforms.scaleY = SceneDynamicArray<float>(true, Entity::PAGE_SIZE);
+    transforms.cos = SceneDynamicArray<float>(true, Entity::PAGE_SIZE);
+    transforms.sin = SceneDynamicArray<float>(true, Entity::PAGE_SIZE);
+    transforms.nodes = SceneDynamicArray<Node>(true, Entity::PAGE_SIZE);
+    transforms.roots = SceneDynamicArray<uint32_t>(true, Entity::PAGE_SIZE);
+    transforms.nodeIndices.Init(NONE);
+    transforms.previousModels = SceneDynamicArray<Math::Mat4>(true, Entity::PAGE_SIZE);
+    transforms.lastTick = 0;
+    transforms.isHierarchyChanged = false;
+    transforms.isEntityDestroyed = false;
+    transforms.alpha = 1.f;
+    transforms.isInterpolated = false;
+  }
+
+  void EntityDestroyed(Scene::Data& scene, Data& transforms, Entity::id entity)
+  {
+    transforms.isEntityDestroyed = true;
+    uint32_t index = transforms.nodeIndices[entity];
+    if (index == NONE || transforms.nodes[index].entity != entity)
+    {
+      return;
+    }
+    transforms.isHierarchyChanged = true;
+    const auto& parentArray = Scene::GetComponentArray<Type::PARENT>(scene);
+    // Nodes stay put until the next Rebuild, removing PARENTs doesn't break the links
+    for (uint32_t child = transforms.nodes[index].firstChild; child != NONE;
+         child = transforms.nodes[child].nextSibling)
+    {
+      Entity::id childEntity = transforms.nodes[child].entity;
+      size_t parentIndex = parentArray.sparseIndices[childEntity];
+      // Reparented or already gone since the last Rebuild
+      if (parentIndex != SIZE_MAX && parentArray.array[parentIndex] == entity)
+      {
+        Scene::RemoveComponent<Type::PARENT>(scene, childEntity);
+      }
+    }
+  }
+
+  size_t Update(Scene::Data& scene, Data& transforms)
+  {
+    auto& drawableArray = Scene::GetComponentArray<Type::DRAWABLE>(scene);
+    const auto& positionArray = Scene::GetComponentArray<Type::POSITION2D>(scene);
+    const auto& scaleArray = Scene::GetComponentArray<Type::SCALE>(scene);
+    const auto& rotationArray = Scene::GetComponentArray<Type::ROTATION>(scene);
+    uint32_t tick = transforms.lastTick;
+
+    // Removing or sorting drawables moves rows around, models has to be rebuilt to follow
+    bool isRebuild = transforms.models.size != drawableArray.size || drawableArray.sorted >= tick;
+    RemovedSince(drawableArray, tick, [&isRebuild](Entity::id) { isRebuild = true; });
+    if (isRebuild)
+    {
+      transforms.models.Reserve(drawableArray.size);
+      transforms.models.size = drawableArray.size;
+      tick = 0;
+    }
+    else if (transforms.isInterpolated)
+    {
+      CopyModels(transforms.previousModels, transforms.models);
+    }
+
+    if (transforms.isEntityDestroyed)
+    {
+      DetachFromDestroyed(scene, transforms.lastTick);
+      transforms.isEntityDestroyed = false;
+    }
+    if (IsHierarchyChanged(scene, transforms, transforms.lastTick))
+    {
+      Rebuild(scene, transforms);
+      tick = 0;
+    }
+
+    transforms.rows.Clear();
+    transforms.x.Clear();
+    transforms.y.Clear();
+    transforms.scaleX.Clear();
+    transforms.scaleY.Clear();
+    transforms.cos.Clear();
+    transforms.sin.Clear();
+
+    for (size_t i = 0; i < drawableArray.size; ++i)
+    {
+      Entity::id entity = drawableArray.sparseEntities[i];
+      if (IsInHierarchy(transforms, entity))
+      {
+        continue;
+      }
+      if (positionArray.sparseIndices[entity] == SIZE_MAX ||
+          scaleArray.sparseIndices[entity] == SIZE_MAX)
+      {
+        transforms.models[i] = drawableArray.array[i].model;
+        continue;
+      }
+
+      if (drawableArray.added[i] < tick && !IsChanged(positionArray, entity, tick) &&
+          !IsChanged(scaleArray, entity, tick) && !IsChanged(rotationArray, entity, tick))
+      {
+        continue;
+      }
+
+      const auto& drawable = drawableArray.array[i];
+      const auto& position = positionArray.array[positionArray.sparseIndices[entity]];
+      const auto& scale = scaleArray.array[scaleArray.sparseIndices[entity]];
+      size_t rotationIndex = rotationArray.sparseIndices[entity];
+      float rotation = rotationIndex != SIZE_MAX ? rotationArray.array[rotationIndex] : 0.f;
+
+      transforms.rows.PushBack((uint32_t)i);
+      transforms.x.PushBack(position.x + drawable.offset.x);
+      transforms.y.PushBack(position.y + drawable.offset.y);
+      transforms.scaleX.PushBack(scale.x);
+      transforms.scaleY.PushBack(scale.y);
+      transforms.cos.PushBack(cosf(rotation));
+      transforms.sin.PushBack(sinf(rotation));
+      transforms.models[i].rows[2] = drawable.model.rows[2];
+      transforms.models[i].rows[3] = drawable.model.rows[3];
+    }
+
+    size_t count = transforms.rows.size;
+    Compose(transforms.x.buffer,
+            transforms.y.buffer,
+            transforms.scaleX.buffer,
+            transforms.scaleY.buffer,
+            transforms.cos.buffer,
+            transforms.sin.buffer,
+            transforms.rows.buffer,
+            transforms.models.buffer,
+            count);
+
+    auto& hoverableArray = Scene::GetComponentArray<Type::HOVERABLE>(scene);
+    for (size_t i = 0; i < count; ++i)
+    {
+      uint32_t row = transforms.rows[i];
+      auto& drawable = drawableArray.array[row];
+      drawable.model = transforms.models[row];
+
+      size_t hoverableIndex = hoverableArray.sparseIndices[drawable.entity];
+      if (hoverableIndex != SIZE_MAX)
+      {
+        hoverableArray.array[hoverableIndex].model = drawable.model;
+        // Hoverable index refreshes the cached inverse and bounds of changed hoverables
+        MarkChanged(hoverableArray, drawable.entity);
+      }
+    }
+
+    count += UpdateHierarchy(scene, transforms, tick);
+    // Rows moved around, blending across it would mix up drawables
+    if (isRebuild && transforms.isInterpolated)
+    {
+      CopyModels(transforms.previousModels, transforms.models);
+    }
+
+    transforms.lastTick = Tick();
+    return count;
+  }
+
+  void Interpolate(Scene::Data& scene, Data& transforms, float alpha)
+  {
+    auto& drawableArray = Scene::GetComponentArray<Type::DRAWABLE>(scene);
+    if (transforms.previousModels.size != drawableArray.size ||
+        transforms.models.size != drawableArray.size)
+    {
+      return;
+    }
+    transforms.rows.Clear();
+    transforms.x.Clear();
+    transforms.y.Clear();
+    transforms.scaleX.Clear();
+    transforms.scaleY.Clear();
+    transforms.cos.Clear();
+    transforms.sin.Clear();
+    for (size_t i = 0; i < drawableArray.size; ++i)
+    {
+      const auto& from = transforms.previousModels[i];
+      const auto& to = transforms.models[i];
+      if (memcmp(&from.rows[0], &to.rows[0], sizeof(Math::Vec4f) * 2) == 0)
+      {
+        continue;
+      }
+      auto& model = drawableArray.array[i].model;
+      if (alpha >= 1.f)
+      {
+        model.rows[0] = to.rows[0];
+        model.rows[1] = to.rows[1];
+        continue;
+      }
+      // Blending the matrices themselves would shrink whatever turns in between
+      Decomposed a = Decompose(from);
+      Decomposed b = Decompose(to);
+      float turn = b.angle - a.angle;
+      if (turn > Math::PI)
+      {
+        turn -= 2 * Math::PI;
+      }
+      else if (turn < -Math::PI)
+      {
+        turn += 2 * Math::PI;
+      }
+      float angle = a.angle + turn * alpha;
+      transforms.rows.PushBack((uint32_t)i);
+      transforms.x.PushBack(a.x + (b.x - a.x) * alpha);
+      transforms.y.PushBack(a.y + (b.y - a.y) * alpha);
+      transforms.scaleX.PushBack(a.scaleX + (b.scaleX - a.scaleX) * alpha);
+      transforms.scaleY.PushBack(a.scaleY + (b.scaleY - a.scaleY) * alpha);
+      transforms.cos.PushBack(cosf(angle));
+      transforms.sin.PushBack(sinf(angle));
+    }
+
+    // Composed into a scratch array so the current models are kept for the next tick
+    size_t count = transforms.rows.size;
+    DynamicArray<uint32_t> order(true, Math::Max(count, 8ul));
+    DynamicArray<Math::Mat4> blended(true, Math::Max(count, 8ul));
+    blended.size = count;
+    for (size_t i = 0; i < count; ++i)
+    {
+      order.PushBack((uint32_t)i);
+    }
+    Compose(transforms.x.buffer,
+            transforms.y.buffer,
+            transforms.scaleX.buffer,
+            transforms.scaleY.buffer,
+            transforms.cos.buffer,
+            transforms.sin.buffer,
+            order.buffer,
+            blended.buffer,
+            count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      auto& model = drawableArray.array[transforms.rows[i]].model;
+      model.rows[0] = blended[i].rows[0];
+      model.rows[1] = blended[i].rows[1];
+    }
+  }
+
+  void Compose(const float* x,
+               const float* y,
+               const float* scaleX,
+               const float* scaleY,
+               const float* cos,
+               const float* sin,
+               const uint32_t* rows,
+               Math::Mat4* models,
+               size_t count)
+  {
+    // | sx * cos, -sy * sin, 0, x |
+    // | sx * sin,  sy * cos, 0, y |
+    const __m128 zero = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+      __m128 c = _mm_loadu_ps(cos + i);
+      __m128 s = _mm_loadu_ps(sin + i);
+      __m128 sx = _mm_loadu_ps(scaleX + i);
+      __m128 sy = _mm_loadu_ps(scaleY + i);
+
+      __m128 row0x = _mm_mul_ps(sx, c);
+      __m128 row0y = _mm_sub_ps(zero, _mm_mul_ps(sy, s));
+      __m128 row0z = zero;
+      __m128 row0w = _mm_loadu_ps(x + i);
+      __m128 row1x = _mm_mul_ps(sx, s);
+      __m128 row1y = _mm_mul_ps(sy, c);
+      __m128 row1z = zero;
+      __m128 row1w = _mm_loadu_ps(y + i);
+
+      // Lanes hold one entity each, transposing turns them into matrix rows
+      _MM_TRANSPOSE4_PS(row0x, row0y, row0z, row0w);
+      _MM_TRANSPOSE4_PS(row1x, row1y, row1z, row1w);
+
+      _mm_storeu_ps(models[rows[i]].rows[0].data, row0x);
+      _mm_storeu_ps(models[rows[i]].rows[1].data, row1x);
+      _mm_storeu_ps(models[rows[i + 1]].rows[0].data, row0y);
+      _mm_storeu_ps(models[rows[i + 1]].rows[1].data, row1y);
+      _mm_storeu_ps(models[rows[i + 2]].rows[0].data, row0z);
+      _mm_storeu_ps(models[rows[i + 2]].rows[1].data, row1z);
+      _mm_storeu_ps(models[rows[i + 3]].rows[0].data, row0w);
+      _mm_storeu_ps(models[rows[i + 3]].rows[1].data, row1w);
+    }
+
+    for (; i < count; ++i)
+    {
+      auto& model = models[rows[i]];
+      model.rows[0] = {scaleX[i] * cos[i], -scaleY[i] * sin[i], 0, x[i]};
+      model.rows[1] = {scaleX[i] * sin[i], scaleY[i] * cos[i], 0, y[i]};
+    }
+  }
+}
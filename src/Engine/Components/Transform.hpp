@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "STDPCH.hpp" // IWYU pragma: keep
+#include "Entity.hpp"
+#include "Math.hpp"
+#include "MemoryManager.hpp"
+#include "PagedArray.hpp"
+
+namespace Temp::Scene
+{
+  struct Data;
+}
+
+// Builds the model matrix of every drawable from its POSITION2D, SCALE and optional ROTATION.
+// Only entities whose components changed since the last Update get rebuilt. Their values are
+// gathered into SoA arrays and composed four matrices at a time with SSE.
+//
+// Rows 2 and 3 (z scale, z offset) are left as the drawable set them up.
+//
+// An entity with a PARENT is placed relative to its parent's world transform instead. Those
+// entities and the roots above them make up the hierarchy, an array where every root's subtree is
+// contiguous and depth sorted. One pass over it carries dirty flags from parents to children and
+// only recomputes the dirty subtrees, roots are split between the thread pool.
+//
+//   Scene::AddComponent<PARENT>(scene, child, panel);
+//
+// With a fixed time step a frame usually falls in between two ticks. When isInterpolated is set
+// the models of the tick before are kept as well, so Interpolate can draw every drawable alpha of
+// the way from its previous to its current model.
+namespace Temp::Component::Transform
+{
+  constexpr uint32_t NONE = UINT32_MAX;
+  // Longer parent chains (and cycles) are left out of the hierarchy
+  constexpr int MAX_DEPTH = 64;
+
+  struct Node
+  {
+    Entity::id entity{Entity::MAX};
+    // Node index of the parent | NONE for roots
+    uint32_t parent{NONE};
+    // Node indices of the first child and of the next child of the same parent | NONE
+    uint32_t firstChild{NONE};
+    uint32_t nextSibling{NONE};
+    // World transform without the drawable offset, laid out like rows 0 and 1 of a model
+    Math::Vec4f row0{1, 0, 0, 0};
+    Math::Vec4f row1{0, 1, 0, 0};
+    bool isDirty{false};
+
+    bool operator==(const Node&) const = default;
+  };
+
+  struct Data
+  {
+    // Value = Model matrix | Index = Drawable dense index
+    // Contiguous so the renderer can upload every model at once
+    SceneDynamicArray<Math::Mat4> models{};
+    // Dense drawable index of every gathered entity
+    SceneDynamicArray<uint32_t> rows{};
+    SceneDynamicArray<float> x{};
+    SceneDynamicArray<float> y{};
+    SceneDynamicArray<float> scaleX{};
+    SceneDynamicArray<float> scaleY{};
+    SceneDynamicArray<float> cos{};
+    SceneDynamicArray<float> sin{};
+    SceneDynamicArray<Node> nodes{};
+    // Node index each root's subtree starts at, followed by nodes.size
+    SceneDynamicArray<uint32_t> roots{};
+    // Value = Node index | Index = Entity
+    ScenePagedArray<uint32_t, Entity::PAGE_SIZE, Entity::NUM_PAGES> nodeIndices{{}, NONE};
+    // Value = Model matrix of the tick before | Index = Drawable dense index
+    SceneDynamicArray<Math::Mat4> previousModels{};
+    uint32_t lastTick{0};
+    // An entity of the hierarchy got destroyed since the last Update
+    bool isHierarchyChanged{false};
+    // Any entity got destroyed since the last Update
+    bool isEntityDestroyed{false};
+    // How far the frame is from the previous tick to the latest one
+    float alpha{1.f};
+    bool isInterpolated{false};
+  };
+
+  void Init(Data& transforms);
+  // Changes stamped during the tick of the previous Update are picked up once more so writes
+  // made after it ran aren't missed. Drawables in archetype storage aren't handled.
+  // Adding, changing or removing a PARENT and destroying an entity of the hierarchy rebuilds it.
+  // Returns the number of rebuilt matrices.
+  size_t Update(Scene::Data& scene, Data& transforms);
+  // Called by Scene::DestroyEntity before entity is gone. Its children lose their PARENT and become
+  // roots, otherwise they would follow whatever entity reuses the id. Children found through the
+  // node links are detached right away, ones parented since the last Update are detached by it.
+  void EntityDestroyed(Scene::Data& scene, Data& transforms, Entity::id entity);
+  [[nodiscard]] inline uint32_t NodeIndex(const Data& transforms, Entity::id entity)
+  {
+    return transforms.nodeIndices[entity];
+  }
+  // Sets rows 0 and 1 of every drawable that moved in the last tick to its position, scale and
+  // rotation blended from the previous to the current model. An alpha of 1 puts the current models
+  // back.
+  void Interpolate(Scene::Data& scene, Data& transforms, float alpha);
+  // Writes rows 0 and 1 of models[rows[i]] for count gathered entities
+  void Compose(const float* x,
+               const float* y,
+               const float* scaleX,
+               const float* scaleY,
+               const float* cos,
+               const float* sin,
+               const uint32_t* rows,
+               Math::Mat4* models,
+               size_t count);
+}
@@ -0,0 +1,343 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#include "Tween.hpp"
+#include "ComponentType.hpp"
+#include "Logger.hpp"
+#include "Scene.hpp"
+
+namespace Temp::Component::Tween
+{
+  namespace
+  {
+    template <typename T, typename F>
+    bool Write(ArrayData<T>& data, Entity::id entity, F&& func)
+    {
+      size_t index = data.sparseIndices[entity];
+      if (index == SIZE_MAX)
+      {
+        return false;
+      }
+      func(data.array[index]);
+      data.changed[index] = Tick();
+      return true;
+    }
+
+    void Move(Data& tweens, size_t from, size_t to)
+    {
+      tweens.entities[to] = tweens.entities[from];
+      tweens.properties[to] = tweens.properties[from];
+      tweens.easings[to] = tweens.easings[from];
+      tweens.start[to] = tweens.start[from];
+      tweens.end[to] = tweens.end[from];
+      tweens.elapsed[to] = tweens.elapsed[from];
+      tweens.invDuration[to] = tweens.invDuration[from];
+      tweens.targets[to] = tweens.targets[from];
+      tweens.serials[to] = tweens.serials[from];
+    }
+
+    void SetSize(Data& tweens, size_t size)
+    {
+      tweens.entities.size = size;
+      tweens.properties.size = size;
+      tweens.easings.size = size;
+      tweens.start.size = size;
+      tweens.end.size = size;
+      tweens.elapsed.size = size;
+      tweens.invDuration.size = size;
+      tweens.targets.size = size;
+      tweens.serials.size = size;
+    }
+
+    [[nodiscard]] inline size_t SerialIndex(Entity::id entity, uint32_t property)
+    {
+      return (size_t)entity * NUM_ENTITY_PROPERTIES + property;
+    }
+
+    void Push(Data& tweens,
+              Entity::id entity,
+              Property property,
+              float* target,
+              float start,
+              float end,
+              float duration,
+              Easing easing)
+    {
+      if (!IsInitialized(tweens))
+      {
+        Init(tweens);
+      }
+      tweens.entities.PushBack(entity);
+      tweens.properties.PushBack(property);
+      tweens.easings.PushBack(easing);
+      tweens.start.PushBack(start);
+      tweens.end.PushBack(end);
+      tweens.elapsed.PushBack(0);
+      // Zero durations jump to the end on the next Update
+      tweens.invDuration.PushBack(duration > 0 ? 1.f / duration : FLT_MAX);
+      tweens.targets.PushBack(target);
+      // Allocates the page, so Stop can skip entities that never had a tween
+      tweens.serials.PushBack(property == VALUE ? 0 : tweens.entitySerials.At(SerialIndex(entity, property)));
+    }
+
+    template <typename F>
+    size_t RemoveIf(Data& tweens, F&& func)
+    {
+      size_t kept = 0;
+      for (size_t i = 0; i < tweens.entities.size; ++i)
+      {
+        if (!func(i))
+        {
+          Move(tweens, i, kept++);
+        }
+      }
+      size_t removed = tweens.entities.size - kept;
+      SetSize(tweens, kept);
+      return removed;
+    }
+  }
+
+  void Init(Data& tweens)
+  {
+    tweens.entities = SceneDynamicArray<Entity::id>(true, Entity::PAGE_SIZE);
+    tweens.properties = SceneDynamicArray<uint32_t>(true, Entity::PAGE_SIZE);
+    tweens.easings = SceneDynamicArray<uint32_t>(true, Entity::PAGE_SIZE);
+    tweens.start = SceneDynamicArray<float>(true, Entity::PAGE_SIZE);
+    tweens.end = SceneDynamicArray<float>(true, Entity::PAGE_SIZE);
+    tweens.elapsed = SceneDynamicArray<float>(true, Entity::PAGE_SIZE);
+    tweens.invDuration = SceneDynamicArray<float>(true, Entity::PAGE_SIZE);
+    tweens.targets = SceneDynamicArray<float*>(true, Entity::PAGE_SIZE);
+    tweens.serials = SceneDynamicArray<uint32_t>(true, Entity::PAGE_SIZE);
+    tweens.entitySerials.Init(0);
+    tweens.values = SceneDynamicArray<float>(true, Entity::PAGE_SIZE);
+  }
+
+  void Add(Data& tweens,
+           Entity::id entity,
+           Property property,
+           float start,
+           float end,
+           float duration,
+           Easing easing)
+  {
+    if (property == VALUE)
+    {
+      Logger::LogErr("[Tween] Add: VALUE tweens need a target!");
+      assert(false);
+      return;
+    }
+    Push(tweens, entity, property, nullptr, start, end, duration, easing);
+  }
+
+  void Add(Data& tweens, float* target, float start, float end, float duration, Easing easing)
+  {
+    Push(tweens, Entity::MAX, VALUE, target, start, end, duration, easing);
+  }
+
+  void To(Scene::Data& scene,
+          Data& tweens,
+          Entity::id entity,
+          Property property,
+          float end,
+          float duration,
+          Easing easing)
+  {
+    const auto& positionArray = Scene::GetComponentArray<Type::POSITION2D>(scene);
+    const auto& scaleArray = Scene::GetComponentArray<Type::SCALE>(scene);
+    const auto& rotationArray = Scene::GetComponentArray<Type::ROTATION>(scene);
+    float start = 0;
+    switch (property)
+    {
+      case POSITION_X:
+        start = Component::Get(positionArray, entity).x;
+        break;
+      case POSITION_Y:
+        start = Component::Get(positionArray, entity).y;
+        break;
+      case SCALE_X:
+        start = Component::Get(scaleArray, entity).x;
+        break;
+      case SCALE_Y:
+        start = Component::Get(scaleArray, entity).y;
+        break;
+      case ROTATION:
+        start = Component::Get(rotationArray, entity);
+        break;
+      case VALUE:
+        Logger::LogErr("[Tween] To: VALUE tweens need a target!");
+        assert(false);
+        return;
+    }
+    Stop(tweens, entity, property);
+    Add(tweens, entity, property, start, end, duration, easing);
+  }
+
+  void Stop(Data& tweens, Entity::id entity, Property property)
+  {
+    size_t index = SerialIndex(entity, property);
+    if (property != VALUE && tweens.entitySerials.HasPage(index))
+    {
+      ++tweens.entitySerials.At(index);
+    }
+  }
+
+  void Stop(Data& tweens, Entity::id entity)
+  {
+    for (uint32_t property = 0; property < NUM_ENTITY_PROPERTIES; ++property)
+    {
+      Stop(tweens, entity, (Property)property);
+    }
+  }
+
+  size_t Stop(Data& tweens, const float* target)
+  {
+    return RemoveIf(tweens, [&tweens, target](size_t i) {
+      return tweens.properties[i] == VALUE && tweens.targets[i] == target;
+    });
+  }
+
+  size_t Update(Scene::Data& scene, Data& tweens, float deltaTime)
+  {
+    size_t count = tweens.entities.size;
+    if (count == 0)
+    {
+      return 0;
+    }
+
+    tweens.values.Reserve(count);
+    tweens.values.size = count;
+    Evaluate(tweens.elapsed.buffer,
+             tweens.invDuration.buffer,
+             tweens.start.buffer,
+             tweens.end.buffer,
+             tweens.easings.buffer,
+             tweens.values.buffer,
+             count,
+             deltaTime);
+
+    auto& positionArray = Scene::GetComponentArray<Type::POSITION2D>(scene);
+    auto& scaleArray = Scene::GetComponentArray<Type::SCALE>(scene);
+    auto& rotationArray = Scene::GetComponentArray<Type::ROTATION>(scene);
+    size_t kept = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      Entity::id entity = tweens.entities[i];
+      bool isFinished = tweens.elapsed[i] * tweens.invDuration[i] >= 1.f;
+      // Land exactly on end, start + (end - start) can be off by a bit
+      float value = isFinished ? tweens.end[i] : tweens.values[i];
+      uint32_t property = tweens.properties[i];
+      // Not stopped since it was added
+      bool isAlive = property == VALUE ||
+                     tweens.serials[i] == tweens.entitySerials[SerialIndex(entity, property)];
+      if (isAlive)
+      {
+        switch (property)
+        {
+          case POSITION_X:
+            isAlive = Write(positionArray, entity, [value](Math::Vec2f& position) { position.x = value; });
+            break;
+          case POSITION_Y:
+            isAlive = Write(positionArray, entity, [value](Math::Vec2f& position) { position.y = value; });
+            break;
+          case SCALE_X:
+            isAlive = Write(scaleArray, entity, [value](Math::Vec2f& scale) { scale.x = value; });
+            break;
+          case SCALE_Y:
+            isAlive = Write(scaleArray, entity, [value](Math::Vec2f& scale) { scale.y = value; });
+            break;
+          case ROTATION:
+            isAlive = Write(rotationArray, entity, [value](float& rotation) { rotation = value; });
+            break;
+          case VALUE:
+            *tweens.targets[i] = value;
+            break;
+        }
+      }
+
+      if (isAlive && !isFinished)
+      {
+        if (kept != i)
+        {
+          Move(tweens, i, kept);
+        }
+        ++kept;
+      }
+    }
+    SetSize(tweens, kept);
+    return kept;
+  }
+
+  void Evaluate(float* elapsed,
+                const float* invDuration,
+                const float* start,
+                const float* end,
+                const uint32_t* easings,
+                float* values,
+                size_t count,
+                float deltaTime)
+  {
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 two = _mm_set1_ps(2.f);
+    const __m128 three = _mm_set1_ps(3.f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128i easeIn = _mm_set1_epi32(EASE_IN);
+    const __m128i easeOut = _mm_set1_epi32(EASE_OUT);
+    const __m128i easeInOut = _mm_set1_epi32(EASE_IN_OUT);
+    const __m128i smoothstep = _mm_set1_epi32(SMOOTHSTEP);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+      __m128 time = _mm_add_ps(_mm_loadu_ps(elapsed + i), dt);
+      _mm_storeu_ps(elapsed + i, time);
+      __m128 t = _mm_min_ps(_mm_mul_ps(time, _mm_loadu_ps(invDuration + i)), one);
+
+      // Every easing is a few multiplies, computing all of them beats branching per lane
+      __m128 in = _mm_mul_ps(t, t);
+      __m128 out = _mm_mul_ps(t, _mm_sub_ps(two, t));
+      __m128 rest = _mm_sub_ps(one, t);
+      __m128 inOut = _mm_blendv_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_mul_ps(rest, rest))),
+                                   _mm_mul_ps(two, in),
+                                   _mm_cmplt_ps(t, half));
+      __m128 smooth = _mm_mul_ps(in, _mm_sub_ps(three, _mm_mul_ps(two, t)));
+
+      __m128i easing = _mm_loadu_si128((const __m128i*)(easings + i));
+      __m128 eased = t;
+      eased = _mm_blendv_ps(eased, in, _mm_castsi128_ps(_mm_cmpeq_epi32(easing, easeIn)));
+      eased = _mm_blendv_ps(eased, out, _mm_castsi128_ps(_mm_cmpeq_epi32(easing, easeOut)));
+      eased = _mm_blendv_ps(eased, inOut, _mm_castsi128_ps(_mm_cmpeq_epi32(easing, easeInOut)));
+      eased = _mm_blendv_ps(eased, smooth, _mm_castsi128_ps(_mm_cmpeq_epi32(easing, smoothstep)));
+
+      __m128 from = _mm_loadu_ps(start + i);
+      __m128 to = _mm_loadu_ps(end + i);
+      _mm_storeu_ps(values + i, _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(to, from), eased)));
+    }
+
+    for (; i < count; ++i)
+    {
+      elapsed[i] += deltaTime;
+      float t = Math::Min(elapsed[i] * invDuration[i], 1.f);
+      values[i] = start[i] + (end[i] - start[i]) * Ease((Easing)easings[i], t);
+    }
+  }
+
+  float Ease(Easing easing, float t)
+  {
+    switch (easing)
+    {
+      case EASE_IN:
+        return t * t;
+      case EASE_OUT:
+        return t * (2.f - t);
+      case EASE_IN_OUT:
+        // 2t² for the first half, mirrored for the second
+        return t < 0.5f ? 2.f * t * t : 1.f - 2.f * (1.f - t) * (1.f - t);
+      case SMOOTHSTEP:
+        return t * t * (3.f - 2.f * t);
+      case LINEAR:
+      default:
+        return t;
+    }
+  }
+}
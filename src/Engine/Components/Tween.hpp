@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "STDPCH.hpp" // IWYU pragma: keep
+#include "Entity.hpp"
+#include "MemoryManager.hpp"
+#include "PagedArray.hpp"
+
+namespace Temp::Scene
+{
+  struct Data;
+}
+
+// Tweens one float of an entity's POSITION2D, SCALE or ROTATION (or any float the game owns,
+// like an alpha it uploads as a uniform) from start to end over a duration.
+//
+// Active tweens live in SoA arrays and Update evaluates them four at a time with SSE before
+// writing the results into the components. Tweens finish, and are dropped, once they reach
+// end. Tweens of an entity that lost the component are dropped too.
+//
+// Stopping an entity's tweens only bumps its serials, the next Update drops every tween that was
+// added under an older serial. Destroying entities and restarting tweens stays O(1) per call.
+//
+//   Tween::To(scene, scene.tweens, button, Tween::SCALE_X, 1.1f, 0.15f, Tween::EASE_OUT);
+namespace Temp::Component::Tween
+{
+  enum Property : uint32_t
+  {
+    POSITION_X = 0,
+    POSITION_Y,
+    SCALE_X,
+    SCALE_Y,
+    ROTATION,
+    // Writes to the target pointer
+    VALUE,
+  };
+  constexpr size_t NUM_ENTITY_PROPERTIES = VALUE;
+
+  enum Easing : uint32_t
+  {
+    LINEAR = 0,
+    EASE_IN,
+    EASE_OUT,
+    EASE_IN_OUT,
+    SMOOTHSTEP,
+  };
+
+  struct Data
+  {
+    // Value = Tween | Index = Active tween, in the order they were added
+    SceneDynamicArray<Entity::id> entities{};
+    SceneDynamicArray<uint32_t> properties{};
+    SceneDynamicArray<uint32_t> easings{};
+    SceneDynamicArray<float> start{};
+    SceneDynamicArray<float> end{};
+    SceneDynamicArray<float> elapsed{};
+    SceneDynamicArray<float> invDuration{};
+    // VALUE tweens only
+    SceneDynamicArray<float*> targets{};
+    // Serial of the entity and property when the tween was added
+    SceneDynamicArray<uint32_t> serials{};
+    // Value = Serial | Index = Entity * NUM_ENTITY_PROPERTIES + Property
+    ScenePagedArray<uint32_t, Entity::PAGE_SIZE, Entity::NUM_PAGES * NUM_ENTITY_PROPERTIES>
+      entitySerials{};
+    // Results of the last Evaluate
+    SceneDynamicArray<float> values{};
+  };
+
+  void Init(Data& tweens);
+  [[nodiscard]] inline bool IsInitialized(const Data& tweens) { return tweens.values.buffer != nullptr; }
+  // Duration is in the same unit as Scene::Update's deltaTime (seconds)
+  void Add(Data& tweens,
+           Entity::id entity,
+           Property property,
+           float start,
+           float end,
+           float duration,
+           Easing easing = LINEAR);
+  // Writes into target until the tween finishes, whoever owns target has to Stop it before
+  // freeing target
+  void Add(Data& tweens, float* target, float start, float end, float duration, Easing easing = LINEAR);
+  // Starts from the property's current value, stopping the tweens already running on it
+  void To(Scene::Data& scene,
+          Data& tweens,
+          Entity::id entity,
+          Property property,
+          float end,
+          float duration,
+          Easing easing = LINEAR);
+  // Stopped tweens are dropped by the next Update without writing anything
+  void Stop(Data& tweens, Entity::id entity, Property property);
+  void Stop(Data& tweens, Entity::id entity);
+  // Removes them right away, returns how many tweens were removed
+  size_t Stop(Data& tweens, const float* target);
+  // Advances every tween, writes the results and drops finished and stopped ones. Returns how many
+  // are still running.
+  size_t Update(Scene::Data& scene, Data& tweens, float deltaTime);
+  // Adds deltaTime to elapsed and writes the eased values of count tweens
+  void Evaluate(float* elapsed,
+                const float* invDuration,
+                const float* start,
+                const float* end,
+                const uint32_t* easings,
+                float* values,
+                size_t count,
+                float deltaTime);
+  [[nodiscard]] float Ease(Easing easing, float t);
+}
@@ -30,19 +30,25 @@ set ( ENGINE_INCLUDE_DIRS
 set ( ENGINE_SRC
   ${CMAKE_SCRIPT_DIR}/Audio/AudioSystem.cpp
   ${CMAKE_SCRIPT_DIR}/Camera.cpp
+  ${CMAKE_SCRIPT_DIR}/Components/Collision.cpp
   ${CMAKE_SCRIPT_DIR}/Components/ComponentContainer.cpp
   ${CMAKE_SCRIPT_DIR}/Components/Drawable.cpp
   ${CMAKE_SCRIPT_DIR}/Components/Hoverable.cpp
+  ${CMAKE_SCRIPT_DIR}/Components/Transform.cpp
+  ${CMAKE_SCRIPT_DIR}/Components/Tween.cpp
   ${CMAKE_SCRIPT_DIR}/Components/Updateable.cpp
   ${CMAKE_SCRIPT_DIR}/Engine.cpp
   ${CMAKE_SCRIPT_DIR}/EngineUtils.cpp
+  ${CMAKE_SCRIPT_DIR}/Entity/Archetype.cpp
   ${CMAKE_SCRIPT_DIR}/Entity/EntityData.cpp
   ${CMAKE_SCRIPT_DIR}/Entity/Sprite.cpp
   ${CMAKE_SCRIPT_DIR}/Entity/TextBox.cpp
   ${CMAKE_SCRIPT_DIR}/Entity/TextButton.cpp
   ${CMAKE_SCRIPT_DIR}/Event.cpp
   ${CMAKE_SCRIPT_DIR}/FontLoader.cpp
+  ${CMAKE_SCRIPT_DIR}/FramePacer.cpp
   ${CMAKE_SCRIPT_DIR}/Input.cpp
+  ${CMAKE_SCRIPT_DIR}/LevelSerializer/LevelBinary.cpp
   ${CMAKE_SCRIPT_DIR}/LevelSerializer/LevelSerializer.cpp
   ${CMAKE_SCRIPT_DIR}/Logger.cpp
   ${CMAKE_SCRIPT_DIR}/Math.cpp
@@ -51,8 +57,14 @@ set ( ENGINE_SRC
   ${CMAKE_SCRIPT_DIR}/Render/OpenGL/OpenGLWrapper.cpp
   ${CMAKE_SCRIPT_DIR}/Render/Shader.cpp
   ${CMAKE_SCRIPT_DIR}/STD.cpp
+  ${CMAKE_SCRIPT_DIR}/Scene/Prefab.cpp
   ${CMAKE_SCRIPT_DIR}/Scene/Scene.cpp
+  ${CMAKE_SCRIPT_DIR}/Scene/SceneCommands.cpp
+  ${CMAKE_SCRIPT_DIR}/Scene/SceneLoader.cpp
   ${CMAKE_SCRIPT_DIR}/Scene/SceneObject.cpp
+  ${CMAKE_SCRIPT_DIR}/Scene/SceneSnapshot.cpp
+  ${CMAKE_SCRIPT_DIR}/Scene/SceneSystems.cpp
+  ${CMAKE_SCRIPT_DIR}/Scene/SpatialGrid.cpp
   ${CMAKE_SCRIPT_DIR}/ThreadPool.cpp
 )
 set (ENGINE_PCH_HEADER
@@ -66,11 +78,13 @@ set (EDITOR_SRC
 if (WIN32)
   list (APPEND ENGINE_SRC
     ${CMAKE_SCRIPT_DIR}/Render/glad/wgl.c
+    ${CMAKE_SCRIPT_DIR}/Render/OpenGL/NullRender.cpp
     ${CMAKE_SCRIPT_DIR}/Render/OpenGL/WinRender.cpp
     ${CMAKE_SCRIPT_DIR}/Render/glad/gl.c
   )
 elseif (LINUX)
   list (APPEND ENGINE_SRC
+    ${CMAKE_SCRIPT_DIR}/Render/OpenGL/NullRender.cpp
     ${CMAKE_SCRIPT_DIR}/Render/OpenGL/X11Render.cpp
     ${CMAKE_SCRIPT_DIR}/Render/glad/glx.c
     ${CMAKE_SCRIPT_DIR}/Render/glad/gl.c
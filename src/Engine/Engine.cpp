@@ -7,9 +7,14 @@
 #include "Camera.hpp"
 #include "EngineUtils.hpp"
 #include "Event.hpp"
+#include "LevelBinary.hpp"
 #include "MemoryManager.hpp"
+#ifndef __APPLE__
+#include "NullRender.hpp"
+#endif
 #include "OpenGLWrapper.hpp"
 #include "Scene.hpp"
+#include "SceneLoader.hpp"
 #include "SceneObject.hpp"
 #include "Shader.hpp"
 #include "String.hpp"
@@ -26,9 +31,8 @@ namespace Temp
 {
   namespace
   {
-    struct SpawnData
+    struct SpawnCallback
     {
-      SceneObject::Data sceneObject;
       void(*fn)(void*){nullptr};
       void* spawnData{nullptr};
     };
@@ -47,11 +51,17 @@ namespace Temp
     // Exists only because I'm lazy
     Scene::Data* scene{nullptr};
     AudioSystem::Data audioSystem;
-    GlobalDynamicArray<SpawnData> spawnObjects{};
+    // Kept apart from the callbacks so the objects can be spawned as one contiguous batch
+    GlobalDynamicArray<SceneObject::Data> spawnObjects{};
+    GlobalDynamicArray<SpawnCallback> spawnCallbacks{};
     GlobalDynamicArray<Entity::id> removeObjects{};
+    // Swapped with removeObjects while removing, so removals queued meanwhile land in a fresh list
+    GlobalDynamicArray<Entity::id> removingObjects{};
     GlobalDynamicArray<GlobalString> audioPaths{};
     float deltaTime{};
     float time{};
+    // Frame time that's still to be simulated in fixed time step mode
+    float accumulator{};
 #ifdef DEBUG
     GlobalPath dllLockFileEntry = (ApplicationDirectory() / "lock.file").c_str();
     PathData dllLockFile = {dllLockFileEntry.c_str(), dllLockFileEntry.LastWriteTime()};
@@ -67,6 +77,52 @@ namespace Temp
     std::atomic<bool> reload{false};
 #endif
 
+#ifndef EDITOR
+    // Compiled levels are mapped by Construct, only text levels are worth reading ahead
+    void PrefetchLevel(const Scene::SceneFns& sceneFns)
+    {
+      String file = String(sceneFns.name.c_str()) + ".level";
+      String binaryFile = String(sceneFns.name.c_str()) + ".blevel";
+      if (!LevelSerializer::Binary::IsUpToDate(binaryFile.c_str(), file.c_str()))
+      {
+        Scene::Loader::Prefetch(Scene::GetLoader(), file.c_str());
+      }
+    }
+#endif
+
+    // Drops the first count elements and keeps the order of the rest
+    template <typename T>
+    void EraseFront(GlobalDynamicArray<T>& array, size_t count)
+    {
+      for (size_t i = count; i < array.size; ++i)
+      {
+        array[i - count] = std::move(array[i]);
+      }
+      while (count-- > 0)
+      {
+        array.PopBack();
+      }
+    }
+
+    // Runs as many ticks of timeStep as fit into the time that's built up
+    void RunTicks(Scene::Data& scene, float frameTime, float timeStep, int maxTicks)
+    {
+      scene.transforms.isInterpolated = true;
+      accumulator += frameTime;
+      for (int ticks = 0; ticks < maxTicks && accumulator >= timeStep; ++ticks)
+      {
+        deltaTime = timeStep;
+        Scene::Update(scene, timeStep);
+        accumulator -= timeStep;
+      }
+      // Fell behind, catching up would only make the next frame slower
+      if (accumulator >= timeStep)
+      {
+        accumulator = fmodf(accumulator, timeStep);
+      }
+      scene.transforms.alpha = accumulator / timeStep;
+    }
+
 #ifdef DEBUG
     void HotReloadThread()
     {
@@ -148,13 +204,7 @@ namespace Temp
 
       while (Global::IsActive())
       {
-        static auto start = std::chrono::high_resolution_clock::now();
-        auto stop = std::chrono::high_resolution_clock::now();
-        float deltaTime = std::chrono::duration<float, std::chrono::seconds::period>(stop - start)
-                            .count();
-        start = stop;
-
-        Global::Process(deltaTime);
+        Global::Process(Global::PaceFrame());
       }
       Global::Destroy();
     }
@@ -167,12 +217,32 @@ namespace Temp
   {
     SceneObject::Init();
     Scene::Initialize(engine.scene);
+#ifndef __APPLE__
+    engine.isHeadless |= getenv("TEMP_HEADLESS") != nullptr;
+#else
+    // The macOS renderer runs the main loop itself
+    engine.isHeadless = false;
+#endif
+    audioSystem.isNull = engine.isHeadless;
     AudioSystem::ReadAudioFiles(audioSystem, audioPaths);
 
     scene = &engine.scene;
     scene->sceneFns = &engine.sceneFns.front();
+#ifndef EDITOR
+    // Read while the window gets created
+    PrefetchLevel(*scene->sceneFns);
+#endif
     // Start Render Thread
-    Render::Initialize(*scene, windowName, windowX, windowY);
+#ifndef __APPLE__
+    if (engine.isHeadless)
+    {
+      Render::Null::Initialize(*scene, windowX, windowY);
+    }
+    else
+#endif
+    {
+      Render::Initialize(*scene, windowName, windowX, windowY);
+    }
 
 #ifdef DEBUG
     for (const auto& entry : DirectoryContents((AssetsDirectory() / "Shaders").buffer.c_str()))
@@ -208,12 +278,25 @@ namespace Temp
 
     hotReloadThread = std::thread(HotReloadThread);
 #endif
+
+    if (engine.isHeadless)
+    {
+      engine.framePacer.mode = FramePacer::Mode::UNLIMITED;
+      engine.framePacer.backgroundFps = 0.f;
+    }
+    // Don't count the time it took to get here as a frame
+    FramePacer::Reset(engine.framePacer);
   }
 
   void Global::Process(float _deltaTime)
   {
     static Scene::SceneFns* nextSceneFns{nullptr};
 
+    // Nobody's watching, simulate as fast as possible
+    if (engine.isHeadless && engine.fixedTimeStep > 0.f)
+    {
+      _deltaTime = engine.fixedTimeStep;
+    }
     Temp::deltaTime = _deltaTime;
     time += _deltaTime;
 
@@ -227,15 +310,42 @@ namespace Temp
           nextSceneFns = nullptr;
         }
         Scene::ClearRender(*scene);
+        accumulator = 0;
         // This should always run before DrawConstruct
         Scene::Construct(*scene);
-        Scene::DrawConstruct(*scene);
+        Scene::Loader::BeginDrawConstruct(Scene::GetLoader());
+        scene->state = Scene::State::LOAD;
+      }
+      [[fallthrough]];
+      case Scene::State::LOAD:
+      {
+        if (!Scene::Loader::DrawConstruct(*scene, Scene::GetLoader()))
+        {
+          break;
+        }
         scene->state = Scene::State::RUN;
+#ifndef EDITOR
+        // Read the next level while this one runs
+        if (scene->sceneFns->nextScene)
+        {
+          PrefetchLevel(*scene->sceneFns->nextScene);
+        }
+#endif
       }
       break;
       case Scene::State::RUN:
       {
-        Scene::Update(*scene, deltaTime);
+        if (engine.fixedTimeStep > 0.f)
+        {
+          RunTicks(*scene, _deltaTime, engine.fixedTimeStep, engine.maxTicksPerFrame);
+        }
+        else
+        {
+          // The fixed step may have been turned off, frames draw the latest models again
+          scene->transforms.isInterpolated = false;
+          scene->transforms.alpha = 1.f;
+          Scene::Update(*scene, deltaTime);
+        }
         Scene::DrawUpdate(*scene);
       }
       break;
@@ -289,23 +399,39 @@ namespace Temp
 #endif
 
     // Process events in the renderer
-    Render::Run(*scene);
+#ifndef __APPLE__
+    if (engine.isHeadless)
+    {
+      Render::Null::Run(*scene);
+    }
+    else
+#endif
+    {
+      Render::Run(*scene);
+    }
     Input::Process(engine.inputData);
 
+    // Drain everything that was queued up to this frame, callbacks may queue more for the next one
     if (spawnObjects.size > 0)
     {
-      Scene::SpawnObject(*scene, spawnObjects.back().sceneObject);
-      if (spawnObjects.back().fn)
+      size_t count = spawnObjects.size;
+      Scene::SpawnObjects(*scene, spawnObjects.buffer, count);
+      for (size_t i = 0; i < count; ++i)
       {
-        spawnObjects.back().fn(spawnObjects.back().spawnData);
+        if (spawnCallbacks[i].fn)
+        {
+          spawnCallbacks[i].fn(spawnCallbacks[i].spawnData);
+        }
       }
-      spawnObjects.PopBack();
+      EraseFront(spawnObjects, count);
+      EraseFront(spawnCallbacks, count);
     }
 
     if (removeObjects.size > 0)
     {
-      Scene::RemoveObject(*scene, removeObjects.back());
-      removeObjects.PopBack();
+      removingObjects.swap(removeObjects);
+      Scene::RemoveObjects(*scene, removingObjects.buffer, removingObjects.size);
+      removingObjects.Clear();
     }
   }
 
@@ -320,13 +446,7 @@ namespace Temp
 
     while (Global::IsActive())
     {
-      static auto start = std::chrono::high_resolution_clock::now();
-      auto stop = std::chrono::high_resolution_clock::now();
-      float _deltaTime = std::chrono::duration<float, std::chrono::seconds::period>(stop - start)
-                           .count();
-      start = stop;
-
-      Global::Process(_deltaTime);
+      Global::Process(Global::PaceFrame());
     }
     Global::Destroy();
     // Render::Run(engine.scene, windowName, windowX, windowY);
@@ -335,7 +455,7 @@ namespace Temp
 
   void Global::Destroy()
   {
-    if (engine.scene.state == Scene::State::RUN)
+    if (engine.scene.state == Scene::State::RUN || engine.scene.state == Scene::State::LOAD)
     {
       Scene::ClearRender(*scene);
       Scene::DrawDestruct(*scene);
@@ -345,7 +465,10 @@ namespace Temp
     stopHotReloadThread = true;
     hotReloadThread.join();
 #endif
-    Render::Destroy();
+    if (!engine.isHeadless)
+    {
+      Render::Destroy();
+    }
     // For now the games should handle clean up of scenes
     Render::OpenGLWrapper::Destruct();
     Scene::Destroy(engine.scene);
@@ -358,12 +481,36 @@ namespace Temp
 
   bool Global::IsActive() { return !engine.quit; }
 
+  bool Global::IsHeadless() { return engine.isHeadless; }
+
   bool Global::IsSpawning() { return spawnObjects.size > 0; }
 
   float Global::DeltaTime() { return deltaTime; }
 
   float Global::Time() { return time; }
 
+  float Global::TickAlpha() { return engine.scene.transforms.alpha; }
+
+  float Global::LoadProgress() { return Scene::Loader::Progress(Scene::GetLoader()); }
+
+  float Global::PaceFrame() { return FramePacer::Pace(engine.framePacer); }
+
+  void Global::SetFramePacing(FramePacer::Mode mode, float targetFps)
+  {
+    engine.framePacer.mode = mode;
+    engine.framePacer.targetFps = targetFps;
+  }
+
+  FramePacer::Stats Global::FrameStats() { return FramePacer::GetStats(engine.framePacer); }
+
+  int Global::SwapInterval() { return FramePacer::SwapInterval(engine.framePacer); }
+
+  void Global::SetVsyncSupported(bool isSupported) { engine.framePacer.isVsyncSupported = isSupported; }
+
+  void Global::SetWindowFocused(bool isFocused) { engine.framePacer.isFocused = isFocused; }
+
+  void Global::SetWindowMinimized(bool isMinimized) { engine.framePacer.isMinimized = isMinimized; }
+
   void Global::SetAudioPaths(const DynamicArray<GlobalString, MemoryManager::Data::GLOBAL_ARENA>& _audioPaths)
   {
     Temp::audioPaths = _audioPaths;
@@ -419,7 +566,8 @@ namespace Temp
 
   void Global::SpawnObject(SceneObject::Data object, void(*callback)(void*), void* data)
   {
-    spawnObjects.PushBack({std::move(object), callback, data});
+    spawnObjects.PushBack(std::move(object));
+    spawnCallbacks.PushBack({callback, data});
   }
 
   void Global::RemoveObject(Entity::id entity) { removeObjects.PushBack(std::move(entity)); }
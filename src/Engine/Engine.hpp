@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "FramePacer.hpp"
 #include "Input.hpp"
 #include "Math.hpp"
 #include "Scene.hpp"
@@ -26,6 +27,16 @@ namespace Temp::Engine
     Input::Data inputData{};
     Scene::Data scene{};
     Math::Vec4f backgroundColor{0.2f, 0.2f, 0.2f, 1.0f};
+    // Seconds per simulation tick. Frames run as many ticks as fit into the time that passed and
+    // drawables are drawn in between the last two. 0 runs one tick per frame with the frame time.
+    float fixedTimeStep{0.f};
+    // Time beyond this many ticks per frame is dropped so a slow frame can't snowball
+    int maxTicksPerFrame{8};
+    // Frame limiting and vsync, see FramePacer.hpp
+    FramePacer::Data framePacer{};
+    // No window, GL or audio device, see NullRender.hpp. Also set by the TEMP_HEADLESS environment
+    // variable. Runs one fixedTimeStep tick per frame as fast as it can when that's set.
+    bool isHeadless{false};
     bool quit{false};
 
     Data(){}
@@ -35,6 +46,10 @@ namespace Temp::Engine
         inputData(other.inputData),
         scene(other.scene),
         backgroundColor(other.backgroundColor),
+        fixedTimeStep(other.fixedTimeStep),
+        maxTicksPerFrame(other.maxTicksPerFrame),
+        framePacer(other.framePacer),
+        isHeadless(other.isHeadless),
         quit(other.quit)
     {
       // ignored
@@ -58,6 +73,10 @@ namespace Temp::Engine
       Utils::Swap(first.inputData, second.inputData);
       Utils::Swap(first.scene, second.scene);
       Utils::Swap(first.backgroundColor, second.backgroundColor);
+      Utils::Swap(first.fixedTimeStep, second.fixedTimeStep);
+      Utils::Swap(first.maxTicksPerFrame, second.maxTicksPerFrame);
+      Utils::Swap(first.framePacer, second.framePacer);
+      Utils::Swap(first.isHeadless, second.isHeadless);
       Utils::Swap(first.quit, second.quit);
     }
   };
@@ -79,10 +98,28 @@ namespace Temp
     static void Construct(Engine::Data _engine);
     static void Quit();
     static bool IsActive();
+    static bool IsHeadless();
     static bool IsSpawning();
     static constexpr const Math::Vec4f& GetBackgroundColor() { return engine.backgroundColor; };
+    // Length of the tick being simulated, fixedTimeStep when it's set
     static float DeltaTime();
     static float Time();
+    // 0 to 1, how far the frame being drawn is from the previous tick to the latest one
+    static float TickAlpha();
+    // 0 to 1 while the next scene is read and DrawConstructed, for loading screens
+    static float LoadProgress();
+
+    // FRAME PACING
+    // Waits for the next frame and returns the time since the last one, called by the main loops
+    static float PaceFrame();
+    static void SetFramePacing(FramePacer::Mode mode, float targetFps = 60.f);
+    static FramePacer::Stats FrameStats();
+    static int SwapInterval();
+    // Sent by the renderers, VSYNC falls back to the target fps without swap control
+    static void SetVsyncSupported(bool isSupported);
+    // Sent by the renderers, frames are throttled while the window is in the background
+    static void SetWindowFocused(bool isFocused);
+    static void SetWindowMinimized(bool isMinimized);
     
     // AUDIO
     static void SetAudioPaths(const DynamicArray<GlobalString, MemoryManager::Data::GLOBAL_ARENA>& _audioPaths);
@@ -4,6 +4,11 @@
 #include "EngineUtils.hpp"
 #include "FileSystem.hpp"
 #include "Logger.hpp"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 #ifdef __linux__
 #include <dlfcn.h>
 #elif __APPLE__
@@ -83,6 +88,81 @@ namespace Temp
     return assetsDirectory;
   }
 
+  bool MapFile(MappedFile& file, const char* path)
+  {
+    file = {};
+#ifdef _WIN32
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+    {
+      return false;
+    }
+    fseek(fp, 0, SEEK_END);
+    size_t length = (size_t)ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (length == 0)
+    {
+      fclose(fp);
+      return true;
+    }
+    char* buffer = static_cast<char*>(malloc(length));
+    bool isRead = buffer && fread(buffer, 1, length, fp) == length;
+    fclose(fp);
+    if (!isRead)
+    {
+      // Nothing for UnmapFile to free on failure
+      free(buffer);
+      file.buffer = nullptr;
+      return false;
+    }
+    file.buffer = buffer;
+    file.length = length;
+    return true;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+      return false;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0)
+    {
+      close(fd);
+      return false;
+    }
+    if (fileStat.st_size == 0)
+    {
+      close(fd);
+      return true;
+    }
+    size_t length = (size_t)fileStat.st_size;
+    void* buffer = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps the file alive
+    close(fd);
+    if (buffer == MAP_FAILED)
+    {
+      return false;
+    }
+    file.buffer = static_cast<const char*>(buffer);
+    file.length = length;
+    return true;
+#endif
+  }
+
+  void UnmapFile(MappedFile& file)
+  {
+    if (!file.buffer)
+    {
+      return;
+    }
+#ifdef _WIN32
+    free(const_cast<char*>(file.buffer));
+#else
+    munmap(const_cast<char*>(file.buffer), file.length);
+#endif
+    file = {};
+  }
+
   void* OpenDynamicLibrary(const char* name)
   {
     void* libHandle = nullptr;
@@ -158,6 +158,17 @@ namespace Temp
     return false;
   }
 
+  // Read only view of a whole file, mapped where the platform supports it
+  struct MappedFile
+  {
+    const char* buffer{nullptr};
+    size_t length{0};
+  };
+
+  // An empty file maps to a null buffer of length 0
+  bool MapFile(MappedFile& file, const char* path);
+  void UnmapFile(MappedFile& file);
+
   void* OpenDynamicLibrary(const char* name);
   void* GetDynamicLibraryFn(void* libraryHandle, const char* fn);
   void CloseDynamicLibrary(void* libraryHandle);
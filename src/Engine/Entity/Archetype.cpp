@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#include "Archetype.hpp"
+#include "GameComponentType.hpp"
+#include "LinearAllocator.hpp"
+#include "MemoryManager.hpp"
+
+namespace Temp::Archetype
+{
+  namespace
+  {
+    constexpr uint8_t ENUM_MIN = 0;
+    constexpr uint8_t ENUM_MAX = Temp::Component::GameType::MAX - 1;
+
+    // Type erased operations so rows can be moved between tables
+    struct ComponentInfo
+    {
+      size_t size{0};
+      size_t align{1};
+      void (*construct)(void*){nullptr};
+      void (*moveConstruct)(void*, void*){nullptr};
+      void (*destruct)(void*){nullptr};
+    };
+
+    ComponentInfo componentInfos[Component::Container::MAX]{};
+
+    template <uint8_t E>
+    void InitEnum()
+    {
+      using T = Component::MapToComponentDataType<E>;
+      componentInfos[E] = {
+        sizeof(T),
+        alignof(T),
+        [](void* dst) { new (dst) T(); },
+        [](void* dst, void* src) { new (dst) T(std::move(*static_cast<T*>(src))); },
+        [](void* dst) { static_cast<T*>(dst)->~T(); },
+      };
+    }
+
+    template <uint8_t E, uint8_t ENUM_MAX>
+    struct EnumRange
+    {
+      static void InitEnums()
+      {
+        InitEnum<E>();
+        if constexpr (E < ENUM_MAX)
+          EnumRange<E + 1, ENUM_MAX>::InitEnums();
+      }
+    };
+
+    inline void* Cell(const Table& table, size_t row, uint8_t type)
+    {
+      return Chunk(table, row) + table.columns[type] +
+             (row % table.rowsPerChunk) * componentInfos[type].size;
+    }
+
+    uint32_t CreateTable(Data& data, ComponentBits bits)
+    {
+      Table table{};
+      table.bits = bits;
+
+      size_t rowSize = sizeof(Entity::id);
+      size_t alignSlack = 0;
+      for (uint8_t type = 0; type < Component::Container::MAX; ++type)
+      {
+        table.columns[type] = SIZE_MAX;
+        if (Test(bits, type))
+        {
+          rowSize += componentInfos[type].size;
+          alignSlack += componentInfos[type].align;
+        }
+      }
+      table.rowsPerChunk =
+        CHUNK_SIZE > alignSlack ? LinearAllocator::Max((CHUNK_SIZE - alignSlack) / rowSize, 1ul) : 1;
+
+      size_t offset = table.entityColumn + table.rowsPerChunk * sizeof(Entity::id);
+      for (uint8_t type = 0; type < Component::Container::MAX; ++type)
+      {
+        if (Test(bits, type))
+        {
+          offset = LinearAllocator::AlignForward(offset, componentInfos[type].align);
+          table.columns[type] = offset;
+          offset += table.rowsPerChunk * componentInfos[type].size;
+        }
+      }
+      table.chunkSize = LinearAllocator::Max(offset, CHUNK_SIZE);
+
+      data.tables.PushBack(std::move(table));
+      return (uint32_t)data.tables.size - 1;
+    }
+
+    uint32_t FindOrCreateTable(Data& data, ComponentBits bits)
+    {
+      for (size_t i = 0; i < data.tables.size; ++i)
+      {
+        if (data.tables[i].bits == bits)
+        {
+          return (uint32_t)i;
+        }
+      }
+      return CreateTable(data, bits);
+    }
+
+    size_t AddRow(Table& table)
+    {
+      if (table.size == table.chunks.size * table.rowsPerChunk)
+      {
+        table.chunks.PushBack(static_cast<uint8_t*>(
+          MemoryManager::data.Allocate(MemoryManager::Data::SCENE_ARENA, table.chunkSize)));
+      }
+      return table.size++;
+    }
+
+    // Destructs the row and fills the hole with the last row
+    void RemoveRow(Data& data, uint32_t tableIdx, size_t row)
+    {
+      Table& table = data.tables[tableIdx];
+      size_t last = table.size - 1;
+      for (uint8_t type = 0; type < Component::Container::MAX; ++type)
+      {
+        if (!Test(table.bits, type))
+        {
+          continue;
+        }
+        componentInfos[type].destruct(Cell(table, row, type));
+        if (row != last)
+        {
+          componentInfos[type].moveConstruct(Cell(table, row, type), Cell(table, last, type));
+          componentInfos[type].destruct(Cell(table, last, type));
+        }
+      }
+      if (row != last)
+      {
+        Entity::id moved = *Entities(table, last);
+        *Entities(table, row) = moved;
+        data.locations.At(moved).row = (uint32_t)row;
+      }
+      --table.size;
+    }
+  }
+
+  void Init(Data& data)
+  {
+    EnumRange<ENUM_MIN, ENUM_MAX>::InitEnums();
+    data.tables = SceneDynamicArray<Table>(true, 16);
+    data.locations.Init({});
+  }
+
+  void Move(Data& data, Entity::id entity, ComponentBits bits)
+  {
+    Location from = data.locations[entity];
+    uint32_t to = bits ? FindOrCreateTable(data, bits) : INVALID;
+    if (from.table == to)
+    {
+      return;
+    }
+
+    if (to != INVALID)
+    {
+      Table& dst = data.tables[to];
+      size_t row = AddRow(dst);
+      *Entities(dst, row) = entity;
+      for (uint8_t type = 0; type < Component::Container::MAX; ++type)
+      {
+        if (!Test(bits, type))
+        {
+          continue;
+        }
+        if (from.table != INVALID && Test(data.tables[from.table].bits, type))
+        {
+          componentInfos[type].moveConstruct(Cell(dst, row, type),
+                                             Cell(data.tables[from.table], from.row, type));
+        }
+        else
+        {
+          componentInfos[type].construct(Cell(dst, row, type));
+        }
+      }
+      data.locations.At(entity) = {to, (uint32_t)row};
+    }
+    else
+    {
+      data.locations.At(entity) = {};
+    }
+
+    if (from.table != INVALID)
+    {
+      RemoveRow(data, from.table, from.row);
+    }
+  }
+
+  void EntityDestroyed(Data& data, Entity::id entity) { Move(data, entity, 0); }
+}
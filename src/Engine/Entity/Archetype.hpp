@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Component.hpp"
+#include "ComponentContainer.hpp"
+#include "ComponentType.hpp"
+#include "Entity.hpp"
+#include "PagedArray.hpp"
+
+// Archetype storage: every entity with the same ComponentBits lives in the same table, and
+// each table stores its rows in fixed size chunks laid out as struct-of-arrays:
+//
+//   | entity ids ... | column A ... | column B ... |
+//
+// Iterating a query walks matching tables chunk by chunk instead of hopping between sparse sets.
+// Adding or removing a component moves the entity's row to the table of its new ComponentBits.
+namespace Temp::Archetype
+{
+  constexpr size_t CHUNK_SIZE = 16 * 1024;
+  constexpr uint32_t INVALID = UINT32_MAX;
+
+  struct Location
+  {
+    uint32_t table{INVALID};
+    uint32_t row{0};
+
+    constexpr bool operator==(const Location&) const = default;
+  };
+
+  struct Table
+  {
+    ComponentBits bits{0};
+    // Byte offset of each component's column inside a chunk | SIZE_MAX = not in this table
+    size_t columns[Component::Container::MAX];
+    size_t entityColumn{0};
+    size_t rowsPerChunk{0};
+    size_t chunkSize{0};
+    size_t size{0};
+    SceneDynamicArray<uint8_t*> chunks{};
+
+    constexpr bool operator==(const Table& other) const { return bits == other.bits; }
+  };
+
+  struct Data
+  {
+    SceneDynamicArray<Table> tables{};
+    // Value = Location | Index = Entity
+    ScenePagedArray<Location, Entity::PAGE_SIZE, Entity::NUM_PAGES> locations{};
+  };
+
+  void Init(Data& data);
+  // Moves the entity's row into the table for bits. Columns that didn't exist before are default
+  // constructed and columns that aren't in bits anymore are destructed. bits == 0 drops the row.
+  void Move(Data& data, Entity::id entity, ComponentBits bits);
+  void EntityDestroyed(Data& data, Entity::id entity);
+
+  [[nodiscard]] inline uint8_t* Chunk(const Table& table, size_t row)
+  {
+    return table.chunks[row / table.rowsPerChunk];
+  }
+
+  [[nodiscard]] inline Entity::id* Entities(const Table& table, size_t row)
+  {
+    return reinterpret_cast<Entity::id*>(Chunk(table, row) + table.entityColumn) +
+           row % table.rowsPerChunk;
+  }
+
+  template <uint8_t T>
+  [[nodiscard]] inline Component::MapToComponentDataType<T>* Column(const Table& table, size_t row)
+  {
+    return reinterpret_cast<Component::MapToComponentDataType<T>*>(Chunk(table, row) +
+                                                                   table.columns[T]) +
+           row % table.rowsPerChunk;
+  }
+
+  template <uint8_t T>
+  [[nodiscard]] inline Component::MapToComponentDataType<T>* Get(const Data& data, Entity::id entity)
+  {
+    const Location& location = data.locations[entity];
+    if (location.table == INVALID)
+    {
+      return nullptr;
+    }
+    const Table& table = data.tables[location.table];
+    if (!Test(table.bits, T))
+    {
+      return nullptr;
+    }
+    return Column<T>(table, location.row);
+  }
+
+  template <uint8_t T>
+  inline void Set(Data& data,
+                  Entity::id entity,
+                  ComponentBits bits,
+                  Component::MapToComponentDataType<T> component)
+  {
+    Move(data, entity, bits);
+    *Get<T>(data, entity) = std::move(component);
+  }
+
+  // Number of rows in tables that have every component in mask
+  [[nodiscard]] inline size_t Count(const Data& data, ComponentBits mask)
+  {
+    size_t count = 0;
+    for (const auto& table : data.tables)
+    {
+      if ((table.bits & mask) == mask)
+      {
+        count += table.size;
+      }
+    }
+    return count;
+  }
+
+  // func(Entity::id, Ts&...) over the rows [begin, end) of all matching tables, in table order.
+  // Rows are walked a chunk at a time so each column is read linearly.
+  template <uint8_t... Ts, typename F>
+  inline void Each(const Data& data,
+                   ComponentBits mask,
+                   F&& func,
+                   size_t begin = 0,
+                   size_t end = SIZE_MAX)
+  {
+    size_t base = 0;
+    for (const auto& table : data.tables)
+    {
+      if ((table.bits & mask) != mask || table.size == 0)
+      {
+        continue;
+      }
+      if (base >= end)
+      {
+        return;
+      }
+      size_t row = begin > base ? begin - base : 0;
+      size_t rowEnd = end - base < table.size ? end - base : table.size;
+      base += table.size;
+      while (row < rowEnd)
+      {
+        size_t offset = row % table.rowsPerChunk;
+        size_t count = table.rowsPerChunk - offset < rowEnd - row ? table.rowsPerChunk - offset
+                                                                   : rowEnd - row;
+        [&func, count](Entity::id* entities, auto*... columns) {
+          for (size_t i = 0; i < count; ++i)
+          {
+            func(entities[i], columns[i]...);
+          }
+        }(Entities(table, row), Column<Ts>(table, row)...);
+        row += count;
+      }
+    }
+  }
+}
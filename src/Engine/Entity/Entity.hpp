@@ -7,6 +7,9 @@
 
 namespace Temp::Entity
 {
-  using id = unsigned short;
-  constexpr id MAX = 4096;
+  using id = uint32_t;
+  // Sparse entity lookups are paged so this only bounds the id range, not memory usage
+  constexpr id MAX = 1 << 20;
+  constexpr id PAGE_SIZE = 4096;
+  constexpr id NUM_PAGES = MAX / PAGE_SIZE;
 }
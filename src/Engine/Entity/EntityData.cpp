@@ -10,33 +10,36 @@ namespace Temp::Entity
 {
   namespace
   {
-    Entity::id numEntities = 0;
-
     Entity::id GetAvailable(Data& entityData)
     {
-      for (Entity::id i = 0; i < Entity::MAX; ++i)
+      if (entityData.freeEntities.size > 0)
+      {
+        Entity::id entity = entityData.freeEntities.back();
+        entityData.freeEntities.PopBack();
+        entityData.used[entity] = true;
+        return entity;
+      }
+      if (entityData.used.size >= Entity::MAX)
       {
-        if (!entityData.used[i])
-        {
-          entityData.used[i] = true;
-          ++numEntities;
-          return i;
-        }
+        return Entity::MAX;
       }
-      return Entity::MAX;
+      Entity::id entity = (Entity::id)entityData.used.size;
+      entityData.used.PushBack(true);
+      entityData.componentBits.PushBack(0);
+      return entity;
     }
 
     void ResetAvailable(Data& entityData, Entity::id entity)
     {
       entityData.componentBits[entity] = 0;
       entityData.used[entity] = false;
-      --numEntities;
+      entityData.freeEntities.PushBack(entity);
     }
 
 #ifdef DEBUG
-    void Check(const String& err)
+    void Check(Data& entityData, const String& err)
     {
-      if (numEntities >= Entity::MAX)
+      if (Count(entityData) >= Entity::MAX)
       {
         Logger::LogErr(err);
       }
@@ -46,22 +49,34 @@ namespace Temp::Entity
 
   void Init(Data& entityData)
   {
+    auto storage = entityData.storage;
     entityData = {};
-    numEntities = 0;
-    entityData.used.Reserve(Entity::MAX);
-    entityData.componentBits.Reserve(Entity::MAX);
+    entityData.storage = storage;
+    entityData.used.Reserve(Entity::PAGE_SIZE);
+    entityData.componentBits.Reserve(Entity::PAGE_SIZE);
+    entityData.freeEntities.Reserve(Entity::PAGE_SIZE);
     Component::Container::Init(entityData.componentContainer);
+    Archetype::Init(entityData.archetypes);
   }
 
   void Destroy(Data& entityData, Entity::id entity)
   {
 #ifdef DEBUG
-    Check(String("[Entity] Above limit: ") + String::ToString(entity));
+    Check(entityData, String("[Entity] Above limit: ") + String::ToString(entity));
 #endif
+    if (!IsAlive(entityData, entity))
+    {
+      Logger::LogErr("[Entity] Destroy: Entity is not alive!");
+      return;
+    }
     ResetAvailable(entityData, entity);
     Component::Container::EntityDestroyed(entityData.componentContainer, entity);
+    if (entityData.storage == Storage::ARCHETYPE)
+    {
+      Archetype::EntityDestroyed(entityData.archetypes, entity);
+    }
 #ifdef DEBUG
-    Check(String("[Entity] Underflow: ") + String::ToString(entity));
+    Check(entityData, String("[Entity] Underflow: ") + String::ToString(entity));
 #endif
   }
 
@@ -70,21 +85,16 @@ namespace Temp::Entity
   ::Temp::ComponentBits& ComponentBits(Data& entityData, Entity::id entity)
   {
 #ifdef DEBUG
-    Check(String("[Entity] Above limit: ") + String::ToString(entity));
+    Check(entityData, String("[Entity] Above limit: ") + String::ToString(entity));
 #endif
     return entityData.componentBits[entity];
   }
 
   void Destruct(Data& entityData)
   {
-    for (size_t i = 0; i < entityData.used.size; ++i)
-    {
-      if (entityData.used[i])
-      {
-        Destroy(entityData, i);
-        --numEntities;
-      }
-    }
+    // Component arrays live in the scene arena so they're dropped wholesale instead of per entity
+    entityData.used.Clear();
+    entityData.freeEntities.Clear();
     Component::Container::Destruct(entityData.componentContainer);
   }
 
@@ -95,5 +105,14 @@ namespace Temp::Entity
     Component::Container::Reset(entityData.componentContainer);
   }
 
-  size_t Count(Data& entityData) { return numEntities; }
+  // Derived from the arrays instead of counted so it survives Scene::Restore
+  size_t Count(Data& entityData) { return entityData.used.size - entityData.freeEntities.size; }
+
+  void Reserve(Data& entityData, size_t count)
+  {
+    size_t size = entityData.used.size + count;
+    size = size > entityData.freeEntities.size ? size - entityData.freeEntities.size : 0;
+    entityData.used.Reserve(size);
+    entityData.componentBits.Reserve(size);
+  }
 }
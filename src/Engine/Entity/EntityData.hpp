@@ -3,22 +3,42 @@
 
 #pragma once
 
+#include "Archetype.hpp"
 #include "Component.hpp"
 #include "ComponentContainer.hpp"
 #include "ComponentType.hpp"
 #include "Entity.hpp"
+#include "Logger.hpp"
 
 namespace Temp
 {
   namespace Entity
   {
+    namespace Storage
+    {
+      enum Type : uint8_t
+      {
+        // Components live in one sparse set per type (Component::ArrayData)
+        SPARSE_SET = 0,
+        // Components live in SoA chunks grouped by ComponentBits (Archetype::Data).
+        // Only Get/AddComponent/RemoveComponent and Scene::View see these components,
+        // GetComponentArray stays empty!
+        ARCHETYPE,
+        MAX
+      };
+    }
+
     struct Data
     {
-      // Using dynamic array so it isn't initialized on construction
-      // Should be used as a regular array here!
+      // Indexed by entity, grows with the highest entity created
       SceneDynamicArray<bool> used{};
       SceneDynamicArray<::Temp::ComponentBits> componentBits{};
+      // Destroyed entities are recycled from here before growing the arrays above
+      SceneDynamicArray<Entity::id> freeEntities{};
       Component::Container::Data componentContainer;
+      Archetype::Data archetypes{};
+      // Set before Init, survives Init/Reset
+      Storage::Type storage{Storage::SPARSE_SET};
     };
 
     void Init(Data& data);
@@ -28,27 +48,65 @@ namespace Temp
     void Destruct(Data& data);
     void Reset(Data& data);
     size_t Count(Data& data);
+    // Makes room for count more entities so a batch of spawns doesn't regrow the arrays
+    void Reserve(Data& data, size_t count);
+
+    [[nodiscard]] inline bool IsAlive(const Data& data, Entity::id entity)
+    {
+      return entity < data.used.size && data.used[entity];
+    }
 
     template <uint8_t T>
     constexpr void AddComponent(Data& data,
                                 Entity::id entity,
                                 Component::MapToComponentDataType<T> component)
     {
-      SetBit(Entity::ComponentBits(data, entity), T);
+      auto& bits = Entity::ComponentBits(data, entity);
+      SetBit(bits, T);
+      if (data.storage == Storage::ARCHETYPE)
+      {
+        Archetype::Set<T>(data.archetypes, entity, bits, std::move(component));
+        return;
+      }
       Component::Container::Set<T>(data.componentContainer, entity, std::move(component));
     }
 
     template <uint8_t T>
     constexpr void RemoveComponent(Data& data, Entity::id entity)
     {
-      ClearBit(Entity::ComponentBits(data, entity), T);
+      auto& bits = Entity::ComponentBits(data, entity);
+      ClearBit(bits, T);
+      if (data.storage == Storage::ARCHETYPE)
+      {
+        Archetype::Move(data.archetypes, entity, bits);
+        return;
+      }
       Component::Container::Remove<T>(data.componentContainer, entity);
     }
 
     template <uint8_t T>
     constexpr void AddCacheComponent(Data& data, Entity::id entity)
     {
-      Component::Container::SetCache<T>(data.componentContainer, entity);
+      auto& array = Component::Container::GetComponentArray<T>(data.componentContainer);
+      if (data.storage == Storage::ARCHETYPE)
+      {
+        auto* component = Archetype::Get<T>(data.archetypes, entity);
+        if (!component)
+        {
+          Logger::LogErr("[EntityData] AddCacheComponent: Entity doesn't have the component!");
+          return;
+        }
+        Component::SetCache(array, entity, std::move(*component));
+      }
+      else
+      {
+        if (array.sparseIndices[entity] == SIZE_MAX)
+        {
+          Logger::LogErr("[EntityData] AddCacheComponent: Entity doesn't have the component!");
+          return;
+        }
+        Component::SetCache(array, entity);
+      }
       RemoveComponent<T>(data, entity);
     }
 
@@ -64,6 +122,13 @@ namespace Temp
     [[nodiscard]] constexpr Component::MapToComponentDataType<T>& Get(Data& entityData,
                                                                       Entity::id entity)
     {
+      if (entityData.storage == Storage::ARCHETYPE)
+      {
+        if (auto* component = Archetype::Get<T>(entityData.archetypes, entity))
+        {
+          return *component;
+        }
+      }
       return Component::Container::Get<T>(entityData.componentContainer, entity);
     }
 
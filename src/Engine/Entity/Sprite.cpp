@@ -6,6 +6,7 @@
 #include "Hoverable.hpp"
 #include "Logger.hpp"
 #include "Scene.hpp"
+#include "SceneLoader.hpp"
 #include "TGA.hpp"
 #include "OpenGLWrapper.hpp"
 
@@ -76,10 +77,16 @@ namespace Temp::Sprite
 
     auto& drawable = Scene::Get<Temp::Component::Type::DRAWABLE>(scene, sprite.entity);
     TGA::Header header;
-    if ((drawable.texture = OpenGLWrapper::LoadTextureTGA(sprite.fileName.c_str(),
-                                                          GL_BGRA,
-                                                          header,
-                                                          GL_NEAREST)) == UINT_MAX)
+    // Decoded by the loader thread when the level got prefetched
+    if (uint8_t* pixels = Scene::Loader::FindTexture(Scene::GetLoader(), sprite.fileName.c_str(), header))
+    {
+      drawable.texture = OpenGLWrapper::CreateTextureTGA(header, pixels, GL_BGRA, GL_NEAREST);
+    }
+    else
+    {
+      drawable.texture = OpenGLWrapper::LoadTextureTGA(sprite.fileName.c_str(), GL_BGRA, header, GL_NEAREST);
+    }
+    if (drawable.texture == UINT_MAX)
     {
       Logger::LogErr("[Sprite] Could not load TGA image!");
     }
@@ -14,6 +14,7 @@
 #include "OpenGLWrapper.hpp"
 #include "Scene.hpp"
 #include "SceneObject.hpp"
+#include "Tokenizer.hpp"
 // #include "gl.h"
 #include <cstdint>
 #ifdef EDITOR
@@ -39,7 +40,7 @@ namespace Temp::TextBox
     }
 
     void PopulateVerticesIndices(Data& textBox,
-                                 const String& string,
+                                 std::string_view string,
                                  DynamicArray<float, MemoryManager::Data::Type::SCENE_ARENA>& vertices,
                                  DynamicArray<unsigned int, MemoryManager::Data::Type::SCENE_ARENA>& indices,
                                  float& x,
@@ -48,7 +49,7 @@ namespace Temp::TextBox
                                  int& characterCount)
     {
       // iterate through all characters
-      for (unsigned int i = 0; i < string.size; ++i)
+      for (unsigned int i = 0; i < string.size(); ++i)
       {
         char c = string[i];
         // Should only be possible at runtime.
@@ -56,7 +57,7 @@ namespace Temp::TextBox
         if (c == '\n')
         {
           MoveCursor(x, y, characterCount);
-          characterCount = (int)string.size - i + 1;
+          characterCount = (int)string.size() - i + 1;
           continue;
         }
         const Font::Character& ch = Font::Characters(textBox.fontType)[c];
@@ -114,18 +115,20 @@ namespace Temp::TextBox
       int characterIdx = 0;
       int characterCount = 0;
 
-      String textTempStr = textBox.text.c_str();
-      auto splitStrings = SplitString(Trim(textTempStr), " ");
-
-      for (size_t i = 0; i < splitStrings.size; ++i)
+      // Words are views into the text so that nothing gets allocated, Prepare runs on workers
+      std::string_view text = Tokenizer::Trim(std::string_view(textBox.text.c_str(), textBox.text.size));
+      while (!text.empty())
       {
-        auto string = splitStrings[i];
-        characterCount += (int)string.size;
+        size_t end = text.find(' ');
+        bool isLast = end == std::string_view::npos;
+        std::string_view string = text.substr(0, end);
+        text = isLast ? std::string_view{} : text.substr(end + 1);
+        characterCount += (int)string.size();
         // iterate through all characters
         if (!textBox.singleCharacterWriteMode && characterCount > textBox.maxCharactersPerLine)
         {
           MoveCursor(x, y, characterCount);
-          characterCount = (int)string.size;
+          characterCount = (int)string.size();
 #ifdef EDITOR
           if (!textBox.hasParent)
           {
@@ -136,7 +139,7 @@ namespace Temp::TextBox
         }
         // clang-format off
         PopulateVerticesIndices(textBox, string, vertices, indices, x, y, characterIdx, characterCount);
-        if (i < splitStrings.size - 1)
+        if (!isLast)
         {
           PopulateVerticesIndices(textBox, " ", vertices, indices, x, y, characterIdx, characterCount);
           characterCount += 1;
@@ -266,17 +269,6 @@ namespace Temp::TextBox
       Scene::AddComponent<Component::Type::HOVERABLE>(scene, textBox.entity, hoverable);
     }
 #endif
-#ifndef DEBUG
-    PopulateVerticesIndices(scene, textBox);
-#ifdef EDITOR
-    if (!textBox.hasParent)
-    {
-      auto& hoverable = Scene::Get<Temp::Component::Type::HOVERABLE>(scene, textBox.entity);
-      hoverable.triangles = Triangles(scene, textBox);
-    }
-#endif
-#endif
-
     Scene::AddComponent<Component::Type::POSITION2D>(scene,
                                                      textBox.entity,
                                                      {ctorData.x, ctorData.y});
@@ -291,7 +283,24 @@ namespace Temp::TextBox
       addedDrawable.vertices.Reserve(textBox.maxCharacters * 16 * 1000);
       addedDrawable.indices.Reserve(textBox.maxCharacters * 6 * 1000);
     }
+    // Every character is at most one quad. Allocated here since the arenas aren't thread safe and
+    // Prepare lays the text out on a worker.
+    addedDrawable.vertices.Reserve(textBox.text.size * 16);
+    addedDrawable.indices.Reserve(textBox.text.size * 6);
+    addedDrawable.vertices.Buffer();
+    addedDrawable.indices.Buffer();
+  }
+
+#ifdef DEBUG
+  void Prepare(Scene::Data&, Data&)
+  {
   }
+#else
+  void Prepare(Scene::Data& scene, Data& textBox)
+  {
+    PopulateVerticesIndices(scene, textBox);
+  }
+#endif
 
   void UpdateText(Scene::Data& scene, Data& textBox, const char* newText)
   {
@@ -49,6 +49,9 @@ namespace Temp::TextBox
 
   void DrawConstruct(Scene::Data& scene, Data& textBox, int shaderType = Render::ShaderIdx::TEXT);
   void Construct(Scene::Data& scene, Data& textBox, const ConstructData& ctorData, Entity::id entity);
+  // Lays out the text into what Construct reserved. Doesn't touch the arenas or the GL context so
+  // it can run on the thread pool. DEBUG builds lay out in DrawConstruct instead to pick up edits.
+  void Prepare(Scene::Data& scene, Data& textBox);
   void UpdateText(Scene::Data& scene, Data& textBox, const char* newText);
   void Update(Scene::Data& scene, Data& textBox);
   void DrawUpdate(Scene::Data& scene, Component::Drawable::Data& drawable, Data& textBox);
@@ -47,6 +47,8 @@ namespace Temp::TextButton
     SetHoverableCallbacks(scene, textButton);
   }
 
+  void Prepare(Scene::Data& scene, Data& textButton) { TextBox::Prepare(scene, textButton.textBox); }
+
   void DrawConstruct(Scene::Data& scene, Data& textButton, int shaderType)
   {
     TextBox::DrawConstruct(scene, textButton.textBox, shaderType);
@@ -35,6 +35,7 @@ namespace Temp::TextButton
   };
 
   void Construct(Scene::Data& scene, Data& textButton, ConstructData& ctorData, Entity::id entity);
+  void Prepare(Scene::Data& scene, Data& textButton);
   void DrawConstruct(Scene::Data& scene, Data& textButton, int shaderType = Render::ShaderIdx::TEXT);
   void DrawUpdate(Scene::Data& scene, Component::Drawable::Data& drawable, Data& textButton);
   void UpdateText(Scene::Data& scene, Data& textButton, const char* newText);
@@ -91,20 +91,9 @@ namespace Temp::Event
 
     if (scene.state == Scene::State::RUN)
     {
-      auto& hoverableArray = Scene::GetComponentArray<Component::Type::HOVERABLE>(scene);
-      for (size_t i = 0; i < hoverableArray.size; ++i)
-      {
-        auto& hoverable = hoverableArray.array[i];
-        if (Component::Hoverable::IsInsideRaycast(hoverable, mouseX, mouseY) ||
-            Component::Hoverable::IsInside(hoverable, mouseX, mouseY))
-        {
-          Component::Hoverable::HoverableEnter(scene, hoverable);
-        }
-        else
-        {
-          Component::Hoverable::HoverableLeave(scene, hoverable);
-        }
-      }
+      Component::Hoverable::Hover(scene,
+                                  scene.hoverIndex,
+                                  Camera::ConvertScreenCoordsToViewSpace(mouseX, mouseY));
 
       if (EventData.buttonPressed[1])
       {
@@ -117,6 +106,13 @@ namespace Temp::Event
                                      (float)EventData.lastMouseY,
                                      mouseX,
                                      mouseY);
+          // Dragging writes through the pointer, stamp it so the hover index picks it up
+          auto& hoverableArray = Scene::GetComponentArray<Component::Type::HOVERABLE>(scene);
+          size_t index = &hoverable - hoverableArray.array.buffer;
+          if (index < hoverableArray.size)
+          {
+            Component::MarkChanged(hoverableArray, hoverableArray.sparseEntities[index]);
+          }
         }
 #ifdef EDITOR
         else
@@ -159,12 +155,15 @@ namespace Temp::Event
     if (scene.state == Scene::State::RUN && EventData.buttonPressed[1])
     {
       auto& hoverableArray = Scene::GetComponentArray<Component::Type::HOVERABLE>(scene);
-      for (int i = hoverableArray.size - 1; i >= 0; --i)
+      auto viewSpaceCoords = Camera::ConvertScreenCoordsToViewSpace(mouseX, mouseY);
+      const auto& candidates = Component::Hoverable::Query(scene, scene.hoverIndex, viewSpaceCoords);
+      for (size_t c = candidates.size; c > 0; --c)
       {
+        size_t i = candidates[c - 1];
         auto& hoverable = hoverableArray.array[i];
         Entity::id entity = hoverableArray.sparseEntities[i];
-        if (Component::Hoverable::IsInsideRaycast(hoverable, mouseX, mouseY) ||
-            Component::Hoverable::IsInside(hoverable, mouseX, mouseY))
+        if (Component::Hoverable::IsInside(hoverable, viewSpaceCoords) ||
+            Component::Hoverable::IsInsideRaycastCached(hoverable, viewSpaceCoords))
         {
           EventData.selectedObject = &Scene::GetObject(scene, entity);
           EventData.draggable = &hoverable;
@@ -202,11 +201,14 @@ namespace Temp::Event
     if (scene.state == Scene::State::RUN)
     {
       auto& hoverableArray = Scene::GetComponentArray<Component::Type::HOVERABLE>(scene);
-      for (size_t i = 0; i < hoverableArray.size; ++i)
+      auto viewSpaceCoords = Camera::ConvertScreenCoordsToViewSpace(mouseX, mouseY);
+      // Candidates come sorted by depth, the last one is on top
+      const auto& candidates = Component::Hoverable::Query(scene, scene.hoverIndex, viewSpaceCoords);
+      for (size_t c = candidates.size; c > 0; --c)
       {
-        auto& hoverable = hoverableArray.array[i];
-        if (Component::Hoverable::IsInsideRaycast(hoverable, mouseX, mouseY) ||
-            Component::Hoverable::IsInside(hoverable, mouseX, mouseY))
+        auto& hoverable = hoverableArray.array[candidates[c - 1]];
+        if (Component::Hoverable::IsInside(hoverable, viewSpaceCoords) ||
+            Component::Hoverable::IsInsideRaycastCached(hoverable, viewSpaceCoords))
         {
           hoverable.Click(scene, hoverable);
           break;
@@ -251,23 +253,10 @@ namespace Temp::Event
     Temp::Render::OpenGLWrapper::LoadShaders();
 
     Resize(EventData);
-
-    EventData.renderBegin = clock();
   }
 
-  void RenderRun(Scene::Data& scene, Event::Data& EventData)
+  void RenderRun(Scene::Data& scene, Event::Data&)
   {
-    // TODO: Use High Resolution Timer here
-    clock_t end{clock()};
-    {
-      if (EventData.limitFps &&
-          ((float)(end - EventData.renderBegin) / CLOCKS_PER_SEC) < EventData.fps60)
-      {
-        return;
-      }
-      EventData.renderBegin = clock();
-    }
-
     static const auto& bgColor = Global::GetBackgroundColor();
     glClearColor(bgColor.x, bgColor.y, bgColor.z, bgColor.w);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -27,18 +27,13 @@ namespace Temp::Event
 {
   struct Data
   {
-    clock_t renderBegin{clock()};
-
     Component::Hoverable::Data* draggable{nullptr};
     SceneObject::Data* selectedObject{nullptr};
 
-    const float fps60{0.0166666f * 2.f};
-    const float fps30{0.0333333f * 2.f};
     int windowWidth{};
     int windowHeight{};
     int lastMouseX{};
     int lastMouseY{};
-    bool limitFps{false};
     bool isInFullScreen{false};
 #ifdef EDITOR
     bool ctrlPressed{false};
@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#include "FramePacer.hpp"
+
+namespace Temp::FramePacer
+{
+  namespace
+  {
+    typedef std::chrono::steady_clock Clock;
+    typedef std::chrono::duration<float> Seconds;
+
+    constexpr float MIN_SLEEP_ERROR = 0.0002f;
+    // Covers the default 15.6 ms timer resolution on Windows
+    constexpr float MAX_SLEEP_ERROR = 0.02f;
+    // A single late wake up shouldn't make every frame after it spin longer forever
+    constexpr float SLEEP_ERROR_DECAY = 0.99f;
+
+    void WaitUntil(Data& pacer, Clock::time_point deadline)
+    {
+      auto now = Clock::now();
+      float sleepTime = Seconds(deadline - now).count() - pacer.sleepError;
+      if (sleepTime > 0.f)
+      {
+        std::this_thread::sleep_for(Seconds(sleepTime));
+        float overslept = Seconds(Clock::now() - now).count() - sleepTime;
+        float sleepError = Math::Max(overslept, pacer.sleepError * SLEEP_ERROR_DECAY);
+        pacer.sleepError = Math::Min(Math::Max(sleepError, MIN_SLEEP_ERROR), MAX_SLEEP_ERROR);
+      }
+      while (Clock::now() < deadline)
+      {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  float FrameTime(const Data& pacer)
+  {
+    if (!pacer.isFocused || pacer.isMinimized)
+    {
+      return pacer.backgroundFps > 0.f ? 1.f / pacer.backgroundFps : 0.f;
+    }
+    // Without swap control nothing else would hold a VSYNC loop back
+    bool isTargetFps = pacer.mode == Mode::TARGET_FPS ||
+                       (pacer.mode == Mode::VSYNC && !pacer.isVsyncSupported);
+    if (isTargetFps && pacer.targetFps > 0.f)
+    {
+      return 1.f / pacer.targetFps;
+    }
+    return 0.f;
+  }
+
+  int SwapInterval(const Data& pacer)
+  {
+    return pacer.mode == Mode::VSYNC && pacer.isVsyncSupported ? 1 : 0;
+  }
+
+  void Reset(Data& pacer)
+  {
+    pacer.frameStart = Clock::now();
+    pacer.numSamples = 0;
+    pacer.nextSample = 0;
+  }
+
+  float Pace(Data& pacer)
+  {
+    float frameTime = FrameTime(pacer);
+    if (frameTime > 0.f)
+    {
+      auto duration = std::chrono::duration_cast<Clock::duration>(Seconds(frameTime));
+      WaitUntil(pacer, pacer.frameStart + duration);
+    }
+    auto now = Clock::now();
+    float deltaTime = Seconds(now - pacer.frameStart).count();
+    pacer.frameStart = now;
+    Record(pacer, deltaTime);
+    return deltaTime;
+  }
+
+  void Record(Data& pacer, float frameTime)
+  {
+    pacer.frameTimes[pacer.nextSample] = frameTime;
+    pacer.nextSample = (pacer.nextSample + 1) % NUM_SAMPLES;
+    pacer.numSamples = Math::Min(pacer.numSamples + 1, NUM_SAMPLES);
+  }
+
+  Stats GetStats(const Data& pacer)
+  {
+    Stats stats;
+    stats.numFrames = pacer.numSamples;
+    if (pacer.numSamples == 0)
+    {
+      return stats;
+    }
+    stats.min = FLT_MAX;
+    double sum = 0;
+    for (size_t i = 0; i < pacer.numSamples; ++i)
+    {
+      float frameTime = pacer.frameTimes[i];
+      sum += frameTime;
+      stats.min = Math::Min(stats.min, frameTime);
+      stats.max = Math::Max(stats.max, frameTime);
+    }
+    double average = sum / pacer.numSamples;
+    double variance = 0;
+    for (size_t i = 0; i < pacer.numSamples; ++i)
+    {
+      double difference = pacer.frameTimes[i] - average;
+      variance += difference * difference;
+    }
+    stats.average = (float)average;
+    stats.jitter = (float)std::sqrt(variance / pacer.numSamples);
+    return stats;
+  }
+}
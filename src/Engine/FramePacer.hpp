@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "STDPCH.hpp" // IWYU pragma: keep
+#include "Math_fwd.hpp"
+#include <array>
+
+// Keeps the main loop from running faster than it needs to. Frames wait until the frame time
+// is up by sleeping for most of it and spinning through the rest, sleeping alone wakes up too
+// late to hit the frame time. How late is measured on every sleep, so the spin only covers what
+// the OS actually needs. While the window isn't focused or is minimized frames are held to
+// backgroundFps in every mode.
+namespace Temp::FramePacer
+{
+  enum class Mode : uint8_t
+  {
+    // As fast as possible, only throttled in the background
+    UNLIMITED,
+    // Waits for targetFps
+    TARGET_FPS,
+    // Swapping buffers waits for the display, the renderer turns on the swap interval. Without
+    // swap control it waits for targetFps instead
+    VSYNC,
+  };
+
+  constexpr size_t NUM_SAMPLES = 128;
+
+  // Over the last NUM_SAMPLES frames, in seconds
+  struct Stats
+  {
+    float average{0.f};
+    // Standard deviation of the frame times
+    float jitter{0.f};
+    float min{0.f};
+    float max{0.f};
+    size_t numFrames{0};
+  };
+
+  struct Data
+  {
+    std::chrono::steady_clock::time_point frameStart{std::chrono::steady_clock::now()};
+    std::array<float, NUM_SAMPLES> frameTimes{};
+    size_t numSamples{0};
+    size_t nextSample{0};
+    // How late sleeping wakes up, this much of every wait is spun
+    float sleepError{0.002f};
+    float targetFps{60.f};
+    // Also applies in UNLIMITED and VSYNC mode, 0 doesn't throttle
+    float backgroundFps{10.f};
+    Mode mode{Mode::VSYNC};
+    // Set by the renderer once it knows whether the driver has swap control
+    bool isVsyncSupported{true};
+    bool isFocused{true};
+    bool isMinimized{false};
+  };
+
+  // Seconds a frame should take right now, 0 when frames aren't waited for
+  [[nodiscard]] float FrameTime(const Data& pacer);
+  // 1 when buffer swaps should wait for the display
+  [[nodiscard]] int SwapInterval(const Data& pacer);
+  // Starts timing from now, e.g. after the window got created
+  void Reset(Data& pacer);
+  // Waits out the rest of the frame time and returns the time since the previous frame started
+  float Pace(Data& pacer);
+  // Pace does this for every frame
+  void Record(Data& pacer, float frameTime);
+  [[nodiscard]] Stats GetStats(const Data& pacer);
+}
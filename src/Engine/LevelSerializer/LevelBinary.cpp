@@ -0,0 +1,309 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#include "LevelBinary.hpp"
+#include "EngineUtils.hpp"
+#include "EntityType.hpp"
+#include "Hoverable.hpp"
+#include "Logger.hpp"
+#include "Scene.hpp"
+#include "Sprite.hpp"
+#include "TextBox.hpp"
+#include "TextButton.hpp"
+#ifdef EDITOR
+#include "Shader.hpp"
+#endif
+
+namespace Temp::LevelSerializer::Binary
+{
+  namespace
+  {
+    static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) % 4 == 0);
+    static_assert(std::is_trivially_copyable_v<ObjectRecord> && sizeof(ObjectRecord) % 4 == 0);
+    static_assert(std::is_trivially_copyable_v<TextBoxRecord> && sizeof(TextBoxRecord) % 4 == 0);
+    static_assert(std::is_trivially_copyable_v<TextButtonRecord> && sizeof(TextButtonRecord) % 4 == 0);
+    static_assert(std::is_trivially_copyable_v<SpriteRecord> && sizeof(SpriteRecord) % 4 == 0);
+
+    uint32_t AddString(DynamicArray<char>& strings, const char* string)
+    {
+      uint32_t offset = (uint32_t)strings.size;
+      for (const char* c = string; *c; ++c)
+      {
+        strings.PushBack(*c);
+      }
+      strings.PushBack('\0');
+      return offset;
+    }
+
+    TextBoxRecord ToRecord(DynamicArray<char>& strings,
+                           const TextBox::Data& textBox,
+                           const TextBox::ConstructData& ctorData)
+    {
+      return {AddString(strings, textBox.text.c_str()),
+              ctorData.x,
+              ctorData.y,
+              ctorData.scale,
+              textBox.fontType,
+              textBox.maxCharactersPerLine};
+    }
+
+    void FromRecord(const char* strings,
+                    const TextBoxRecord& record,
+                    TextBox::Data& textBox,
+                    TextBox::ConstructData& ctorData)
+    {
+      textBox.text = strings + record.text;
+      textBox.fontType = record.fontType;
+      textBox.maxCharactersPerLine = record.maxCharactersPerLine;
+      ctorData.x = record.x;
+      ctorData.y = record.y;
+      ctorData.scale = record.scale;
+    }
+
+    template <typename T>
+    bool WriteArray(FILE* fp, const DynamicArray<T>& array)
+    {
+      return array.size == 0 || fwrite(array.buffer, sizeof(T), array.size, fp) == array.size;
+    }
+
+    bool LogInvalid(const char* file)
+    {
+      Logger::LogErr(String("[Binary] Invalid compiled level: ") + file);
+      return false;
+    }
+  }
+
+  bool Write(const Scene::Data& scene, const char* file)
+  {
+    DynamicArray<ObjectRecord> objects(true, Math::Max(scene.objects.size, 8ul));
+    DynamicArray<TextBoxRecord> textBoxes{};
+    DynamicArray<TextButtonRecord> textButtons{};
+    DynamicArray<SpriteRecord> sprites{};
+    DynamicArray<char> strings(true, 4096);
+    // Offset 0 is the empty string
+    strings.PushBack('\0');
+
+    for (const auto& object : scene.objects)
+    {
+      ObjectRecord record{AddString(strings, object.name.c_str()), object.shaderType, object.type};
+#ifdef EDITOR
+      if (record.shaderType >= 0)
+        record.shaderType -= Render::EditorShaderIdx::MAX;
+#endif
+      switch (object.type)
+      {
+        case EntityType::TEXTBOX:
+        {
+          record.index = (uint32_t)textBoxes.size;
+          textBoxes.PushBack(ToRecord(strings,
+                                      *static_cast<const TextBox::Data*>(object.data),
+                                      *static_cast<const TextBox::ConstructData*>(object.constructData)));
+        }
+        break;
+        case EntityType::TEXTBUTTON:
+        {
+          const auto& textButton = *static_cast<const TextButton::Data*>(object.data);
+          const auto& ctorData = *static_cast<const TextButton::ConstructData*>(object.constructData);
+          record.index = (uint32_t)textButtons.size;
+          textButtons.PushBack({ToRecord(strings, textButton.textBox, ctorData.textBoxCtorData),
+                                ctorData.hoverable.x,
+                                ctorData.hoverable.y,
+                                ctorData.hoverable.width,
+                                ctorData.hoverable.height,
+                                ctorData.hoverable.scale.x,
+                                ctorData.hoverable.scale.y});
+        }
+        break;
+        case EntityType::SPRITE:
+        {
+          const auto& sprite = *static_cast<const Sprite::Data*>(object.data);
+          const auto& ctorData = *static_cast<const Sprite::ConstructData*>(object.constructData);
+          record.index = (uint32_t)sprites.size;
+          sprites.PushBack({AddString(strings, sprite.fileName.c_str()),
+                            ctorData.pos.x,
+                            ctorData.pos.y,
+                            ctorData.scale.x,
+                            ctorData.scale.y});
+        }
+        break;
+        default:
+          return false;
+      }
+      objects.PushBack(record);
+    }
+    // Keeps the size of the file a multiple of 4
+    while (strings.size % 4 != 0)
+    {
+      strings.PushBack('\0');
+    }
+
+    Header header;
+    header.numObjects = (uint32_t)objects.size;
+    header.numTextBoxes = (uint32_t)textBoxes.size;
+    header.numTextButtons = (uint32_t)textButtons.size;
+    header.numSprites = (uint32_t)sprites.size;
+    header.stringTableSize = (uint32_t)strings.size;
+
+    // Written next to the file and renamed so a half written file is never loaded
+    auto path = AssetsDirectory() / "Levels" / file;
+    String tempPath = path.buffer + ".tmp";
+    FILE* fp = fopen(tempPath.c_str(), "wb");
+    if (!fp)
+    {
+      Logger::LogErr(String("[Binary] Failed to write file: ") + tempPath.c_str());
+      return false;
+    }
+    bool isWritten = fwrite(&header, sizeof(Header), 1, fp) == 1 && WriteArray(fp, objects) &&
+                     WriteArray(fp, textBoxes) && WriteArray(fp, textButtons) && WriteArray(fp, sprites) &&
+                     WriteArray(fp, strings);
+    isWritten &= fclose(fp) == 0;
+    if (!isWritten || rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+      Logger::LogErr(String("[Binary] Failed to write file: ") + path.c_str());
+      remove(tempPath.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  bool Load(Scene::Data& scene, const char* file)
+  {
+    Scene::ResetAllocatedTypes(scene);
+    auto path = AssetsDirectory() / "Levels" / file;
+    MappedFile mapping;
+    if (!MapFile(mapping, path.c_str()))
+    {
+      UnmapFile(mapping);
+      Logger::LogErr(String("[Binary] Failed to load file: ") + file);
+      return false;
+    }
+
+    Header header;
+    if (mapping.length < sizeof(Header))
+    {
+      UnmapFile(mapping);
+      return LogInvalid(file);
+    }
+    memcpy(&header, mapping.buffer, sizeof(Header));
+    size_t length = sizeof(Header) + header.numObjects * sizeof(ObjectRecord) +
+                    header.numTextBoxes * sizeof(TextBoxRecord) +
+                    header.numTextButtons * sizeof(TextButtonRecord) +
+                    header.numSprites * sizeof(SpriteRecord) + header.stringTableSize;
+    if (header.magic != MAGIC || header.version != VERSION || length != mapping.length ||
+        header.stringTableSize == 0)
+    {
+      UnmapFile(mapping);
+      return LogInvalid(file);
+    }
+
+    const auto* objects = reinterpret_cast<const ObjectRecord*>(mapping.buffer + sizeof(Header));
+    const auto* textBoxes = reinterpret_cast<const TextBoxRecord*>(objects + header.numObjects);
+    const auto* textButtons = reinterpret_cast<const TextButtonRecord*>(textBoxes + header.numTextBoxes);
+    const auto* sprites = reinterpret_cast<const SpriteRecord*>(textButtons + header.numTextButtons);
+    const char* strings = reinterpret_cast<const char*>(sprites + header.numSprites);
+    // Every offset below stringTableSize is then a terminated string
+    if (strings[header.stringTableSize - 1] != '\0')
+    {
+      UnmapFile(mapping);
+      return LogInvalid(file);
+    }
+
+    scene.objects.Reserve(header.numObjects);
+    for (uint32_t i = 0; i < header.numObjects; ++i)
+    {
+      const auto& record = objects[i];
+      SceneObject::Data object;
+      bool isValid = record.name < header.stringTableSize;
+      switch (record.type)
+      {
+        case EntityType::TEXTBOX:
+        {
+          isValid &= record.index < header.numTextBoxes &&
+                     textBoxes[record.index].text < header.stringTableSize;
+          if (!isValid)
+          {
+            break;
+          }
+          auto* textBox = MemoryManager::CreateScene<TextBox::Data>();
+          auto* textBoxCtor = MemoryManager::CreateScene<TextBox::ConstructData>();
+          FromRecord(strings, textBoxes[record.index], *textBox, *textBoxCtor);
+          object.data = textBox;
+          object.constructData = textBoxCtor;
+        }
+        break;
+        case EntityType::TEXTBUTTON:
+        {
+          isValid &= record.index < header.numTextButtons &&
+                     textButtons[record.index].textBox.text < header.stringTableSize;
+          if (!isValid)
+          {
+            break;
+          }
+          const auto& textButtonRecord = textButtons[record.index];
+          auto* textButton = MemoryManager::CreateScene<TextButton::Data>();
+          auto* textButtonCtor = MemoryManager::CreateScene<TextButton::ConstructData>();
+          FromRecord(strings, textButtonRecord.textBox, textButton->textBox, textButtonCtor->textBoxCtorData);
+          auto& hoverable = textButtonCtor->hoverable;
+          hoverable.x = textButtonRecord.hoverableX;
+          hoverable.y = textButtonRecord.hoverableY;
+          hoverable.width = textButtonRecord.hoverableWidth;
+          hoverable.height = textButtonRecord.hoverableHeight;
+          hoverable.scale = {textButtonRecord.hoverableScaleX, textButtonRecord.hoverableScaleY};
+          object.data = textButton;
+          object.constructData = textButtonCtor;
+        }
+        break;
+        case EntityType::SPRITE:
+        {
+          isValid &= record.index < header.numSprites &&
+                     sprites[record.index].fileName < header.stringTableSize;
+          if (!isValid)
+          {
+            break;
+          }
+          const auto& spriteRecord = sprites[record.index];
+          auto* sprite = MemoryManager::CreateScene<Sprite::Data>();
+          auto* spriteCtor = MemoryManager::CreateScene<Sprite::ConstructData>();
+          sprite->fileName = strings + spriteRecord.fileName;
+          spriteCtor->pos = {spriteRecord.x, spriteRecord.y};
+          spriteCtor->scale = {spriteRecord.scaleX, spriteRecord.scaleY};
+          object.data = sprite;
+          object.constructData = spriteCtor;
+        }
+        break;
+        default:
+          isValid = false;
+          break;
+      }
+      if (!isValid)
+      {
+        UnmapFile(mapping);
+        return LogInvalid(file);
+      }
+
+      const char* name = strings + record.name;
+      object.name = name;
+      object.type = record.type;
+      object.shaderType = record.shaderType;
+#ifdef EDITOR
+      if (object.shaderType >= 0)
+        object.shaderType += Render::EditorShaderIdx::MAX;
+#endif
+      scene.objects.PushBack(std::move(object));
+      scene.objectsNameIdxTable[name] = (int)scene.objects.size - 1;
+    }
+    UnmapFile(mapping);
+    return true;
+  }
+
+  bool IsUpToDate(const char* file, const char* source)
+  {
+    auto path = AssetsDirectory() / "Levels" / file;
+    auto sourcePath = AssetsDirectory() / "Levels" / source;
+    if (!path.Exists())
+    {
+      return false;
+    }
+    return !sourcePath.Exists() || path.LastWriteTime() >= sourcePath.LastWriteTime();
+  }
+}
@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "STDPCH.hpp" // IWYU pragma: keep
+
+namespace Temp::Scene
+{
+  struct Data;
+}
+
+// Compiled .blevel files. The .level text stays the editable source, a .blevel holds the same
+// objects as flat records that get mapped into memory and copied into SceneObject::Data without
+// any parsing.
+//
+// Layout, every part is 4 byte aligned:
+//   Header
+//   ObjectRecord[numObjects]          In .level order, index points into the type's records
+//   TextBoxRecord[numTextBoxes]
+//   TextButtonRecord[numTextButtons]
+//   SpriteRecord[numSprites]
+//   char[stringTableSize]             Null terminated strings, records refer to them by offset
+//
+// Whatever a game's ExtensionDeserializer handles can't be compiled, levels using it stay text
+// only.
+namespace Temp::LevelSerializer::Binary
+{
+  // "BLVL"
+  constexpr uint32_t MAGIC = 0x4C564C42;
+  // Bump whenever a record changes
+  constexpr uint32_t VERSION = 1;
+
+  struct Header
+  {
+    uint32_t magic{MAGIC};
+    uint32_t version{VERSION};
+    uint32_t numObjects{0};
+    uint32_t numTextBoxes{0};
+    uint32_t numTextButtons{0};
+    uint32_t numSprites{0};
+    uint32_t stringTableSize{0};
+    uint32_t padding{0};
+  };
+
+  struct ObjectRecord
+  {
+    uint32_t name{0};
+    int32_t shaderType{-1};
+    int32_t type{0};
+    uint32_t index{0};
+
+    constexpr bool operator==(const ObjectRecord&) const = default;
+  };
+
+  struct TextBoxRecord
+  {
+    uint32_t text{0};
+    float x{0};
+    float y{0};
+    float scale{0};
+    int32_t fontType{0};
+    int32_t maxCharactersPerLine{INT_MAX};
+
+    constexpr bool operator==(const TextBoxRecord&) const = default;
+  };
+
+  struct TextButtonRecord
+  {
+    TextBoxRecord textBox{};
+    float hoverableX{0};
+    float hoverableY{0};
+    float hoverableWidth{0};
+    float hoverableHeight{0};
+    float hoverableScaleX{0};
+    float hoverableScaleY{0};
+
+    constexpr bool operator==(const TextButtonRecord&) const = default;
+  };
+
+  struct SpriteRecord
+  {
+    uint32_t fileName{0};
+    float x{0};
+    float y{0};
+    float scaleX{0};
+    float scaleY{0};
+
+    constexpr bool operator==(const SpriteRecord&) const = default;
+  };
+
+  // Writes the objects of a freshly deserialized scene (before Construct) to file. Returns false
+  // without writing when an object can't be compiled.
+  bool Write(const Scene::Data& scene, const char* file);
+  // Replaces the objects of scene like LevelSerializer::Deserialize does
+  bool Load(Scene::Data& scene, const char* file);
+  // file exists and is at least as new as source, when there is a source. Both are relative to
+  // Assets/Levels.
+  [[nodiscard]] bool IsUpToDate(const char* file, const char* source);
+}
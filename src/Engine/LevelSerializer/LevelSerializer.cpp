@@ -4,12 +4,12 @@
 #include "LevelSerializer.hpp"
 #include "EntityType.hpp"
 #include "FileWriter.hpp"
-#include "HashMap.hpp"
 #include "Logger.hpp"
 #include "MemoryManager.hpp"
 #include "Scene.hpp"
 #include "TextBox.hpp"
 #include "TextButton.hpp"
+#include "ThreadPool.hpp"
 
 #include "GameLevelSerializer.hpp"
 
@@ -22,86 +22,307 @@ namespace Temp::LevelSerializer
     /// DESERIALIZATION /////////////////////////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////////////
 
-    void SetObject(SceneObject::Data& object, std::tuple<DeserializeData, bool>& data)
+    constexpr std::pair<std::string_view, int> DeserializeTable[] = {
+      {"TextBox", EntityType::TEXTBOX},
+      {"TextButton", EntityType::TEXTBUTTON},
+      {"Sprite", EntityType::SPRITE},
+      {"Max", EntityType::MAX},
+    };
+
+    // -1 when the line isn't an engine type
+    int FindType(std::string_view line)
+    {
+      for (const auto& [name, type] : DeserializeTable)
+      {
+        if (line == name)
+        {
+          return type;
+        }
+      }
+      return -1;
+    }
+
+    // Fewer blocks than this per job aren't worth a worker
+    constexpr size_t MIN_BLOCKS_PER_JOB = 1024;
+    constexpr size_t MAX_JOBS = 32;
+
+    const char* TypeName(int type)
+    {
+      for (const auto& [name, entityType] : DeserializeTable)
+      {
+        if (entityType == type)
+        {
+          return name.data();
+        }
+      }
+      return "";
+    }
+
+    ParseError ParseBlock(Tokenizer::Data& tokenizer, int type, Block& block)
+    {
+      block = {};
+      block.type = type;
+      return ParseFields(tokenizer, block.fields, &block.textBox, &block.hoverable);
+    }
+
+    void AddBlock(Scene::Data& scene, const Block& block)
     {
-      const auto& dataGet = std::get<0>(data);
-      object.name = dataGet.get<Type::NAME>().c_str();
-      object.shaderType = dataGet.get<Type::SHADER>();
+      const Fields& fields = block.fields;
+      SceneObject::Data object;
+      object.name = SceneString(fields.name.data(), fields.name.size());
+      object.shaderType = fields.shader;
 #ifdef EDITOR
       if (object.shaderType >= 0)
         object.shaderType += Render::EditorShaderIdx::MAX;
 #endif
+      switch (block.type)
+      {
+        case EntityType::TEXTBOX:
+        {
+          auto* textBox = MemoryManager::CreateScene<TextBox::Data>();
+          auto* textBoxCtor = MemoryManager::CreateScene<TextBox::ConstructData>();
+          ToTextBox(fields, *textBox, *textBoxCtor);
+          object.data = textBox;
+          object.constructData = textBoxCtor;
+        }
+        break;
+        case EntityType::TEXTBUTTON:
+        {
+          auto* textButton = MemoryManager::CreateScene<TextButton::Data>();
+          auto* textButtonCtor = MemoryManager::CreateScene<TextButton::ConstructData>();
+          if (fields.IsSet(Type::TEXTBOX))
+          {
+            ToTextBox(block.textBox, textButton->textBox, textButtonCtor->textBoxCtorData);
+          }
+          if (fields.IsSet(Type::HOVERABLE))
+          {
+            textButtonCtor->hoverable = ToHoverable(block.hoverable);
+          }
+          object.data = textButton;
+          object.constructData = textButtonCtor;
+        }
+        break;
+        case EntityType::SPRITE:
+        {
+          auto* sprite = MemoryManager::CreateScene<Sprite::Data>();
+          auto* spriteCtor = MemoryManager::CreateScene<Sprite::ConstructData>();
+          sprite->fileName = SceneString(fields.file.data(), fields.file.size());
+          spriteCtor->pos = fields.position;
+          spriteCtor->scale = fields.scale2D;
+          object.data = sprite;
+          object.constructData = spriteCtor;
+        }
+        break;
+        default:
+          break;
+      }
+      object.type = block.type;
+      scene.objects.PushBack(std::move(object));
+      const auto& name = scene.objects[scene.objects.size - 1].name;
+      scene.objectsNameIdxTable[name.c_str()] = (int)scene.objects.size - 1;
     }
 
-    bool DeserializeSprite(GlobalDeserializeData& data)
+    bool DeserializeSequential(Scene::Data& scene, const char* contents, size_t length, bool* isExtended)
     {
-      auto out = Deserialize(data);
-      if (!std::get<1>(out))
+      Tokenizer::Data tokenizer;
+      Tokenizer::Init(tokenizer, contents, length);
+      GlobalDeserializeData data{scene, tokenizer};
+      Block block;
+      while (Tokenizer::NextContentLine(tokenizer))
       {
-        Logger::LogErr(String("[Deserialize] Invalid Sprite at line ") + String::ToString(data.lineNumber) + ": " +
-                       data.line.c_str());
-        return false;
+        int type = FindType(tokenizer.line);
+        if (type == -1)
+        {
+          if (isExtended)
+          {
+            *isExtended = true;
+          }
+          if (!ExtensionDeserializer(data))
+          {
+            return LogErr("Invalid object name", data);
+          }
+          continue;
+        }
+        if (type == EntityType::MAX)
+        {
+          continue;
+        }
+        ParseError error = ParseBlock(tokenizer, type, block);
+        if (error != ParseError::NONE)
+        {
+          LogParseError(error, data);
+          return LogErr((String("Invalid ") + TypeName(type)).c_str(), data);
+        }
+        AddBlock(scene, block);
       }
-      SceneObject::Data object;
-      auto* sprite = MemoryManager::CreateScene<Sprite::Data>();
-      auto* spriteCtor = MemoryManager::CreateScene<Sprite::ConstructData>();
-      const auto& spriteData = std::get<0>(out);
-      SetObject(object, out);
-      sprite->fileName = spriteData.get<Type::FILE>().c_str();
-      spriteCtor->pos = spriteData.get<Type::POSITION>();
-      spriteCtor->scale = spriteData.get<Type::SCALE2D>();
-      object.constructData = spriteCtor;
-
-      object.data = sprite;
-      AddSceneObject(std::move(object), EntityType::SPRITE, data);
       return true;
     }
 
-    bool DeserializeTextBox(GlobalDeserializeData& data)
+    ///////////////////////////////////////////////////////////////////////////////////////
+    /// PARALLEL DESERIALIZATION //////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////////////////
+
+    struct BlockStart
+    {
+      const char* line{nullptr};
+      int lineNumber{0};
+
+      constexpr bool operator==(const BlockStart&) const = default;
+    };
+
+    struct Job
     {
-      TextBox::Data* textBox;
-      TextBox::ConstructData* ctorTextBox;
-      auto out = Deserialize(data, textBox, ctorTextBox);
-      if (!std::get<1>(out))
+      const char* begin{nullptr};
+      const char* end{nullptr};
+      // Lines before begin
+      int lineNumber{0};
+      DynamicArray<Block> blocks{};
+      bool isParsed{false};
+    };
+
+    // Finds the top level blocks with the same brace rules as ParseFields, without parsing values.
+    // Returns false for levels the sequential path has to handle, extension types or broken braces.
+    bool ScanBlocks(const char* contents, size_t length, DynamicArray<BlockStart>& starts)
+    {
+      Tokenizer::Data tokenizer;
+      Tokenizer::Init(tokenizer, contents, length);
+      int depth = 0;
+      while (true)
       {
-        Logger::LogErr(String("[Deserialize] Invalid TextBox at line ") + String::ToString(data.lineNumber) + ": " +
-                       data.line.c_str());
-        return false;
+        const char* line = tokenizer.cursor;
+        if (!Tokenizer::NextLine(tokenizer))
+        {
+          break;
+        }
+        if (depth == 0)
+        {
+          if (Tokenizer::IsIgnored(tokenizer.line))
+          {
+            continue;
+          }
+          int type = FindType(tokenizer.line);
+          if (type == -1 || type == EntityType::MAX)
+          {
+            return false;
+          }
+          starts.PushBack({line, tokenizer.lineNumber - 1});
+        }
+        else if (tokenizer.line.find('}') != std::string_view::npos)
+        {
+          --depth;
+          continue;
+        }
+        else
+        {
+          std::string_view key;
+          std::string_view value;
+          if (Tokenizer::IsIgnored(tokenizer.line) ||
+              (Tokenizer::Split(tokenizer.line, ": ", key, value) && !value.empty()))
+          {
+            continue;
+          }
+        }
+        // A header, the next line opens its block
+        if (!Tokenizer::NextLine(tokenizer) || tokenizer.line.find('{') == std::string_view::npos)
+        {
+          return false;
+        }
+        ++depth;
       }
+      return depth == 0;
+    }
 
-      SceneObject::Data object;
-      // const auto& textBoxData = std::get<0>(out);
-      SetObject(object, out);
-      object.data = textBox;
-      object.constructData = ctorTextBox;
-      AddSceneObject(std::move(object), EntityType::TEXTBOX, data);
-      return true;
+    // Runs on a worker, only touches the job and the level text
+    void RunJob(void* data)
+    {
+      auto& job = *static_cast<Job*>(data);
+      Tokenizer::Data tokenizer;
+      Tokenizer::Init(tokenizer, job.begin, (size_t)(job.end - job.begin));
+      tokenizer.lineNumber = job.lineNumber;
+      size_t numParsed = 0;
+      while (Tokenizer::NextContentLine(tokenizer))
+      {
+        int type = FindType(tokenizer.line);
+        if (numParsed == job.blocks.size || type == -1 || type == EntityType::MAX ||
+            ParseBlock(tokenizer, type, job.blocks[numParsed]) != ParseError::NONE)
+        {
+          return;
+        }
+        ++numParsed;
+      }
+      job.isParsed = numParsed == job.blocks.size;
     }
 
-    bool DeserializeTextButton(GlobalDeserializeData& data)
+    // Blocks are parsed on the scene's workers into each job's own array, objects are then created
+    // from them here in file order. Returns false without touching scene when the level has to go
+    // through the sequential path instead, which also reports any errors.
+    bool DeserializeParallel(Scene::Data& scene, const char* contents, size_t length)
     {
-      auto out = Deserialize(data);
-      if (!std::get<1>(out))
+      auto& threadPool = Scene::GetThreadPool();
+      if (threadPool.threads.size == 0)
       {
-        Logger::LogErr(String("[Deserialize] Invalid TextButton at line ") + String::ToString(data.lineNumber) + ": " +
-                       data.line.c_str());
         return false;
       }
-      SceneObject::Data object;
-      auto* textButton = MemoryManager::CreateScene<TextButton::Data>();
-      auto* textButtonCtor = MemoryManager::CreateScene<TextButton::ConstructData>();
-      const auto& textButtonData = std::get<0>(out);
-      SetObject(object, out);
-      textButton->textBox = textButtonData.get<Type::TEXTBOX>();
-      textButtonCtor->hoverable = textButtonData.get<Type::HOVERABLE>();
-      textButtonCtor->textBoxCtorData = textButtonData.get<Type::TEXTBOXCTOR>();
-      object.constructData = static_cast<void*>(textButtonCtor);
-
-      object.data = textButton;
-      AddSceneObject(std::move(object), EntityType::TEXTBUTTON, data);
+      DynamicArray<BlockStart> starts(true, 1024);
+      if (!ScanBlocks(contents, length, starts))
+      {
+        return false;
+      }
+      size_t numJobs = Math::Min(Math::Min(threadPool.threads.size + 1, MAX_JOBS), starts.size / MIN_BLOCKS_PER_JOB);
+      if (numJobs <= 1)
+      {
+        return false;
+      }
+
+      size_t stride = (starts.size + numJobs - 1) / numJobs;
+      Job jobs[MAX_JOBS];
+      for (size_t i = 0; i < numJobs; ++i)
+      {
+        size_t begin = Math::Min(i * stride, starts.size);
+        size_t end = Math::Min((i + 1) * stride, starts.size);
+        auto& job = jobs[i];
+        job.begin = begin < starts.size ? starts[begin].line : contents + length;
+        job.end = end < starts.size ? starts[end].line : contents + length;
+        job.lineNumber = begin < starts.size ? starts[begin].lineNumber : 0;
+        job.blocks = DynamicArray<Block>(true, Math::Max(end - begin, 1ul));
+        job.blocks.Resize(end - begin);
+      }
+      for (size_t i = 1; i < numJobs; ++i)
+      {
+        ThreadPool::Enqueue(threadPool, RunJob, &jobs[i]);
+      }
+      RunJob(&jobs[0]);
+      ThreadPool::Wait(threadPool);
+
+      for (size_t i = 0; i < numJobs; ++i)
+      {
+        if (!jobs[i].isParsed)
+        {
+          return false;
+        }
+      }
+      scene.objects.Reserve(starts.size);
+      for (size_t i = 0; i < numJobs; ++i)
+      {
+        for (const auto& block : jobs[i].blocks)
+        {
+          AddBlock(scene, block);
+        }
+      }
       return true;
     }
 
+    bool Deserialize(Scene::Data& scene, const char* contents, size_t length, bool* isExtended)
+    {
+      Scene::ResetAllocatedTypes(scene);
+      if (isExtended)
+      {
+        *isExtended = false;
+      }
+      return DeserializeParallel(scene, contents, length) ||
+             DeserializeSequential(scene, contents, length, isExtended);
+    }
+
     ///////////////////////////////////////////////////////////////////////////////////////
     /// SERIALIZATION /////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////////////////
@@ -191,75 +412,76 @@ namespace Temp::LevelSerializer
     }
   }
 
-  bool Deserialize(Scene::Data& scene, const char* file)
+  bool Deserialize(Scene::Data& scene, const char* file, bool* isExtended)
   {
-    StringHashMap<int> DeserializeTable;
-    DeserializeTable["TextBox"] = EntityType::TEXTBOX;
-    DeserializeTable["TextButton"] = EntityType::TEXTBUTTON;
-    DeserializeTable["Sprite"] = EntityType::SPRITE;
-    DeserializeTable["Max"] = EntityType::MAX;
-
-    int lineNumber = 0;
-    Scene::ResetAllocatedTypes(scene);
     auto path = AssetsDirectory() / "Levels" / file;
-    String contents;
-    String output;
-    if (!ReadFile(contents, path.buffer.c_str(), output))
+    MappedFile mapping;
+    if (!MapFile(mapping, path.c_str()))
     {
+      Scene::ResetAllocatedTypes(scene);
       Logger::LogErr(String("[Deserialize] Failed to deserialize file: ") + file);
       return false;
     }
+    bool isDeserialized = Deserialize(scene, mapping.buffer, mapping.length, isExtended);
+    UnmapFile(mapping);
+    return isDeserialized;
+  }
 
-    char* l = contents.Buffer();
-    String line;
-    line.Resize(4096);
-    GlobalDeserializeData data{scene, l, line, lineNumber};
-    while (GetLine(data.line, data.l, lineNumber))
+  bool Deserialize(Scene::Data& scene, const char* /*file*/, const char* contents, bool* isExtended)
+  {
+    return Deserialize(scene, contents, strlen(contents), isExtended);
+  }
+
+  bool Parse(const char* contents, size_t length, Block*& blocks, size_t& numBlocks)
+  {
+    static_assert(std::is_trivially_copyable_v<Block>, "Blocks are grown with realloc");
+    blocks = nullptr;
+    numBlocks = 0;
+    size_t capacity = 0;
+    Tokenizer::Data tokenizer;
+    Tokenizer::Init(tokenizer, contents, length);
+    while (Tokenizer::NextContentLine(tokenizer))
     {
-      // std::cout << line << std::endl;
-      if (IgnoreLine(data.line))
+      int type = FindType(tokenizer.line);
+      if (type == EntityType::MAX)
       {
         continue;
       }
-      if (DeserializeTable.Find(data.line.c_str()) == SIZE_MAX)
+      if (numBlocks == capacity)
       {
-        if (!ExtensionDeserializer(data))
+        capacity = Math::Max(capacity * 2, 64ul);
+        auto* grown = static_cast<Block*>(realloc(blocks, capacity * sizeof(Block)));
+        if (!grown)
         {
-          Logger::LogErr(String("[Deserialize] Invalid object name at line ") + String::ToString(lineNumber) + ": " + data.line.c_str());
-          return false;
+          type = -1;
         }
         else
         {
-          continue;
+          blocks = grown;
         }
       }
-      switch (DeserializeTable[data.line.c_str()])
+      if (type == -1 || ParseBlock(tokenizer, type, blocks[numBlocks]) != ParseError::NONE)
       {
-        case EntityType::TEXTBOX:
-          if (!DeserializeTextBox(data))
-          {
-            return false;
-          }
-          break;
-        case EntityType::TEXTBUTTON:
-          if (!DeserializeTextButton(data))
-          {
-            return false;
-          }
-          break;
-        case EntityType::SPRITE:
-          if (!DeserializeSprite(data))
-          {
-            return false;
-          }
-          break;
-        default:
-          break;
+        free(blocks);
+        blocks = nullptr;
+        numBlocks = 0;
+        return false;
       }
+      ++numBlocks;
     }
     return true;
   }
 
+  void Deserialize(Scene::Data& scene, const Block* blocks, size_t numBlocks)
+  {
+    Scene::ResetAllocatedTypes(scene);
+    scene.objects.Reserve(numBlocks);
+    for (size_t i = 0; i < numBlocks; ++i)
+    {
+      AddBlock(scene, blocks[i]);
+    }
+  }
+
   void Serialize(Scene::Data& scene, const char* file)
   {
     FileWriter f(file);
@@ -12,6 +12,7 @@
 #include "Scene.hpp"
 #include "String.hpp"
 #include "TextBox.hpp"
+#include "Tokenizer.hpp"
 
 namespace Temp::LevelSerializer
 {
@@ -76,9 +77,8 @@ namespace Temp::LevelSerializer
   struct GlobalDeserializeData
   {
     Scene::Data& scene;
-    char*& l;
-    String& line;
-    int& lineNumber;
+    // tokenizer.line is the line being deserialized
+    Tokenizer::Data& tokenizer;
   };
 
   struct GlobalSerializeData
@@ -87,6 +87,48 @@ namespace Temp::LevelSerializer
     FileWriter& f;
   };
 
+  // Fields of one { } block, strings are views into the level text
+  struct Fields
+  {
+    uint32_t isSet{0};
+    std::string_view name{};
+    std::string_view text{};
+    std::string_view file{};
+    int shader{-1};
+    int font{0};
+    int characterLimit{INT_MAX};
+    float scale{0};
+    float size{0};
+    Math::Vec2f position{};
+    Math::Vec2f scale2D{};
+    Math::Vec2f size2D{};
+
+    constexpr bool IsSet(uint8_t type) const { return isSet & (1u << type); }
+    constexpr void Set(uint8_t type) { isSet |= 1u << type; }
+    bool operator==(const Fields&) const = default;
+  };
+
+  // A top level object together with the blocks nested in it
+  struct Block
+  {
+    Fields fields{};
+    Fields textBox{};
+    Fields hoverable{};
+    int type{EntityType::MAX};
+
+    bool operator==(const Block&) const = default;
+  };
+
+  enum class ParseError
+  {
+    NONE,
+    NO_START_BRACE,
+    NO_END_BRACE,
+    INVALID_DELIMITER,
+    INVALID_POSITION,
+    INVALID_VALUE
+  };
+
   constexpr uint8_t ENUM_MIN = 0;
   constexpr uint8_t ENUM_MAX = Type::MAX - 1;
 
@@ -191,205 +233,310 @@ namespace Temp::LevelSerializer
     data.scene.objectsNameIdxTable[name.c_str()] = (int)data.scene.objects.size - 1;
   }
 
-  inline bool GetLine(String& line, char*& l, int& lnum)
+  inline String ToString(std::string_view view)
   {
-    ++lnum;
-    char* nextline = strchr(l, '\n');
-    size_t length = nextline ? nextline - l : strlen(l);
-    line = String(l, l + length);
-    Trim(line);
-    l = nextline ? nextline + 1 : nullptr;
-    return l;
+    return String(view.data(), view.size());
   }
 
-  inline bool IgnoreLine(const String& line)
+  inline bool LogErr(const char* message, const GlobalDeserializeData& data)
   {
-    return line.starts_with("//") || line == "";
+    Logger::LogErr(String("[Deserialize] ") + message + " at line " + String::ToString(data.tokenizer.lineNumber) +
+                   ": " + ToString(data.tokenizer.line).c_str());
+    return false;
   }
 
   inline bool LogInvalidDelimiter(GlobalDeserializeData& data)
   {
-    Logger::LogErr(String("[Deserialize] Invalid delimiter at line ") + String::ToString(data.lineNumber) +
-                   ": " + data.line.c_str());
-    return false;
+    return LogErr("Invalid delimiter", data);
   }
 
   inline bool LogInvalidPosition(GlobalDeserializeData& data)
   {
-    Logger::LogErr(String("[Deserialize] Invalid position at line ") + String::ToString(data.lineNumber) +
-                   ": " + data.line.c_str());
-    return false;
+    return LogErr("Invalid position", data);
+  }
+
+  inline bool LogInvalidValue(GlobalDeserializeData& data)
+  {
+    return LogErr("Invalid value", data);
   }
 
   inline bool LogNoStartBrace(GlobalDeserializeData& data)
   {
-    Logger::LogErr(String("[Deserialize] No start brace '{' at line ") + String::ToString(data.lineNumber) +
-                   ": " + data.line.c_str());
-    return false;
+    return LogErr("No start brace '{'", data);
   }
 
   inline bool LogNoEndBrace(GlobalDeserializeData& data)
   {
-    Logger::LogErr(String("[Deserialize] No end brace '}' at line ") + String::ToString(data.lineNumber) +
-                   ": " + data.line.c_str());
-    return false;
+    return LogErr("No end brace '}'", data);
   }
 
-  inline std::tuple<DeserializeData, bool> Deserialize(GlobalDeserializeData& data);
+  inline bool LogParseError(ParseError error, GlobalDeserializeData& data)
+  {
+    switch (error)
+    {
+      case ParseError::NO_START_BRACE:
+        return LogNoStartBrace(data);
+      case ParseError::NO_END_BRACE:
+        return LogNoEndBrace(data);
+      case ParseError::INVALID_DELIMITER:
+        return LogInvalidDelimiter(data);
+      case ParseError::INVALID_POSITION:
+        return LogInvalidPosition(data);
+      case ParseError::INVALID_VALUE:
+        return LogInvalidValue(data);
+      case ParseError::NONE:
+      default:
+        return true;
+    }
+  }
 
-  inline std::tuple<DeserializeData, bool> Deserialize(GlobalDeserializeData& data,
-                                                       TextBox::Data*& textBox,
-                                                       TextBox::ConstructData*& textBoxCtor)
+  // Two numbers for 2D or a single one, returns how many were read
+  inline int ParseVec2OrScalar(std::string_view value, float (&out)[2])
   {
-    auto outTB = Deserialize(data);
-    if (!std::get<1>(outTB))
+    if (Tokenizer::ParseAll(value, out, 2))
     {
-      return outTB;
+      return 2;
     }
-    auto textBoxData = std::get<0>(outTB);
-    textBox = MemoryManager::CreateScene<TextBox::Data>();
-    textBoxCtor = MemoryManager::CreateScene<TextBox::ConstructData>();
-    // textBox->name = textBoxData.get<Type::NAME>();
-    textBoxCtor->x = textBoxData.get<Type::POSITION>().x;
-    textBoxCtor->y = textBoxData.get<Type::POSITION>().y;
-    textBoxCtor->scale = textBoxData.get<Type::SCALE>();
-    textBox->text = textBoxData.get<Type::TEXT>().c_str();
-    textBox->fontType = textBoxData.get<Type::FONT>();
-    textBox->maxCharactersPerLine = textBoxData.get<Type::CHARACTERLIMIT>();
-    return outTB;
+    return Tokenizer::Parse(value, out[0]) ? 1 : 0;
   }
 
-  // Make sure to clean up data
-  inline std::tuple<DeserializeData, bool> Deserialize(GlobalDeserializeData& data)
+  // Parses the { } block following a header line. Nothing is allocated or logged so this can run on
+  // any thread, the tokenizer is left on the line that failed. Nested blocks go to textBox and
+  // hoverable, blocks nested deeper are skipped.
+  inline ParseError ParseFields(Tokenizer::Data& tokenizer,
+                                Fields& out,
+                                Fields* textBox = nullptr,
+                                Fields* hoverable = nullptr)
   {
-    DeserializeData out;
-    if (GetLine(data.line, data.l, data.lineNumber) && data.line.find("{") == SIZE_MAX)
+    if (Tokenizer::NextLine(tokenizer) && tokenizer.line.find('{') == std::string_view::npos)
     {
-      return {out, LogNoStartBrace(data)};
+      return ParseError::NO_START_BRACE;
     }
-    while (GetLine(data.line, data.l, data.lineNumber))
+    while (Tokenizer::NextLine(tokenizer))
     {
-      if (data.line.find("}") != SIZE_MAX)
+      std::string_view line = tokenizer.line;
+      if (line.find('}') != std::string_view::npos)
       {
-        return {out, true};
+        return ParseError::NONE;
       }
-      if (IgnoreLine(data.line))
+      if (Tokenizer::IsIgnored(line))
       {
         continue;
       }
-      auto tokens = SplitString(data.line, ": ", 1);
-      if (tokens.size != 2)
+      std::string_view key;
+      std::string_view value;
+      if (!Tokenizer::Split(line, ": ", key, value) || value.empty())
       {
-        if (tokens[0].find(SerializeString<Type::TEXTBOX>()) != SIZE_MAX)
-        {
-          TextBox::Data* textBox;
-          TextBox::ConstructData* textBoxCtor;
-          if (!std::get<1>(Deserialize(data, textBox, textBoxCtor)))
-          {
-            return {out, false};
-          }
-          out.data[Type::TEXTBOX] = static_cast<void*>(textBox);
-          out.data[Type::TEXTBOXCTOR] = static_cast<void*>(textBoxCtor);
-        }
-        else if (tokens[0].find(SerializeString<Type::HOVERABLE>()) != SIZE_MAX)
+        bool isTextBox = line == SerializeString<Type::TEXTBOX>();
+        if (!isTextBox && line != SerializeString<Type::HOVERABLE>())
         {
-          auto outH = Deserialize(data);
-          if (!std::get<1>(outH))
-          {
-            return {out, false};
-          }
-          auto hoverableData = std::get<0>(outH);
-          auto hoverable = MemoryManager::CreateTemp<Component::Hoverable::Data>();
-          hoverable->x = hoverableData.get<Type::POSITION>().x;
-          hoverable->y = hoverableData.get<Type::POSITION>().y;
-          hoverable->width = hoverableData.get<Type::SIZE2D>().x;
-          hoverable->height = hoverableData.get<Type::SIZE2D>().y;
-          if (hoverableData.data[Type::SCALE2D])
-            hoverable->scale = hoverableData.get<Type::SCALE2D>();
-          else
-            hoverable->scale = {hoverableData.get<Type::SCALE>(), hoverableData.get<Type::SCALE>()};
-          // std::cout << hoverable->x << " " << hoverable->y << " " << hoverable->width << " " <<
-          // hoverable->height << std::endl;
-          out.data[Type::HOVERABLE] = static_cast<void*>(hoverable);
+          return ParseError::INVALID_DELIMITER;
         }
-        else
+        Fields skipped;
+        Fields* nested = isTextBox ? textBox : hoverable;
+        ParseError error = ParseFields(tokenizer, nested ? *nested : skipped);
+        if (error != ParseError::NONE)
         {
-          return {out, LogInvalidDelimiter(data)};
+          return error;
         }
+        out.Set(isTextBox ? Type::TEXTBOX : Type::HOVERABLE);
+        continue;
       }
-      else if (tokens[0].find(SerializeString<Type::NAME>()) != SIZE_MAX)
-      {
-        out.data[Type::NAME] = MemoryManager::CreateTemp<String>(std::move(tokens[1]));
-      }
-      else if (tokens[0].find(SerializeString<Type::SHADER>()) != SIZE_MAX)
+
+      float values[2];
+      if (key == SerializeString<Type::NAME>())
       {
-        out.data[Type::SHADER] = MemoryManager::CreateTemp<int>(std::atoi(tokens[1].c_str()));
+        out.name = value;
+        out.Set(Type::NAME);
       }
-      else if (tokens[0].find(SerializeString<Type::POSITION>()) != SIZE_MAX)
+      else if (key == SerializeString<Type::SHADER>())
       {
-        auto position = SplitString(tokens[1], " ");
-        if (position.size != 2)
+        if (!Tokenizer::Parse(value, out.shader))
         {
-          return {out, LogInvalidPosition(data)};
+          return ParseError::INVALID_VALUE;
         }
-        out.data[Type::POSITION] = MemoryManager::CreateTemp<Math::Vec2f>(
-          std::strtof(position[0].c_str(), nullptr),
-          std::strtof(position[1].c_str(), nullptr));
+        out.Set(Type::SHADER);
       }
-      else if (tokens[0].find(SerializeString<Type::SCALE>()) != SIZE_MAX)
+      else if (key == SerializeString<Type::POSITION>())
       {
-        auto trimmed = Trim(tokens[1]);
-        auto scale = SplitString(trimmed, " ");
-        if (scale.size == 2)
-        {
-          out.data[Type::SCALE2D] = MemoryManager::CreateTemp<Math::Vec2f>(
-            std::strtof(scale[0].c_str(), nullptr),
-            std::strtof(scale[1].c_str(), nullptr));
-        }
-        else
+        if (!Tokenizer::ParseAll(value, values, 2))
         {
-          out.data[Type::SCALE] = MemoryManager::CreateTemp<float>(
-            std::strtof(tokens[1].c_str(), nullptr));
+          return ParseError::INVALID_POSITION;
         }
+        out.position = {values[0], values[1]};
+        out.Set(Type::POSITION);
       }
-      else if (tokens[0].find(SerializeString<Type::SIZE>()) != SIZE_MAX)
+      else if (key == SerializeString<Type::SCALE>())
       {
-        auto size = SplitString(Trim(tokens[1]), " ");
-        if (size.size == 2)
+        switch (ParseVec2OrScalar(value, values))
         {
-          out.data[Type::SIZE2D] = MemoryManager::CreateTemp<Math::Vec2f>(
-            std::strtof(size[0].c_str(), nullptr),
-            std::strtof(size[1].c_str(), nullptr));
+          case 2:
+            out.scale2D = {values[0], values[1]};
+            out.Set(Type::SCALE2D);
+            break;
+          case 1:
+            out.scale = values[0];
+            out.Set(Type::SCALE);
+            break;
+          default:
+            return ParseError::INVALID_VALUE;
         }
-        else
+      }
+      else if (key == SerializeString<Type::SIZE>())
+      {
+        switch (ParseVec2OrScalar(value, values))
         {
-          out.data[Type::SIZE] = MemoryManager::CreateTemp<float>(
-            (float)std::atof(tokens[1].c_str()));
+          case 2:
+            out.size2D = {values[0], values[1]};
+            out.Set(Type::SIZE2D);
+            break;
+          case 1:
+            out.size = values[0];
+            out.Set(Type::SIZE);
+            break;
+          default:
+            return ParseError::INVALID_VALUE;
         }
       }
-      else if (tokens[0].find(SerializeString<Type::TEXT>()) != SIZE_MAX)
+      else if (key == SerializeString<Type::TEXT>())
       {
-        out.data[Type::TEXT] = MemoryManager::CreateTemp<String>(std::move(tokens[1]));
+        out.text = value;
+        out.Set(Type::TEXT);
       }
-      else if (tokens[0].find(SerializeString<Type::FONT>()) != SIZE_MAX)
+      else if (key == SerializeString<Type::FONT>())
       {
-        out.data[Type::FONT] = MemoryManager::CreateTemp<int>(std::atoi(tokens[1].c_str()));
+        if (!Tokenizer::Parse(value, out.font))
+        {
+          return ParseError::INVALID_VALUE;
+        }
+        out.Set(Type::FONT);
       }
-      else if (tokens[0].find(SerializeString<Type::CHARACTERLIMIT>()) != SIZE_MAX)
+      else if (key == SerializeString<Type::CHARACTERLIMIT>())
       {
-        out.data[Type::CHARACTERLIMIT] = MemoryManager::CreateTemp<int>(std::atoi(tokens[1].c_str()));
+        if (!Tokenizer::Parse(value, out.characterLimit))
+        {
+          return ParseError::INVALID_VALUE;
+        }
+        out.Set(Type::CHARACTERLIMIT);
       }
-      else if (tokens[0].find(SerializeString<Type::FILE>()) != SIZE_MAX)
+      else if (key == SerializeString<Type::FILE>())
       {
-        out.data[Type::FILE] = MemoryManager::CreateTemp<String>(std::move(tokens[1]));
+        out.file = value;
+        out.Set(Type::FILE);
       }
     }
-    return {out, LogNoEndBrace(data)};
+    return ParseError::NO_END_BRACE;
+  }
+
+  inline void ToTextBox(const Fields& fields, TextBox::Data& textBox, TextBox::ConstructData& textBoxCtor)
+  {
+    textBoxCtor.x = fields.position.x;
+    textBoxCtor.y = fields.position.y;
+    textBoxCtor.scale = fields.scale;
+    textBox.text = SceneString(fields.text.data(), fields.text.size());
+    textBox.fontType = fields.font;
+    textBox.maxCharactersPerLine = fields.characterLimit;
+  }
+
+  inline Component::Hoverable::Data ToHoverable(const Fields& fields)
+  {
+    Component::Hoverable::Data hoverable;
+    hoverable.x = fields.position.x;
+    hoverable.y = fields.position.y;
+    hoverable.width = fields.size2D.x;
+    hoverable.height = fields.size2D.y;
+    hoverable.scale = fields.IsSet(Type::SCALE2D) ? fields.scale2D : Math::Vec2f{fields.scale, fields.scale};
+    return hoverable;
+  }
+
+  // Copies the fields that were set, for extensions written against DeserializeData
+  inline DeserializeData ToDeserializeData(const Block& block)
+  {
+    DeserializeData out;
+    const Fields& fields = block.fields;
+    if (fields.IsSet(Type::NAME))
+      out.data[Type::NAME] = MemoryManager::CreateTemp<String>(ToString(fields.name));
+    if (fields.IsSet(Type::SHADER))
+      out.data[Type::SHADER] = MemoryManager::CreateTemp<int>(fields.shader);
+    if (fields.IsSet(Type::POSITION))
+      out.data[Type::POSITION] = MemoryManager::CreateTemp<Math::Vec2f>(fields.position);
+    if (fields.IsSet(Type::SCALE))
+      out.data[Type::SCALE] = MemoryManager::CreateTemp<float>(fields.scale);
+    if (fields.IsSet(Type::SCALE2D))
+      out.data[Type::SCALE2D] = MemoryManager::CreateTemp<Math::Vec2f>(fields.scale2D);
+    if (fields.IsSet(Type::SIZE))
+      out.data[Type::SIZE] = MemoryManager::CreateTemp<float>(fields.size);
+    if (fields.IsSet(Type::SIZE2D))
+      out.data[Type::SIZE2D] = MemoryManager::CreateTemp<Math::Vec2f>(fields.size2D);
+    if (fields.IsSet(Type::TEXT))
+      out.data[Type::TEXT] = MemoryManager::CreateTemp<String>(ToString(fields.text));
+    if (fields.IsSet(Type::FONT))
+      out.data[Type::FONT] = MemoryManager::CreateTemp<int>(fields.font);
+    if (fields.IsSet(Type::CHARACTERLIMIT))
+      out.data[Type::CHARACTERLIMIT] = MemoryManager::CreateTemp<int>(fields.characterLimit);
+    if (fields.IsSet(Type::FILE))
+      out.data[Type::FILE] = MemoryManager::CreateTemp<String>(ToString(fields.file));
+    if (fields.IsSet(Type::TEXTBOX))
+    {
+      auto* textBox = MemoryManager::CreateScene<TextBox::Data>();
+      auto* textBoxCtor = MemoryManager::CreateScene<TextBox::ConstructData>();
+      ToTextBox(block.textBox, *textBox, *textBoxCtor);
+      out.data[Type::TEXTBOX] = static_cast<void*>(textBox);
+      out.data[Type::TEXTBOXCTOR] = static_cast<void*>(textBoxCtor);
+    }
+    if (fields.IsSet(Type::HOVERABLE))
+      out.data[Type::HOVERABLE] = MemoryManager::CreateTemp<Component::Hoverable::Data>(ToHoverable(block.hoverable));
+    return out;
+  }
+
+  inline std::tuple<DeserializeData, bool> Deserialize(GlobalDeserializeData& data);
+
+  inline std::tuple<DeserializeData, bool> Deserialize(GlobalDeserializeData& data,
+                                                       TextBox::Data*& textBox,
+                                                       TextBox::ConstructData*& textBoxCtor)
+  {
+    auto outTB = Deserialize(data);
+    if (!std::get<1>(outTB))
+    {
+      return outTB;
+    }
+    auto textBoxData = std::get<0>(outTB);
+    textBox = MemoryManager::CreateScene<TextBox::Data>();
+    textBoxCtor = MemoryManager::CreateScene<TextBox::ConstructData>();
+    // textBox->name = textBoxData.get<Type::NAME>();
+    textBoxCtor->x = textBoxData.get<Type::POSITION>().x;
+    textBoxCtor->y = textBoxData.get<Type::POSITION>().y;
+    textBoxCtor->scale = textBoxData.get<Type::SCALE>();
+    textBox->text = textBoxData.get<Type::TEXT>().c_str();
+    textBox->fontType = textBoxData.get<Type::FONT>();
+    textBox->maxCharactersPerLine = textBoxData.get<Type::CHARACTERLIMIT>();
+    return outTB;
+  }
+
+  // Make sure to clean up data
+  inline std::tuple<DeserializeData, bool> Deserialize(GlobalDeserializeData& data)
+  {
+    Block block;
+    ParseError error = ParseFields(data.tokenizer, block.fields, &block.textBox, &block.hoverable);
+    if (error != ParseError::NONE)
+    {
+      return {DeserializeData(), LogParseError(error, data)};
+    }
+    return {ToDeserializeData(block), true};
   }
 
   // Make sure memory that's used for objects is not leaked!
   // Use ExtensionParser for games that have custom types
-  bool Deserialize(Scene::Data& scene, const char* file);
+  // isExtended is set when part of the level went through ExtensionDeserializer
+  bool Deserialize(Scene::Data& scene, const char* file, bool* isExtended = nullptr);
+  // Parses contents of file that were already read, see Scene::Loader
+  bool Deserialize(Scene::Data& scene, const char* file, const char* contents, bool* isExtended = nullptr);
+  // Parses contents without logging or touching any arena, so it can run on any thread. blocks is
+  // malloc'd for the caller to free and points into contents. Returns false for levels that have
+  // to go through Deserialize, extension types or parse errors (which Deserialize reports).
+  [[nodiscard]] bool Parse(const char* contents, size_t length, Block*& blocks, size_t& numBlocks);
+  // Creates the objects of blocks from Parse, like Deserialize does
+  void Deserialize(Scene::Data& scene, const Block* blocks, size_t numBlocks);
   void Serialize(Scene::Data& scene, const char* file);
   bool LevelExists(const char* file);
 }
@@ -294,6 +294,7 @@ namespace Temp
     };
 
     DynamicArray<Pair, Type> buffer;
+    size_t size{0};
     
     constexpr BaseStringHashMap() {}
 
@@ -303,6 +304,7 @@ namespace Temp
     constexpr BaseStringHashMap(const BaseStringHashMap& other) noexcept
     {
       buffer = other.buffer;
+      size = other.size;
     }
 
     // Move constructor
@@ -327,6 +329,7 @@ namespace Temp
     constexpr void Swap(BaseStringHashMap& first, BaseStringHashMap& second)
     {
       first.buffer.Swap(first.buffer, second.buffer);
+      Utils::Swap(first.size, second.size);
     }
 
     const DynamicArray<Pair, Type>& Buffer() const
@@ -427,6 +430,7 @@ namespace Temp
         buffer[pos1].key.Replace(key);
         buffer[pos1].value = value;
         buffer[pos1].hash = 0;
+        ++size;
         recursions = 0;
         return true;
       }
@@ -435,6 +439,7 @@ namespace Temp
         buffer[pos2].key.Replace(key);
         buffer[pos2].value = value;
         buffer[pos2].hash = 1;
+        ++size;
         recursions = 0;
         return true;
       }
@@ -465,6 +470,7 @@ namespace Temp
         buffer[pos1].key.Replace("");
         buffer[pos1].value = {};
         buffer[pos1].hash = UINT8_MAX;
+        --size;
         return;
       }
       size_t pos2 = Hash(1, key);
@@ -473,6 +479,7 @@ namespace Temp
         buffer[pos2].key.Replace("");
         buffer[pos2].value = {};
         buffer[pos2].hash = UINT8_MAX;
+        --size;
         return;
       }
       assert(false);
@@ -489,6 +496,7 @@ namespace Temp
         Buffer()[i].value = {};
         Buffer()[i].hash = UINT8_MAX;
       }
+      size = 0;
     }
     
     size_t Find(const char* key) const
@@ -508,7 +516,7 @@ namespace Temp
         }
       }
       size_t pos2 = Hash(1, key);
-      const char* buffer2 = Buffer()[pos1].key.c_str();
+      const char* buffer2 = Buffer()[pos2].key.c_str();
       if (buffer2)
       {
         if (String(buffer2) == String(key) && buffer[pos2].hash != UINT8_MAX)
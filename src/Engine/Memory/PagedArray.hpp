@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "MemoryManager.hpp"
+
+namespace Temp
+{
+  // Sparse array split into fixed size pages that are only allocated once an index inside
+  // of them is written to. Reading from a page that doesn't exist returns the empty value.
+  // Memory comes from the arena so this must be re-initialized whenever the arena is freed.
+  template <typename T,
+            size_t PageSize,
+            size_t NumPages,
+            MemoryManager::Data::Type Type = MemoryManager::Data::Type::SCENE_ARENA>
+  struct PagedArray
+  {
+    static constexpr size_t PAGE_SIZE = PageSize;
+    static constexpr size_t NUM_PAGES = NumPages;
+
+    T* pages[NumPages]{};
+    T empty{};
+    size_t numPages{0};
+
+    // Drops all pages, does not touch the arena
+    constexpr void Init(T value = {})
+    {
+      for (size_t i = 0; i < NumPages; ++i)
+      {
+        pages[i] = nullptr;
+      }
+      empty = value;
+      numPages = 0;
+    }
+
+    // Keeps the allocated pages around and resets every slot to the empty value
+    constexpr void Fill(T value)
+    {
+      empty = value;
+      for (size_t i = 0; i < NumPages; ++i)
+      {
+        if (!pages[i])
+        {
+          continue;
+        }
+        for (size_t j = 0; j < PageSize; ++j)
+        {
+          pages[i][j] = empty;
+        }
+      }
+    }
+
+    [[nodiscard]] constexpr bool HasPage(size_t index) const
+    {
+      return index < PageSize * NumPages && pages[index / PageSize] != nullptr;
+    }
+
+    [[nodiscard]] constexpr const T& operator[](size_t index) const
+    {
+      if (!HasPage(index))
+      {
+        return empty;
+      }
+      return pages[index / PageSize][index % PageSize];
+    }
+
+    // Allocates the page the index lives in if needed
+    constexpr T& At(size_t index)
+    {
+      assert(index < PageSize * NumPages && "[PagedArray] At: Index out of range!");
+      T*& page = pages[index / PageSize];
+      if (!page)
+      {
+        if constexpr (Type == MemoryManager::Data::Type::THREAD_TEMP)
+        {
+          std::lock_guard<std::mutex> lock(MemoryManager::data.mtx);
+          page = static_cast<T*>(MemoryManager::data.Allocate(Type, PageSize * sizeof(T)));
+        }
+        else
+        {
+          page = static_cast<T*>(MemoryManager::data.Allocate(Type, PageSize * sizeof(T)));
+        }
+        for (size_t i = 0; i < PageSize; ++i)
+        {
+          page[i] = empty;
+        }
+        ++numPages;
+      }
+      return page[index % PageSize];
+    }
+  };
+
+  template <typename T, size_t PageSize, size_t NumPages>
+  using ScenePagedArray = PagedArray<T, PageSize, NumPages, MemoryManager::Data::Type::SCENE_ARENA>;
+}
@@ -50,7 +50,7 @@ namespace Temp
       strncpy(buffer, bufferStart, size);
     }
 
-    constexpr BaseString(char* elements, size_t _size) noexcept
+    constexpr BaseString(const char* elements, size_t _size) noexcept
       : size(_size),
         capacity(Max(size * 2, 8ul))
     {
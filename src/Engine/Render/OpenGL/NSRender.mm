@@ -337,21 +337,17 @@ void MacRunLoop(const char* windowName, int windowX, int windowY)
     ImGui_ImplOpenGL3_Init();
 #endif
     
-    // Disable system vertical sync
-    // Vertical sync should only be handled at the application level
-    // Otherwise it will slow the main loop as well
-    GLint sync = 0;
     CGLContextObj ctx = CGLGetCurrentContext();
-    
-    CGLSetParameter(ctx, kCGLCPSwapInterval, &sync);
+    GLint sync = -1;
     
     while (Temp::Global::IsActive()) {
-      static auto start = std::chrono::high_resolution_clock::now();
-      auto stop = std::chrono::high_resolution_clock::now();
-      float deltaTime = std::chrono::duration<float, std::chrono::seconds::period>(stop - start).count();
-      start = stop;
+      // Vertical sync, waits in the buffer swap so it slows the main loop as well
+      if (Temp::Global::SwapInterval() != sync) {
+        sync = Temp::Global::SwapInterval();
+        CGLSetParameter(ctx, kCGLCPSwapInterval, &sync);
+      }
       
-      RunMainLoop(deltaTime);
+      RunMainLoop(Temp::Global::PaceFrame());
     }
     
 #ifdef EDITOR
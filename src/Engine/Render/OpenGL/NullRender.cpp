@@ -0,0 +1,154 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#include "NullRender.hpp"
+#include "Camera.hpp"
+#include "Event.hpp"
+#include "Scene.hpp"
+#include "gl.h"
+
+namespace Temp::Render::Null
+{
+  namespace
+  {
+    Event::Data EventData{};
+    // Handed out for every generated or created GL object
+    GLuint nextName{1};
+
+    const GLubyte* GLAD_API_PTR GetString(GLenum) { return (const GLubyte*)"3.3.0 Null"; }
+
+    const GLubyte* GLAD_API_PTR GetStringi(GLenum, GLuint) { return (const GLubyte*)""; }
+
+    void GLAD_API_PTR GetIntegerv(GLenum, GLint* data) { *data = 0; }
+
+    // Compile and link status of shaders and programs
+    void GLAD_API_PTR GetStatus(GLuint, GLenum, GLint* params) { *params = GL_TRUE; }
+
+    void GLAD_API_PTR GetBufferParameteriv(GLenum, GLenum, GLint* params) { *params = 0; }
+
+    void GLAD_API_PTR GenNames(GLsizei n, GLuint* names)
+    {
+      for (GLsizei i = 0; i < n; ++i)
+      {
+        names[i] = nextName++;
+      }
+    }
+
+    GLuint GLAD_API_PTR CreateShader(GLenum) { return nextName++; }
+
+    GLuint GLAD_API_PTR CreateProgram() { return nextName++; }
+
+    GLint GLAD_API_PTR GetUniformLocation(GLuint, const GLchar*) { return -1; }
+
+    // Everything without outputs gets a stub with the exact signature glad calls it through
+    template <typename R, typename... Args>
+    R GLAD_API_PTR NoOp(Args...)
+    {
+      return R();
+    }
+
+    template <typename R, typename... Args>
+    GLADapiproc Stub(R(GLAD_API_PTR*)(Args...))
+    {
+      return reinterpret_cast<GLADapiproc>(&NoOp<R, Args...>);
+    }
+
+// Neither argument gets macro expanded, so this names the glad pointer behind the gl* macro
+#define NULL_GL(name) {#name, Stub(glad_##name)}
+
+    struct Function
+    {
+      const char* name;
+      GLADapiproc function;
+    };
+
+    // Has to list every GL function the engine calls, the ones left out stay null
+    GLADapiproc Load(const char* name)
+    {
+      static const Function functions[] = {
+        {"glGetString", reinterpret_cast<GLADapiproc>(GetString)},
+        {"glGetStringi", reinterpret_cast<GLADapiproc>(GetStringi)},
+        {"glGetIntegerv", reinterpret_cast<GLADapiproc>(GetIntegerv)},
+        {"glGetShaderiv", reinterpret_cast<GLADapiproc>(GetStatus)},
+        {"glGetProgramiv", reinterpret_cast<GLADapiproc>(GetStatus)},
+        {"glGetBufferParameteriv", reinterpret_cast<GLADapiproc>(GetBufferParameteriv)},
+        {"glGenBuffers", reinterpret_cast<GLADapiproc>(GenNames)},
+        {"glGenVertexArrays", reinterpret_cast<GLADapiproc>(GenNames)},
+        {"glGenTextures", reinterpret_cast<GLADapiproc>(GenNames)},
+        {"glCreateShader", reinterpret_cast<GLADapiproc>(CreateShader)},
+        {"glCreateProgram", reinterpret_cast<GLADapiproc>(CreateProgram)},
+        {"glGetUniformLocation", reinterpret_cast<GLADapiproc>(GetUniformLocation)},
+        NULL_GL(glActiveTexture),
+        NULL_GL(glAttachShader),
+        NULL_GL(glBindBuffer),
+        NULL_GL(glBindBufferBase),
+        NULL_GL(glBindBufferRange),
+        NULL_GL(glBindTexture),
+        NULL_GL(glBindVertexArray),
+        NULL_GL(glBlendFunc),
+        NULL_GL(glBufferData),
+        NULL_GL(glBufferSubData),
+        NULL_GL(glClear),
+        NULL_GL(glClearColor),
+        NULL_GL(glCompileShader),
+        NULL_GL(glDebugMessageCallback),
+        NULL_GL(glDebugMessageControl),
+        NULL_GL(glDeleteBuffers),
+        NULL_GL(glDeleteProgram),
+        NULL_GL(glDeleteShader),
+        NULL_GL(glDeleteVertexArrays),
+        NULL_GL(glDepthMask),
+        NULL_GL(glDisableVertexAttribArray),
+        NULL_GL(glDrawArrays),
+        NULL_GL(glDrawElements),
+        NULL_GL(glDrawElementsInstanced),
+        NULL_GL(glEnable),
+        NULL_GL(glEnableVertexAttribArray),
+        NULL_GL(glGenerateMipmap),
+        NULL_GL(glGetError),
+        NULL_GL(glGetProgramInfoLog),
+        NULL_GL(glGetShaderInfoLog),
+        NULL_GL(glGetUniformBlockIndex),
+        NULL_GL(glLinkProgram),
+        NULL_GL(glPixelStorei),
+        NULL_GL(glPolygonMode),
+        NULL_GL(glShaderSource),
+        NULL_GL(glTexImage2D),
+        NULL_GL(glTexParameteri),
+        NULL_GL(glTexSubImage2D),
+        NULL_GL(glUniform1f),
+        NULL_GL(glUniform1i),
+        NULL_GL(glUniform3fv),
+        NULL_GL(glUniformBlockBinding),
+        NULL_GL(glUniformMatrix4fv),
+        NULL_GL(glUseProgram),
+        NULL_GL(glVertexAttribDivisor),
+        NULL_GL(glVertexAttribIPointer),
+        NULL_GL(glVertexAttribPointer),
+        NULL_GL(glViewport),
+      };
+      for (const auto& function : functions)
+      {
+        if (strcmp(function.name, name) == 0)
+        {
+          return function.function;
+        }
+      }
+      return nullptr;
+    }
+
+#undef NULL_GL
+  }
+
+  void Initialize(Scene::Data& scene, int windowX, int windowY)
+  {
+    // Reports no extensions, which only makes the extension pointers stay null
+    gladLoadGL(Load);
+    EventData.windowWidth = windowX;
+    EventData.windowHeight = windowY;
+    Event::RenderSetup(EventData);
+    Camera::UpdateCameraAspect(scene, windowX, windowY);
+  }
+
+  void Run(Scene::Data& scene) { Scene::DequeueRender(scene); }
+}
@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+namespace Temp::Scene
+{
+  struct Data;
+}
+
+// Stands in for the platform renderer when the engine runs headless. There's no window, and GL is
+// loaded with functions that do nothing, so shaders, fonts and drawables go through the same
+// construction as always without a GPU. Font metrics are real, textures and buffers are just
+// names. Nothing gets drawn.
+namespace Temp::Render::Null
+{
+  void Initialize(Scene::Data& scene, int windowX, int windowY);
+  // Runs what was queued up with Scene::EnqueueRender
+  void Run(Scene::Data& scene);
+}
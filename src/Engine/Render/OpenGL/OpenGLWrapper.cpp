@@ -68,6 +68,23 @@ namespace Temp::Render::OpenGLWrapper
     }
   }
 
+  void ReserveGLObjects(size_t count)
+  {
+    if (count <= globalReservedVAOs.size)
+    {
+      return;
+    }
+    size_t vaos = count - globalReservedVAOs.size;
+    size_t vaoBegin = globalReservedVAOs.size;
+    globalReservedVAOs.Resize(count);
+    glGenVertexArrays((GLsizei)vaos, globalReservedVAOs.buffer + vaoBegin);
+
+    size_t buffers = Math::Max(count * 2, globalReservedBuffers.size) - globalReservedBuffers.size;
+    size_t bufferBegin = globalReservedBuffers.size;
+    globalReservedBuffers.Resize(bufferBegin + buffers);
+    glGenBuffers((GLsizei)buffers, globalReservedBuffers.buffer + bufferBegin);
+  }
+
   GLuint LoadTextureTGA(const char* texturePath, int imageDataType, GLint filterParam)
   {
     TGA::Header header;
@@ -76,16 +93,25 @@ namespace Temp::Render::OpenGLWrapper
 
   GLuint LoadTextureTGA(const char* texturePath, int imageDataType, TGA::Header& header, GLint filterParam)
   {
-    DynamicArray<uint8_t> data;
-    if (!TGA::Read((AssetsDirectory() / "Images" / texturePath).c_str(), header, data))
+    const char* error = nullptr;
+    uint8_t* pixels = TGA::Read((AssetsDirectory() / "Images" / texturePath).c_str(), header, error);
+    if (!pixels)
     {
+      Logger::LogErr(String("[TGA] ") + error + ": " + texturePath);
       return UINT_MAX;
     }
 
+    GLuint texture = CreateTextureTGA(header, pixels, imageDataType, filterParam);
+    free(pixels);
+    return texture;
+  }
+
+  GLuint CreateTextureTGA(const TGA::Header& header, uint8_t* pixels, int imageDataType, GLint filterParam)
+  {
     return CreateTexture(imageDataType, //
                          header.width,
                          header.height,
-                         data.buffer,
+                         pixels,
                          GL_REPEAT,
                          filterParam,
                          4);
@@ -98,6 +124,16 @@ namespace Temp::Render::OpenGLWrapper
     {
       CleanShader(shader);
     }
+    if (globalReservedVAOs.size > 0)
+    {
+      glDeleteVertexArrays((GLsizei)globalReservedVAOs.size, globalReservedVAOs.buffer);
+      globalReservedVAOs.Clear();
+    }
+    if (globalReservedBuffers.size > 0)
+    {
+      glDeleteBuffers((GLsizei)globalReservedBuffers.size, globalReservedBuffers.buffer);
+      globalReservedBuffers.Clear();
+    }
     for (auto& objects : globalFreeGLObjects)
     {
       for (auto& object : objects)
@@ -41,9 +41,15 @@ namespace Temp::Render::OpenGLWrapper
   inline GlobalDynamicArray<GlobalDynamicArray<const char*>> globalShaders;
   inline GlobalDynamicArray<GLuint> globalShaderPrograms;
   inline GlobalArray<GlobalDynamicArray<GLObjectData>, 1024> globalFreeGLObjects;
+  // Names generated ahead of time by ReserveGLObjects
+  inline GlobalDynamicArray<GLuint> globalReservedVAOs;
+  inline GlobalDynamicArray<GLuint> globalReservedBuffers;
 
   void ClearShaderStrings();
   void LoadShaders();
+  // Generates the names of count VAOs and their VBO and EBO with two calls instead of three per
+  // object. CreateVAO/VBO/EBO use them up before generating any more.
+  void ReserveGLObjects(size_t count);
 
   inline GLuint CreateShader(const char** shaderSource, int shaderType)
   {
@@ -118,18 +124,46 @@ namespace Temp::Render::OpenGLWrapper
     return globalShaderPrograms[shader];
   }
 
-  inline GLuint CreateVAO()
+  inline GLuint GenVertexArray()
   {
     GLuint VAO = UINT_MAX;
-    glGenVertexArrays(1, &VAO);
+    if (globalReservedVAOs.size > 0)
+    {
+      VAO = globalReservedVAOs.back();
+      globalReservedVAOs.PopBack();
+    }
+    else
+    {
+      glGenVertexArrays(1, &VAO);
+    }
+    return VAO;
+  }
+
+  inline GLuint GenBuffer()
+  {
+    GLuint buffer = UINT_MAX;
+    if (globalReservedBuffers.size > 0)
+    {
+      buffer = globalReservedBuffers.back();
+      globalReservedBuffers.PopBack();
+    }
+    else
+    {
+      glGenBuffers(1, &buffer);
+    }
+    return buffer;
+  }
+
+  inline GLuint CreateVAO()
+  {
+    GLuint VAO = GenVertexArray();
     glBindVertexArray(VAO);
     return VAO;
   }
 
   inline GLuint CreateVBO(float* data, size_t arraySize, int BufferDraw = GL_STATIC_DRAW)
   {
-    GLuint VBO = UINT_MAX;
-    glGenBuffers(1, &VBO);
+    GLuint VBO = GenBuffer();
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(float) * arraySize, data, BufferDraw);
     return VBO;
@@ -140,8 +174,7 @@ namespace Temp::Render::OpenGLWrapper
                           size_t arraySize,
                           int BufferDraw = GL_STATIC_DRAW)
   {
-    GLuint VBO = UINT_MAX;
-    glGenBuffers(1, &VBO);
+    GLuint VBO = GenBuffer();
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, typeSize * arraySize, data, BufferDraw);
     return VBO;
@@ -169,8 +202,7 @@ namespace Temp::Render::OpenGLWrapper
   inline GLuint CreateEBO(GLuint* indices, size_t arraySize, int BufferDraw = GL_STATIC_DRAW)
   {
     // Create Element Buffer Object (EBO) and copy index data
-    GLuint EBO = UINT_MAX;
-    glGenBuffers(1, &EBO);
+    GLuint EBO = GenBuffer();
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * arraySize, indices, BufferDraw);
     return EBO;
@@ -301,6 +333,8 @@ namespace Temp::Render::OpenGLWrapper
 
   GLuint LoadTextureTGA(const char* texturePath, int imageDataType, GLint filterParam);
   GLuint LoadTextureTGA(const char* texturePath, int imageDataType, TGA::Header& header, GLint filterParam);
+  // Uploads pixels that were already read by TGA::Read
+  GLuint CreateTextureTGA(const TGA::Header& header, uint8_t* pixels, int imageDataType, GLint filterParam);
 
   inline GLuint CreateTexture(int imageDataType,
                               int width,
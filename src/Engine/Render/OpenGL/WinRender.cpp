@@ -38,6 +38,8 @@ namespace Temp::Render
     HGLRC hglrc;
     Scene::Data* winScene{nullptr};
     Event::Data EventData{};
+    // Last one set on the context, -1 until the first frame
+    int swapInterval{-1};
 #ifdef EDITOR
     bool imguiInitialized{false};
 #endif
@@ -144,6 +146,10 @@ namespace Temp::Render
           PostQuitMessage(0);
           Global::Quit();
           break;
+        case WM_ACTIVATE:
+          Global::SetWindowFocused(LOWORD(wParam) != WA_INACTIVE);
+          // Still sets the keyboard focus
+          return DefWindowProc(hWndLocal, message, wParam, lParam);
         case WM_SETCURSOR:
           // Set the cursor to be the arrow cursor (normal)
           SetCursor(LoadCursor(NULL, IDC_ARROW));
@@ -268,6 +274,13 @@ namespace Temp::Render
         }
         case WM_SIZE:
         {
+          // Minimizing resizes the client area to 0 x 0, keep the aspect of the last size
+          Global::SetWindowMinimized(wParam == SIZE_MINIMIZED);
+          if (wParam == SIZE_MINIMIZED)
+          {
+            break;
+          }
+
           auto& windowWidth = EventData.windowWidth;
           auto& windowHeight = EventData.windowHeight;
 
@@ -352,6 +365,7 @@ namespace Temp::Render
       return;
     }
     printf("Loaded WGL %d.%d\n", GLAD_VERSION_MAJOR(wgl_version), GLAD_VERSION_MINOR(wgl_version));
+    Global::SetVsyncSupported(GLAD_WGL_EXT_swap_control);
 
     // Create an OpenGL 3.3 context using WGL extensions
     const int contextAttribs[] = {
@@ -419,12 +433,10 @@ namespace Temp::Render
     EventData.windowWidth = clientRect.right - clientRect.left;
     EventData.windowHeight = clientRect.bottom - clientRect.top;
 
-    // Vertical Sync | Set to 1 to Enable | 0 to disable
     Event::RenderSetup(EventData);
     Camera::UpdateCameraAspect(scene,
                                (float)EventData.windowWidth,
                                (float)EventData.windowHeight);
-    wglSwapIntervalEXT(0);
   }
 
   void Run(Scene::Data& scene)
@@ -445,6 +457,12 @@ namespace Temp::Render
       DispatchMessage(&msg);
     }
 
+    // Vertical Sync | 1 to Enable | 0 to disable
+    if (Global::SwapInterval() != swapInterval && GLAD_WGL_EXT_swap_control)
+    {
+      swapInterval = Global::SwapInterval();
+      wglSwapIntervalEXT(swapInterval);
+    }
     Event::RenderRun(scene, EventData);
 #ifdef EDITOR
     RenderImGui(scene, EventData);
@@ -46,6 +46,8 @@ namespace Temp::Render
     GLXContext context{};
     XVisualInfo* visualInfo{};
     Colormap colormap{};
+    // Last one set on the drawable, -1 until the first frame
+    int swapInterval{-1};
 
     void GLAPIENTRY GLMessageCallback(__attribute__((unused)) GLenum source,
                            __attribute__((unused)) GLenum type,
@@ -64,6 +66,12 @@ namespace Temp::Render
 
     void RenderThread(Scene::Data& scene)
     {
+      // Vertical Sync | 1 to Enable | 0 to disable
+      if (Global::SwapInterval() != swapInterval && GLAD_GLX_EXT_swap_control)
+      {
+        swapInterval = Global::SwapInterval();
+        glXSwapIntervalEXT(display, window, swapInterval);
+      }
       Event::RenderRun(scene, EventData);
 #if defined(EDITOR) || defined(DEBUG)
       RenderImGui(scene, EventData);
@@ -100,6 +108,7 @@ namespace Temp::Render
       printf("Loaded GLX %d.%d\n",
              GLAD_VERSION_MAJOR(glx_version),
              GLAD_VERSION_MINOR(glx_version));
+      Global::SetVsyncSupported(GLAD_GLX_EXT_swap_control);
 
       Window rootWindow = RootWindow(display, screen);
 
@@ -128,7 +137,7 @@ namespace Temp::Render
       windowAttribs.colormap = XCreateColormap(display, rootWindow, visualInfo->visual, AllocNone);
       windowAttribs.event_mask = StructureNotifyMask | ExposureMask | KeyPressMask |
                                  KeyReleaseMask | PointerMotionMask | ButtonPressMask |
-                                 ButtonReleaseMask;
+                                 ButtonReleaseMask | FocusChangeMask;
       colormap = windowAttribs.colormap;
 
       // Create the window
@@ -219,8 +228,6 @@ namespace Temp::Render
     CreateDisplay(windowName, windowX, windowY);
     // Make the OpenGL context current for the rendering thread
     glXMakeCurrent(display, window, context);
-    // Vertical Sync | Set to 1 to Enable | 0 to disable
-    glXSwapIntervalEXT(display, window, 0);
     Event::RenderSetup(EventData);
     Camera::UpdateCameraAspect(scene, windowX, windowY);
   }
@@ -316,6 +323,23 @@ namespace Temp::Render
           }
         }
         break;
+        case FocusIn:
+        case FocusOut:
+        {
+          // Keyboard grabs move the focus around without the window losing it
+          if (xev.xfocus.mode == NotifyNormal || xev.xfocus.mode == NotifyWhileGrabbed)
+          {
+            Global::SetWindowFocused(xev.type == FocusIn);
+          }
+        }
+        break;
+        // Minimizing unmaps the window
+        case MapNotify:
+        case UnmapNotify:
+        {
+          Global::SetWindowMinimized(xev.type == UnmapNotify);
+        }
+        break;
         case MotionNotify:
         {
           XWindowAttributes windowAttributes;
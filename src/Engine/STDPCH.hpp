@@ -6,6 +6,7 @@
 #ifdef __cplusplus
 #include <algorithm> // IWYU pragma: keep
 #include <atomic>  // IWYU pragma: keep
+#include <bit> // IWYU pragma: keep
 #include <cassert> // IWYU pragma: keep
 #include <cassert> // IWYU pragma: keep
 #include <cerrno> // IWYU pragma: keep
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "STDPCH.hpp"
+#include "Tokenizer.hpp"
 
 namespace Temp::SaveSerializer
 {
@@ -100,47 +101,54 @@ namespace Temp::SaveSerializer
 
   inline bool Load(DataList& dataList)
   {
-    String contents;
-    String output;
-    if (!ReadFile(contents, (ApplicationDirectory() / "Save").c_str(), output))
+    MappedFile file;
+    if (!MapFile(file, (ApplicationDirectory() / "Save").c_str()))
     {
       Logger::LogErr("[[SaveSerializer]] Failed to deserialize file: Save");
       return false;
     }
 
-    char* line = contents.Buffer();
-    while (line)
+    Tokenizer::Data tokenizer;
+    Tokenizer::Init(tokenizer, file.buffer, file.length);
+    bool isLoaded = true;
+    while (isLoaded && Tokenizer::NextContentLine(tokenizer))
     {
-      char* nextline = strchr(line, '\n');
-      size_t length = nextline ? nextline - line : strlen(line);
-      String tempLine(line, line + length);
-      Trim(tempLine).c_str();
-      line = nextline ? nextline + 1 : nullptr;
-      if (tempLine.starts_with("//") || tempLine.empty())
+      // The state is everything up to the last space, strings may hold spaces of their own
+      size_t split = tokenizer.line.find_last_of(' ');
+      int type = Type::MAX;
+      if (split == std::string_view::npos || !Tokenizer::Parse(tokenizer.line.substr(split + 1), type))
       {
-        continue;
+        isLoaded = false;
+        break;
       }
-      auto split = SplitString(tempLine.c_str(), " ");
-      if (split.size < 2)
-      {
-        return false;
-      }
-      auto state = split[0];
+      std::string_view state = Tokenizer::Trim(tokenizer.line.substr(0, split));
       Data data;
-      data.type = static_cast<Type>(atoi(split[1].c_str()));
+      data.type = static_cast<Type>(type);
       switch (data.type)
       {
         case Type::BOOL:
-          data.state = MemoryManager::CreateTemp<bool>((bool)atoi(state.c_str()));
+        {
+          bool value = false;
+          Tokenizer::Parse(state, value);
+          data.state = MemoryManager::CreateTemp<bool>(value);
           break;
+        }
         case Type::FLOAT:
-          data.state = MemoryManager::CreateTemp<float>((float)atof(state.c_str()));
+        {
+          float value = 0.f;
+          Tokenizer::Parse(state, value);
+          data.state = MemoryManager::CreateTemp<float>(value);
           break;
+        }
         case Type::INT:
-          data.state = MemoryManager::CreateTemp<int>(atoi(state.c_str()));
+        {
+          int value = 0;
+          Tokenizer::Parse(state, value);
+          data.state = MemoryManager::CreateTemp<int>(value);
           break;
+        }
         case Type::STRING:
-          data.state = MemoryManager::CreateTemp<String>(state.c_str());
+          data.state = MemoryManager::CreateTemp<String>(String(state.data(), state.size()));
           break;
         case Type::MAX:
         default:
@@ -148,6 +156,7 @@ namespace Temp::SaveSerializer
       }
       dataList.datas.PushBack(data);
     }
-    return true;
+    UnmapFile(file);
+    return isLoaded;
   }
-}
\ No newline at end of file
+}
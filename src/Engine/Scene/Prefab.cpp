@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#include "Prefab.hpp"
+#include "ComponentType.hpp"
+#include "Drawable.hpp"
+#include "EntityData.hpp"
+#include "GameComponentType.hpp"
+#include "MemoryManager.hpp"
+#include "Scene.hpp"
+
+namespace Temp::Prefab
+{
+  namespace
+  {
+    constexpr uint8_t ENUM_MIN = 0;
+    constexpr uint8_t ENUM_MAX = Temp::Component::GameType::MAX - 1;
+
+    template <typename T>
+    void Store(T& stored, const T& component)
+    {
+      stored = component;
+    }
+
+    void Store(Component::Drawable::Data& stored, const Component::Drawable::Data& drawable)
+    {
+      Component::Drawable::Share(stored, drawable);
+    }
+
+    template <typename T>
+    void Append(SceneDynamicArray<T>& array, const T& component)
+    {
+      array.PushBack(component);
+    }
+
+    // Drawables are appended as shallow instances and pointed at their own entity
+    void Append(SceneDynamicArray<Component::Drawable::Data>& array,
+                const Component::Drawable::Data& drawable)
+    {
+      array.PushBack({});
+      Component::Drawable::Share(array.back(), drawable);
+    }
+
+    void SetEntity(Component::Drawable::Data& drawable, Entity::id entity)
+    {
+      drawable.entity = entity;
+    }
+
+    template <typename T>
+    void SetEntity(T&, Entity::id)
+    {
+    }
+
+    template <uint8_t E>
+    void CaptureEnum(Scene::Data& scene, Data& prefab, Entity::id entity)
+    {
+      using T = Component::MapToComponentDataType<E>;
+      if constexpr (std::is_same<T, Component::Null>::value)
+      {
+        return;
+      }
+      else
+      {
+        if (!Test(prefab.bits, E))
+        {
+          return;
+        }
+        T* stored = MemoryManager::CreateScene<T>();
+        Store(*stored, static_cast<const T&>(Scene::Get<E>(scene, entity)));
+        prefab.components[E] = stored;
+      }
+    }
+
+    template <uint8_t E>
+    void InstantiateEnum(Scene::Data& scene,
+                         const Data& prefab,
+                         const Entity::id* entities,
+                         size_t count)
+    {
+      using T = Component::MapToComponentDataType<E>;
+      if constexpr (std::is_same<T, Component::Null>::value)
+      {
+        return;
+      }
+      else
+      {
+        if (!Test(prefab.bits, E))
+        {
+          return;
+        }
+        const T& component = *static_cast<const T*>(prefab.components[E]);
+        if (scene.entityData.storage == Entity::Storage::ARCHETYPE)
+        {
+          for (size_t i = 0; i < count; ++i)
+          {
+            Scene::AddComponent<E>(scene, entities[i], component);
+            SetEntity(Scene::Get<E>(scene, entities[i]), entities[i]);
+          }
+          return;
+        }
+
+        auto& array = Scene::GetComponentArray<E>(scene);
+        size_t begin = array.size;
+        Component::Reserve(array, count);
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+          // Block copy the first row into the rest
+          array.array.PushBack(component);
+          for (size_t i = 1; i < count; ++i)
+          {
+            memcpy(array.array.buffer + begin + i, &component, sizeof(T));
+          }
+          array.array.size = begin + count;
+        }
+        else
+        {
+          for (size_t i = 0; i < count; ++i)
+          {
+            Append(array.array, component);
+          }
+        }
+
+        uint32_t tick = Component::Tick();
+        for (size_t i = 0; i < count; ++i)
+        {
+          Entity::id entity = entities[i];
+          SetEntity(array.array[begin + i], entity);
+          array.sparseIndices.At(entity) = begin + i;
+          array.sparseEntities.PushBack(entity);
+          array.changed.PushBack(tick);
+          array.added.PushBack(tick);
+        }
+        array.size = begin + count;
+      }
+    }
+
+    template <uint8_t E, uint8_t ENUM_MAX>
+    struct EnumRange
+    {
+      static void CaptureEnums(Scene::Data& scene, Data& prefab, Entity::id entity)
+      {
+        CaptureEnum<E>(scene, prefab, entity);
+        if constexpr (E < ENUM_MAX)
+          EnumRange<E + 1, ENUM_MAX>::CaptureEnums(scene, prefab, entity);
+      }
+
+      static void InstantiateEnums(Scene::Data& scene,
+                                   const Data& prefab,
+                                   const Entity::id* entities,
+                                   size_t count)
+      {
+        InstantiateEnum<E>(scene, prefab, entities, count);
+        if constexpr (E < ENUM_MAX)
+          EnumRange<E + 1, ENUM_MAX>::InstantiateEnums(scene, prefab, entities, count);
+      }
+    };
+  }
+
+  Data Capture(Scene::Data& scene, Entity::id entity)
+  {
+    Data prefab{};
+    prefab.bits = Scene::ComponentBits(scene, entity);
+    EnumRange<ENUM_MIN, ENUM_MAX>::CaptureEnums(scene, prefab, entity);
+    return prefab;
+  }
+
+  void Instantiate(Scene::Data& scene, const Data& prefab, Entity::id* entities, size_t count)
+  {
+    Entity::Reserve(scene.entityData, count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      entities[i] = Scene::CreateEntity(scene);
+      if (scene.entityData.storage != Entity::Storage::ARCHETYPE)
+      {
+        Scene::ComponentBits(scene, entities[i]) = prefab.bits;
+      }
+    }
+    EnumRange<ENUM_MIN, ENUM_MAX>::InstantiateEnums(scene, prefab, entities, count);
+  }
+
+  Entity::id Instantiate(Scene::Data& scene, const Data& prefab)
+  {
+    Entity::id entity;
+    Instantiate(scene, prefab, &entity, 1);
+    return entity;
+  }
+}
@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Component.hpp"
+#include "ComponentContainer.hpp"
+#include "Entity.hpp"
+
+namespace Temp::Scene
+{
+  struct Data;
+}
+
+// A prefab is a set of component values captured once from a template entity.
+// Instantiating appends rows straight into the dense component arrays, trivially copyable
+// components are block copied and drawables share the template's GL objects and vertex data
+// (see Drawable::Share), so spawning thousands of identical sprites doesn't re-run Construct.
+//
+// Instances aren't SceneObjects. The template entity owns the GL objects and has to stay
+// alive (it can be hidden) for as long as its instances exist!
+namespace Temp::Prefab
+{
+  struct Data
+  {
+    ComponentBits bits{0};
+    // Scene arena copies of the captured components | Index = Component::Type
+    void* components[Component::Container::MAX]{};
+  };
+
+  // Lives in the scene arena, capture again after the scene is destructed
+  [[nodiscard]] Data Capture(Scene::Data& scene, Entity::id entity);
+  // Creates count entities, entities needs room for count ids
+  void Instantiate(Scene::Data& scene, const Data& prefab, Entity::id* entities, size_t count);
+  Entity::id Instantiate(Scene::Data& scene, const Data& prefab);
+}
@@ -3,6 +3,7 @@
 
 #include "Scene.hpp"
 #include "Array_fwd.hpp"
+#include "Collision.hpp"
 #include "ComponentType.hpp"
 #include "Drawable.hpp"
 #include "EditorGrid.hpp"
@@ -13,14 +14,22 @@
 #include "HashMap.hpp"
 #include "Hoverable.hpp"
 #ifndef EDITOR
+#include "LevelBinary.hpp"
 #include "LevelSerializer.hpp"
 #endif
 #include "Logger.hpp"
 #include "MemoryManager.hpp"
+#include "OpenGLWrapper.hpp"
+#include "SceneCommands.hpp"
+#include "SceneLoader.hpp"
 #include "SceneObject.hpp"
+#include "SceneSystems.hpp"
+#include "SceneView.hpp"
 #include "Shader.hpp"
 #include "TextBox.hpp"
 #include "ThreadPool.hpp"
+#include "Transform.hpp"
+#include "Tween.hpp"
 #include "Updateable.hpp"
 
 namespace Temp::Scene
@@ -38,27 +47,39 @@ namespace Temp::Scene
     bool isDeserialized = false;
 #endif
 
-    void DequeueRender(Scene::Data& scene)
-    {
-      while (!scene.renderQueue.Empty())
-      {
-        auto& render = scene.renderQueue.Front();
-        render.func(scene, render.data);
-        scene.renderQueue.Pop();
-      }
-    }
+    // Laying out a text is a lot more work than updating a component, so chunks can be smaller
+    // than PARALLEL_MIN_CHUNK
+    constexpr size_t PREPARE_MIN_CHUNK = 32;
 
     void CreateEntity(Scene::Data& scene, int index)
     {
       Entity::id entity = Scene::CreateEntity(scene);
+      while (scene.entityObjectIdxTable.size <= entity)
+      {
+        scene.entityObjectIdxTable.PushBack(INT_MAX);
+      }
       scene.entityObjectIdxTable[entity] = index;
       scene.objects[index].entity = entity;
     }
 
+    // Entities without an object (prefab instances) draw with an empty object
+    SceneObject::Data& DrawObject(Scene::Data& scene, Entity::id entity)
+    {
+      if (entity < scene.entityObjectIdxTable.size && scene.entityObjectIdxTable[entity] != INT_MAX)
+      {
+        return scene.objects[scene.entityObjectIdxTable[entity]];
+      }
+      return dummy;
+    }
+
     void DestroyEntity(Scene::Data& scene, SceneObject::Data& object)
     {
       Temp::Scene::DestroyEntity(scene, object.entity);
-      scene.objectsNameIdxTable[object.name.c_str()] = INT_MAX;
+      // Frees the name for reuse, otherwise every destroyed object keeps a slot in the table
+      if (scene.objectsNameIdxTable.Find(object.name.c_str()) != SIZE_MAX)
+      {
+        scene.objectsNameIdxTable.Remove(object.name.c_str());
+      }
       scene.entityObjectIdxTable[object.entity] = INT_MAX;
     }
   }
@@ -71,17 +92,54 @@ namespace Temp::Scene
     }
 #if not defined(UT)
 #if not defined(EDITOR)
-    isDeserialized = LevelSerializer::Deserialize(scene, (String(scene.sceneFns->name.c_str()) + ".level").c_str());
+    String file = String(scene.sceneFns->name.c_str()) + ".level";
+    String binaryFile = String(scene.sceneFns->name.c_str()) + ".blevel";
+    isDeserialized = false;
+    if (LevelSerializer::Binary::IsUpToDate(binaryFile.c_str(), file.c_str()))
+    {
+      isDeserialized = LevelSerializer::Binary::Load(scene, binaryFile.c_str());
+      if (!isDeserialized)
+      {
+        // Corrupt, truncated or from an older VERSION, the text level is still the source. Drop
+        // whatever got loaded before the failure.
+        Logger::LogErr(String("[Scene] Falling back to ") + file.c_str());
+        Scene::ResetAllocatedTypes(scene);
+      }
+    }
+    if (!isDeserialized)
+    {
+      bool isExtended = false;
+      char* contents = Loader::Wait(GetLoader(), file.c_str());
+      if (contents && Loader::Deserialize(scene, GetLoader()))
+      {
+        isDeserialized = true;
+      }
+      else
+      {
+        isDeserialized = contents ? LevelSerializer::Deserialize(scene, file.c_str(), contents, &isExtended)
+                                  : LevelSerializer::Deserialize(scene, file.c_str(), &isExtended);
+      }
+#ifdef DEBUG
+      // Compiled while the objects are still as deserialized. What the game's ExtensionDeserializer
+      // does can't be compiled.
+      if (isDeserialized && !isExtended)
+      {
+        LevelSerializer::Binary::Write(scene, binaryFile.c_str());
+      }
+#endif
+    }
     if (isDeserialized)
     {
 #else
     EditorGrid::Construct(scene, editorGrid);
 #endif
+      // Components are added serially, the CPU heavy part of construction runs on the workers
       for (size_t i = 0; i < scene.objects.size; ++i)
       {
         CreateEntity(scene, (int)i);
-        SceneObject::Construct(scene, scene.objects[i]);
+        SceneObject::BeginConstruct(scene, scene.objects[i]);
       }
+      PrepareObjects(scene, 0, scene.objects.size);
 #ifndef EDITOR
       scene.sceneFns->ConstructFunc(scene);
     }
@@ -89,6 +147,52 @@ namespace Temp::Scene
 #endif
   }
 
+  void PrepareObjects(Data& scene, size_t begin, size_t end)
+  {
+    size_t count = end > begin ? end - begin : 0;
+    size_t numChunks = Math::Min(threadPool.threads.size + 1, MAX_PARALLEL_CHUNKS);
+    numChunks = Math::Min(numChunks, count / PREPARE_MIN_CHUNK);
+    if (numChunks <= 1)
+    {
+      for (size_t i = begin; i < end; ++i)
+      {
+        SceneObject::Prepare(scene, scene.objects[i]);
+      }
+    }
+    else
+    {
+      struct Chunk
+      {
+        Data* scene{nullptr};
+        size_t begin{0};
+        size_t end{0};
+        size_t index{0};
+      };
+      auto run = [](void* data) {
+        auto* chunk = static_cast<Chunk*>(data);
+        Commands::JobScope scope(chunk->index);
+        for (size_t i = chunk->begin; i < chunk->end; ++i)
+        {
+          SceneObject::Prepare(*chunk->scene, chunk->scene->objects[i]);
+        }
+      };
+
+      Chunk chunks[MAX_PARALLEL_CHUNKS];
+      size_t stride = (count + numChunks - 1) / numChunks;
+      for (size_t i = 0; i < numChunks; ++i)
+      {
+        chunks[i] = {&scene, begin + i * stride, begin + Math::Min((i + 1) * stride, count), i};
+      }
+      for (size_t i = 1; i < numChunks; ++i)
+      {
+        ThreadPool::Enqueue(threadPool, run, &chunks[i]);
+      }
+      run(&chunks[0]);
+      ThreadPool::Wait(threadPool);
+    }
+    Commands::Flush(scene, GetCommands());
+  }
+
   void Destruct(Data& scene)
   {
     for (auto& object : scene.objects)
@@ -102,6 +206,9 @@ namespace Temp::Scene
     scene.objectsNameIdxTable.Clear();
     scene.entityObjectIdxTable.Clear();
     scene.sceneFns->DestructFunc(scene);
+    Commands::Clear(GetCommands());
+    Systems::Clear(scene.systems);
+    Component::Collision::ClearListeners(scene.collisions);
     SceneObject::ClearActiveDataCache();
     MemoryManager::data.FreeAll();
     dummy = {};
@@ -127,46 +234,66 @@ namespace Temp::Scene
 
   void Update(Data& scene, float deltaTime)
   {
+    // Removed events are kept for the previous and current tick
+    Component::AdvanceTick();
+    Component::Container::TrimRemoved(scene.entityData.componentContainer, Component::Tick() - 1);
+
     {
       // DONT SCOPE MEMORY HERE | IT WILL CLASH WITH OTHER THREADS
-      // auto f = [&scene, deltaTime](Component::Updateable::Data& updateable) {
-      //   Component::Updateable::Update(scene, updateable, deltaTime);
-      // };
-      auto& updateableArray = Scene::GetComponentArray<Component::Type::UPDATEABLE>(scene);
-
-      struct TaskData
-      {
-        Component::Updateable::Data* updateable{nullptr};
-        Scene::Data* scene{nullptr};
-        float deltaTime;
-      };
-      DynamicArray<void*> tasks;
-      for (size_t i = 0; i < updateableArray.size; ++i)
-      {
-        tasks.PushBack(MemoryManager::CreateTemp<TaskData>(&updateableArray.array[i], &scene, deltaTime));
-      }
-      auto f = [](void* data) {
-        TaskData* taskData = static_cast<TaskData*>(data);
-        Component::Updateable::Update(*taskData->scene, *taskData->updateable, taskData->deltaTime);
+      auto f = [&scene, deltaTime](Entity::id, Component::Updateable::Data& updateable) {
+        Component::Updateable::Update(scene, updateable, deltaTime);
       };
-      ThreadPool::EnqueueForEach(threadPool, tasks.buffer, f, tasks.size);
-      ThreadPool::Wait(threadPool);
+      ParallelEach(View<Component::Type::UPDATEABLE>(scene), f, 1);
     }
+    Commands::Flush(scene, GetCommands());
+
+    Systems::Run(scene, scene.systems, deltaTime);
+    Commands::Flush(scene, GetCommands());
 
     scene.sceneFns->UpdateFunc(scene, deltaTime);
+    Commands::Flush(scene, GetCommands());
+
+    Component::Tween::Update(scene, scene.tweens, deltaTime);
+    Component::Collision::Update(scene, scene.collisions);
+    Commands::Flush(scene, GetCommands());
+
+    SortGroups(scene);
+    Component::Transform::Update(scene, scene.transforms);
+    Component::Hoverable::UpdateIndex(scene, scene.hoverIndex);
   }
 
   void DrawConstruct(Data& scene)
   {
+    size_t next = 0;
+    DrawConstruct(scene, next, FLT_MAX);
+  }
+
+  bool DrawConstruct(Data& scene, size_t& next, float budget)
+  {
+    auto start = std::chrono::steady_clock::now();
+    if (next == 0)
+    {
+      // One batch of names for the whole scene instead of three glGen calls per object
+      Render::OpenGLWrapper::ReserveGLObjects(scene.objects.size);
 #ifdef EDITOR
-    EditorGrid::DrawConstruct(scene, editorGrid);
+      EditorGrid::DrawConstruct(scene, editorGrid);
 #endif
-    for (auto& object : scene.objects)
+    }
+    while (next < scene.objects.size)
     {
-      SceneObject::DrawConstruct(scene, object);
+      SceneObject::DrawConstruct(scene, scene.objects[next++]);
+      if (std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count() >= budget)
+      {
+        break;
+      }
+    }
+    if (next < scene.objects.size)
+    {
+      return false;
     }
 
     scene.sceneFns->DrawConstructFunc(scene);
+    return true;
   }
 
   void DrawDestruct(Data& scene)
@@ -183,6 +310,10 @@ namespace Temp::Scene
     {
       Component::Drawable::Destruct(drawableArray.array[i]);
     }
+    for (auto& drawable : drawableArray.disabled)
+    {
+      Component::Drawable::Destruct(drawable);
+    }
 
     scene.sceneFns->DrawDestructFunc(scene);
   }
@@ -237,33 +368,65 @@ namespace Temp::Scene
   {
     Entity::Destruct(scene.entityData);
     ThreadPool::Destruct(threadPool);
+    Loader::Destroy(GetLoader());
   }
 
   void ResetAllocatedTypes(Data& scene)
   {
-    scene.objects = SceneDynamicArray<SceneObject::Data>(true, Entity::MAX);
-    scene.objectsNameIdxTable = SceneStringHashMap<int, Entity::MAX>();
-    scene.entityObjectIdxTable = SceneDynamicArray<int>(true, Entity::MAX);
+    scene.objects = SceneDynamicArray<SceneObject::Data>(true, Entity::PAGE_SIZE);
+    scene.objectsNameIdxTable = SceneStringHashMap<int, OBJECT_NAME_TABLE_SIZE>();
+    scene.entityObjectIdxTable = SceneDynamicArray<int>(true, Entity::PAGE_SIZE);
     scene.renderQueue = SceneQueue<RenderData>();
+    Component::Transform::Init(scene.transforms);
+    Component::Hoverable::InitIndex(scene.hoverIndex);
+    Component::Collision::Init(scene.collisions);
+    Component::Tween::Init(scene.tweens);
   }
 
+  ThreadPool::Data& GetThreadPool() { return threadPool; }
+
   Entity::id CreateEntity(Data& scene) { return Entity::Create(scene.entityData); }
 
-  void DestroyEntity(Data& scene, Entity::id entity) { Entity::Destroy(scene.entityData, entity); }
+  void DestroyEntity(Data& scene, Entity::id entity)
+  {
+    // Ids get reused, the next entity shouldn't pick up the tweens of this one
+    Component::Tween::Stop(scene.tweens, entity);
+    Component::Transform::EntityDestroyed(scene, scene.transforms, entity);
+    Entity::Destroy(scene.entityData, entity);
+  }
 
   void EnqueueRender(Data& scene, RenderFunction func, void* data)
   {
     scene.renderQueue.Push({func, data});
   }
 
+  void SortGroups(Data& scene)
+  {
+    Component::Sort(Scene::GetComponentArray<Component::Type::DRAWABLE>(scene),
+                    Component::Drawable::SortKey);
+    Component::Sort(Scene::GetComponentArray<Component::Type::HOVERABLE>(scene),
+                    Component::Hoverable::Depth);
+  }
+
   void Draw(Data& scene)
   {
     // NOTE: Below true only for multi-threaded render code
     // Avoid using the Render Queue for real-time updates to avoid flickering!
     DequeueRender(scene);
+    // Drawn in between the last two ticks, the latest models are put back once drawn
+    bool isInterpolating = scene.transforms.isInterpolated && scene.transforms.alpha < 1.f;
+    if (isInterpolating)
+    {
+      Component::Transform::Interpolate(scene, scene.transforms, scene.transforms.alpha);
+    }
     auto& drawableArray = Scene::GetComponentArray<Component::Type::DRAWABLE>(scene);
     for (size_t i = 0; i < drawableArray.size; ++i)
     {
+      // Not DrawConstructed yet, the scene is still loading
+      if (drawableArray.array[i].shaderProgram == UINT_MAX)
+      {
+        continue;
+      }
 #ifdef EDITOR
       if (drawableArray.array[i].entity == editorGrid.entity)
       {
@@ -278,7 +441,7 @@ namespace Temp::Scene
 #endif
       Component::Drawable::Draw(
         scene,
-        scene.objects[scene.entityObjectIdxTable[drawableArray.array[i].entity]],
+        DrawObject(scene, drawableArray.array[i].entity),
         drawableArray.array[i]);
       // Component::Drawable::DrawUpdate(
       //   scene,
@@ -295,17 +458,32 @@ namespace Temp::Scene
         hoverableArray.array[i].drawable, GL_LINE);
     }
 #endif
+    if (isInterpolating)
+    {
+      Component::Transform::Interpolate(scene, scene.transforms, 1.f);
+    }
     Temp::Camera::UpdateOrthoScale(scene, (720.f / Temp::Camera::GetHeight()));
     Temp::Camera::UpdateFontOrthoScale(scene, (720.f / Temp::Camera::GetHeight()));
   }
 
+  void DequeueRender(Data& scene)
+  {
+    while (!scene.renderQueue.Empty())
+    {
+      auto& render = scene.renderQueue.Front();
+      render.func(scene, render.data);
+      scene.renderQueue.Pop();
+    }
+  }
+
   void ClearRender(Data& scene) { scene.renderQueue.Clear(); }
 
   SceneObject::Data& GetObject(Scene::Data& scene, const char* name)
   {
-    if (scene.objectsNameIdxTable[name] != INT_MAX)
+    size_t pos = scene.objectsNameIdxTable.Find(name);
+    if (pos != SIZE_MAX)
     {
-      return scene.objects[scene.objectsNameIdxTable[name]];
+      return scene.objects[scene.objectsNameIdxTable.buffer[pos].value];
     }
     Logger::LogErr("Accessing invalid object by name!");
     return dummy;
@@ -313,9 +491,10 @@ namespace Temp::Scene
 
   const SceneObject::Data& GetObject(const Scene::Data& scene, const char* name)
   {
-    if (scene.objectsNameIdxTable[name] != INT_MAX)
+    size_t pos = scene.objectsNameIdxTable.Find(name);
+    if (pos != SIZE_MAX)
     {
-      return scene.objects[scene.objectsNameIdxTable[name]];
+      return scene.objects[scene.objectsNameIdxTable.buffer[pos].value];
     }
     Logger::LogErr("Accessing invalid object by name!");
     return dummy;
@@ -323,7 +502,7 @@ namespace Temp::Scene
 
   SceneObject::Data& GetObject(Scene::Data& scene, Entity::id entity)
   {
-    if (scene.entityObjectIdxTable[entity] != INT_MAX)
+    if (entity < scene.entityObjectIdxTable.size && scene.entityObjectIdxTable[entity] != INT_MAX)
     {
       return scene.objects[scene.entityObjectIdxTable[entity]];
     }
@@ -333,7 +512,7 @@ namespace Temp::Scene
 
   const SceneObject::Data& GetObject(const Scene::Data& scene, Entity::id entity)
   {
-    if (scene.entityObjectIdxTable[entity] != INT_MAX)
+    if (entity < scene.entityObjectIdxTable.size && scene.entityObjectIdxTable[entity] != INT_MAX)
     {
       return scene.objects[scene.entityObjectIdxTable[entity]];
     }
@@ -343,50 +522,125 @@ namespace Temp::Scene
 
   void SpawnObject(Scene::Data& scene, const SceneObject::Data& object)
   {
-    int index = AddObject(scene, object);
-    CreateEntity(scene, index);
-    SceneObject::Construct(scene, scene.objects[index]);
-    SceneObject::DrawConstruct(scene, scene.objects[index]);
+    SpawnObjects(scene, &object, 1);
+  }
+
+  void SpawnObjects(Scene::Data& scene, const SceneObject::Data* objects, size_t count)
+  {
+    if (count == 0)
+    {
+      return;
+    }
+    size_t begin = scene.objects.size;
+    scene.objects.Reserve(begin + count);
+    Entity::Reserve(scene.entityData, count);
+
+    // A wave of spawns usually shares one name, so keep counting from the last suffix instead
+    // of probing every suffix from 0 again
+    int suffix = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (i == 0 || objects[i].name != objects[i - 1].name)
+      {
+        suffix = 0;
+      }
+      int index = AddObject(scene, objects[i], suffix);
+      CreateEntity(scene, index);
+    }
+
+    // All CPU side construction first, then the GL resources back to back. A wave usually repeats
+    // one type, once the first of a run added its components they're reserved for the whole run.
+    for (size_t i = begin; i < scene.objects.size; ++i)
+    {
+      auto& object = scene.objects[i];
+      SceneObject::BeginConstruct(scene, object);
+      if ((i > begin && object.type == scene.objects[i - 1].type) ||
+          scene.entityData.storage == Entity::Storage::ARCHETYPE)
+      {
+        continue;
+      }
+      size_t run = 1;
+      while (i + run < scene.objects.size && scene.objects[i + run].type == object.type)
+      {
+        ++run;
+      }
+      if (run > 1)
+      {
+        Component::Container::Reserve(scene.entityData.componentContainer,
+                                      Scene::ComponentBits(scene, object.entity),
+                                      run - 1);
+      }
+    }
+    PrepareObjects(scene, begin, scene.objects.size);
+    for (size_t i = begin; i < scene.objects.size; ++i)
+    {
+      SceneObject::DrawConstruct(scene, scene.objects[i]);
+    }
   }
 
   int AddObject(Scene::Data& scene, const SceneObject::Data& object)
+  {
+    int suffix = 0;
+    return AddObject(scene, object, suffix);
+  }
+
+  int AddObject(Scene::Data& scene, const SceneObject::Data& object, int& suffix)
   {
     auto copy = object;
 
-    int count = 0;
     // Want to make sure all names are unique
     while (!ValidateObjectName(scene, copy.name.c_str()))
     {
-      copy.name = (String(object.name.c_str()) + String::ToString(count++)).c_str();
+      copy.name = (String(object.name.c_str()) + String::ToString(suffix++)).c_str();
     }
 
     scene.objects.PushBack(copy);
+    if (scene.objectsNameIdxTable.size >= MAX_NAMED_OBJECTS)
+    {
+      // Still added, it just can't be looked up by name
+      Logger::LogErr(String("[Scene] AddObject: Name table is full, ") + copy.name.c_str() +
+                     " can't be found by name");
+      assert(false && "Raise OBJECT_NAME_TABLE_SIZE");
+      return (int)scene.objects.size - 1;
+    }
     scene.objectsNameIdxTable[copy.name.c_str()] = static_cast<int>(scene.objects.size - 1);
     return (int)scene.objects.size - 1;
   }
 
   void RemoveObject(Scene::Data& scene, Entity::id entity)
   {
-    size_t i = 0;
-    for (auto it = scene.objects.begin(); it != scene.objects.end(); ++it, ++i)
+    RemoveObjects(scene, &entity, 1);
+  }
+
+  void RemoveObjects(Scene::Data& scene, const Entity::id* entities, size_t count)
+  {
+    for (size_t j = 0; j < count; ++j)
     {
-      if (it->entity == entity)
+      Entity::id entity = entities[j];
+      if (entity >= scene.entityObjectIdxTable.size ||
+          scene.entityObjectIdxTable[entity] == INT_MAX)
       {
-        SceneObject::DrawDestruct(scene, *it);
-        SceneObject::Destruct(scene, *it);
-        DestroyEntity(scene, *it);
-        if (i == scene.objects.size - 1)
-        {
-          scene.objects.PopBack();
-        }
-        else
+        continue;
+      }
+      size_t i = (size_t)scene.entityObjectIdxTable[entity];
+      auto& object = scene.objects[i];
+      SceneObject::DrawDestruct(scene, object);
+      SceneObject::Destruct(scene, object);
+      DestroyEntity(scene, object);
+      if (i == scene.objects.size - 1)
+      {
+        scene.objects.PopBack();
+      }
+      else
+      {
+        scene.objects[i] = std::move(scene.objects.back());
+        scene.objects.PopBack();
+        scene.entityObjectIdxTable[scene.objects[i].entity] = (int)i;
+        size_t pos = scene.objectsNameIdxTable.Find(scene.objects[i].name.c_str());
+        if (pos != SIZE_MAX)
         {
-          scene.objects[i] = std::move(scene.objects.back());
-          scene.objects.PopBack();
-          scene.entityObjectIdxTable[scene.objects[i].entity] = (int)i;
-          scene.objectsNameIdxTable[scene.objects[i].name.c_str()] = (int)i;
+          scene.objectsNameIdxTable.buffer[pos].value = (int)i;
         }
-        return;
       }
     }
   }
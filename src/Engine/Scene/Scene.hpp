@@ -8,8 +8,12 @@
 #include "Entity.hpp"
 #include "EntityData.hpp"
 #include "SceneObject.hpp"
+#include "SceneSystems.hpp"
 #include "String.hpp"
 #include "HashMap.hpp"
+#include "Collision.hpp"
+#include "Transform.hpp"
+#include "Tween.hpp"
 
 namespace Temp::SceneObject
 {
@@ -22,6 +26,16 @@ namespace Temp::LevelSerializer
   struct GlobalDeserializeData;
 }
 
+namespace Temp::ThreadPool
+{
+  struct Data;
+}
+
+namespace Temp::Scene::Commands
+{
+  struct Data;
+}
+
 namespace Temp::Scene
 {
   enum class State : uint8_t
@@ -29,22 +43,39 @@ namespace Temp::Scene
     ENTER = 0,
     RUN = 1,
     LEAVE = 2,
-    MAX = 3
+    // Constructed, DrawConstruct is spread over frames
+    LOAD = 3,
+    MAX = 4
   };
 
+  // Object names need to be unique so the name table bounds how many spawned objects can be
+  // found by name. Neither objects nor entities are limited by this.
+  constexpr size_t OBJECT_NAME_TABLE_SIZE = Entity::PAGE_SIZE * 16;
+  // The name table is a cuckoo hash, inserts start failing once it's about half full
+  constexpr size_t MAX_NAMED_OBJECTS = OBJECT_NAME_TABLE_SIZE / 2;
+
   inline void NoOpScene(struct Data&) {}
 
   void Construct(Data& scene, bool resetData = true);
+  // Runs SceneObject::Prepare for objects [begin, end) on the thread pool, then flushes the
+  // commands they recorded. They all have to be constructed already.
+  void PrepareObjects(Data& scene, size_t begin, size_t end);
   void Update(Data& scene, float deltaTime);
   // Only here for Performance Testing!
   void UpdateLegacy(Data& scene, float deltaTime);
   void Destruct(Data& scene);
   void DrawConstruct(Data& scene);
+  // DrawConstructs objects from next on until budget (seconds) runs out, next is left at the
+  // first object that's still to do. Returns true once DrawConstructFunc ran.
+  bool DrawConstruct(Data& scene, size_t& next, float budget);
   void DrawDestruct(Data& scene);
   void DrawUpdate(Data& scene);
   void DrawReload(Data& scene, int shaderIdx);
 
   void Draw(Data& scene);
+  // Keeps drawables ordered by Drawable::SortKey and hoverables by Hoverable::Depth.
+  // Called from Update, dense indices of both arrays aren't stable across it!
+  void SortGroups(Data& scene);
 
   typedef void (*RenderFunction)(Data&, void*);
 
@@ -75,14 +106,20 @@ namespace Temp::Scene
   {
     //////////////////////////////////////////////////////////////////////////
     /// All allocated types must be reset in ResetAllocatedTypes function! ///
+    ///    New members also have to be copied in SceneSnapshot.cpp!        ///
     //////////////////////////////////////////////////////////////////////////
     SceneDynamicArray<SceneObject::Data> objects{};
-    SceneStringHashMap<int, Entity::MAX> objectsNameIdxTable{};
+    SceneStringHashMap<int, OBJECT_NAME_TABLE_SIZE> objectsNameIdxTable{};
     SceneDynamicArray<int> entityObjectIdxTable{};
     SceneQueue<RenderData> renderQueue{};
+    Component::Transform::Data transforms{};
+    Component::Hoverable::IndexData hoverIndex{};
+    Component::Collision::Data collisions{};
+    Component::Tween::Data tweens{};
     //////////////////////////////////////////////////////////////////////////
     //////////////////////////////////////////////////////////////////////////
     Entity::Data entityData{};
+    Systems::Data systems{};
     State state{State::ENTER};
     SceneFns* sceneFns{nullptr};
     void* gameData{nullptr};
@@ -94,7 +131,12 @@ namespace Temp::Scene
         objectsNameIdxTable(other.objectsNameIdxTable),
         entityObjectIdxTable(other.entityObjectIdxTable),
         renderQueue(other.renderQueue),
+        transforms(other.transforms),
+        hoverIndex(other.hoverIndex),
+        collisions(other.collisions),
+        tweens(other.tweens),
         entityData(other.entityData),
+        systems(other.systems),
         state(other.state),
         sceneFns(other.sceneFns),
         gameData(other.gameData)
@@ -119,7 +161,12 @@ namespace Temp::Scene
       Utils::Swap(first.objectsNameIdxTable, second.objectsNameIdxTable);
       Utils::Swap(first.entityObjectIdxTable, second.entityObjectIdxTable);
       Utils::Swap(first.renderQueue, second.renderQueue);
+      Utils::Swap(first.transforms, second.transforms);
+      Utils::Swap(first.hoverIndex, second.hoverIndex);
+      Utils::Swap(first.collisions, second.collisions);
+      Utils::Swap(first.tweens, second.tweens);
       Utils::Swap(first.entityData, second.entityData);
+      Utils::Swap(first.systems, second.systems);
       Utils::Swap(first.state, second.state);
       Utils::Swap(first.sceneFns, second.sceneFns);
       Utils::Swap(first.gameData, second.gameData);
@@ -129,10 +176,15 @@ namespace Temp::Scene
   void Initialize(Data& scene);
   void Destroy(Data& scene);
   void ResetAllocatedTypes(Data& scene);
+  ThreadPool::Data& GetThreadPool();
+  // Deferred structural changes, flushed in Update after the parallel phase and after UpdateFunc
+  Commands::Data& GetCommands();
 
   Entity::id CreateEntity(Data& scene);
   void DestroyEntity(Data& scene, Entity::id entity);
   void EnqueueRender(Scene::Data& scene, RenderFunction func, void* data);
+  // Runs everything queued up with EnqueueRender, Draw does it before drawing
+  void DequeueRender(Scene::Data& scene);
   void ClearRender(Scene::Data& scene);
   SceneObject::Data& GetObject(Scene::Data& scene, const char* name);
   const SceneObject::Data& GetObject(const Scene::Data& scene, const char* name);
@@ -140,8 +192,14 @@ namespace Temp::Scene
   const SceneObject::Data& GetObject(const Scene::Data& scene, Entity::id entity);
   // Use this if spawning in the middle of game session
   void SpawnObject(Scene::Data& scene, const SceneObject::Data& object);
+  // Spawns a whole batch at once. Every object is constructed before any of them is draw
+  // constructed so GL resources get created back to back.
+  void SpawnObjects(Scene::Data& scene, const SceneObject::Data* objects, size_t count);
   int AddObject(Scene::Data& scene, const SceneObject::Data& object);
+  // suffix is where the search for a unique name starts and is left at the next free one
+  int AddObject(Scene::Data& scene, const SceneObject::Data& object, int& suffix);
   void RemoveObject(Scene::Data& scene, Entity::id entity);
+  void RemoveObjects(Scene::Data& scene, const Entity::id* entities, size_t count);
   bool ValidateObjectName(const Scene::Data& scene, const char* name);
   void UpdateObjectName(Scene::Data& scene, SceneObject::Data& object, const char* name);
 
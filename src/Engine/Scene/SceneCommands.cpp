@@ -0,0 +1,230 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#include "SceneCommands.hpp"
+#include "EntityData.hpp"
+#include "LinearAllocator.hpp"
+#include "Logger.hpp"
+#include "Math.hpp"
+
+namespace Temp::Scene
+{
+  namespace
+  {
+    Commands::Data commands{};
+  }
+
+  Commands::Data& GetCommands() { return commands; }
+}
+
+namespace Temp::Scene::Commands
+{
+  namespace
+  {
+    thread_local size_t currentJob{0};
+
+    Entity::id Resolve(const Data& data, Entity::id entity)
+    {
+      if (!IsPending(entity))
+      {
+        return entity;
+      }
+      const Buffer& buffer = data.buffers[(entity & ~PENDING) >> PENDING_INDEX_BITS];
+      return buffer.created[entity & ((1u << PENDING_INDEX_BITS) - 1)];
+    }
+
+    template <typename T>
+    void Push(Storage<T>& storage, T value)
+    {
+      static_assert(std::is_trivially_copyable_v<T>, "Storage is grown with realloc");
+      if (storage.size == storage.capacity)
+      {
+        size_t capacity = Math::Max(storage.capacity * 2, 64ul);
+        auto* grown = static_cast<T*>(realloc(storage.buffer, capacity * sizeof(T)));
+        if (!grown)
+        {
+          Logger::LogErr("[Commands] Out of memory!");
+          assert(false);
+          return;
+        }
+        storage.buffer = grown;
+        storage.capacity = capacity;
+      }
+      storage.buffer[storage.size++] = value;
+    }
+
+    bool IsEmpty(const Buffer& buffer) { return buffer.commands.size == 0 && buffer.created.size == 0; }
+
+    void ClearBuffer(Buffer& buffer)
+    {
+      buffer.commands.size = 0;
+      buffer.created.size = 0;
+      buffer.block = 0;
+      buffer.offset = 0;
+    }
+  }
+
+  size_t CurrentJob() { return currentJob; }
+
+  JobScope::JobScope(size_t job)
+    : previous(currentJob)
+  {
+    currentJob = job;
+  }
+
+  JobScope::~JobScope() { currentJob = previous; }
+
+  Buffer& Local(Data& data, size_t job)
+  {
+    assert(job < MAX_BUFFERS && "[Commands] Job index out of range!");
+    return data.buffers[job];
+  }
+
+  void* Allocate(Buffer& buffer, size_t size, size_t align)
+  {
+    assert(size + align <= BLOCK_SIZE && "[Commands] Component is bigger than a block!");
+    while (true)
+    {
+      if (buffer.block == buffer.blocks.size)
+      {
+        auto* block = static_cast<std::byte*>(malloc(BLOCK_SIZE));
+        assert(block && "[Commands] Out of memory!");
+        Push(buffer.blocks, block);
+        buffer.offset = 0;
+      }
+      auto address = reinterpret_cast<size_t>(buffer.blocks[buffer.block]);
+      size_t aligned = LinearAllocator::AlignForward(address + buffer.offset, align);
+      if (aligned + size <= address + BLOCK_SIZE)
+      {
+        buffer.offset = aligned + size - address;
+        return reinterpret_cast<void*>(aligned);
+      }
+      ++buffer.block;
+      buffer.offset = 0;
+    }
+  }
+
+  void Record(Data& data, Buffer& buffer, Entity::id entity, Type type, ApplyFunction apply, void* payload)
+  {
+    Push(buffer.commands,
+         {entity, (uint32_t)buffer.commands.size, (uint8_t)(&buffer - data.buffers), type, apply, payload});
+  }
+
+  Entity::id CreateEntity(Data& data, size_t job)
+  {
+    Buffer& buffer = Local(data, job);
+    Entity::id index = (Entity::id)buffer.created.size;
+    assert(index < (1u << PENDING_INDEX_BITS) && "[Commands] Too many pending entities!");
+    Push(buffer.created, Entity::MAX);
+    Entity::id entity = PENDING | (Entity::id)(&buffer - data.buffers) << PENDING_INDEX_BITS | index;
+    Record(data, buffer, entity, Type::CREATE, nullptr, nullptr);
+    return entity;
+  }
+
+  void DestroyEntity(Data& data, Entity::id entity, size_t job)
+  {
+    Record(data, Local(data, job), entity, Type::DESTROY, nullptr, nullptr);
+  }
+
+  bool IsEmpty(const Data& data)
+  {
+    for (const auto& buffer : data.buffers)
+    {
+      if (!IsEmpty(buffer))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void Flush(Scene::Data& scene, Data& data)
+  {
+    if (IsEmpty(data))
+    {
+      return;
+    }
+
+    // Pending entities are created first, in job order, so commands can refer to them
+    size_t numCommands = 0;
+    for (size_t i = 0; i < MAX_BUFFERS; ++i)
+    {
+      Buffer& buffer = data.buffers[i];
+      for (auto& created : buffer.created)
+      {
+        created = Scene::CreateEntity(scene);
+      }
+      numCommands += buffer.commands.size;
+    }
+
+    // Sorting by entity keeps replay walking the sparse sets mostly forward.
+    // Commands for the same entity are applied in job order, then in the order they were recorded.
+    auto& sorted = data.sorted;
+    sorted.Clear();
+    sorted.Reserve(numCommands);
+    for (size_t i = 0; i < MAX_BUFFERS; ++i)
+    {
+      for (auto& command : data.buffers[i].commands)
+      {
+        command.entity = Resolve(data, command.entity);
+        sorted.PushBack(command);
+      }
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Command& a, const Command& b) {
+      if (a.entity != b.entity)
+      {
+        return a.entity < b.entity;
+      }
+      if (a.buffer != b.buffer)
+      {
+        return a.buffer < b.buffer;
+      }
+      return a.order < b.order;
+    });
+
+    for (auto& command : sorted)
+    {
+      bool isAlive = Entity::IsAlive(scene.entityData, command.entity);
+      switch (command.type)
+      {
+        case Type::ADD:
+        case Type::REMOVE:
+          if (!isAlive)
+          {
+            Logger::LogErr("[Commands] Flush: Entity is not alive!");
+          }
+          command.apply(isAlive ? &scene : nullptr, command.entity, command.payload);
+          break;
+        case Type::DESTROY:
+          if (isAlive)
+          {
+            Scene::DestroyEntity(scene, command.entity);
+          }
+          break;
+        case Type::CREATE:
+        case Type::MAX:
+          break;
+      }
+    }
+
+    for (auto& buffer : data.buffers)
+    {
+      ClearBuffer(buffer);
+    }
+  }
+
+  void Clear(Data& data)
+  {
+    for (auto& buffer : data.buffers)
+    {
+      for (auto& command : buffer.commands)
+      {
+        if (command.type == Type::ADD)
+        {
+          command.apply(nullptr, command.entity, command.payload);
+        }
+      }
+      ClearBuffer(buffer);
+    }
+  }
+}
@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "STDPCH.hpp" // IWYU pragma: keep
+#include "ComponentType.hpp"
+#include "Entity.hpp"
+#include "Scene.hpp"
+
+// Structural changes (create/destroy entities, add/remove components) aren't thread safe.
+// Code running on the thread pool records them here instead and they get applied at the
+// next sync point with Flush.
+//
+// Commands go into the buffer of the job recording them. Jobs are numbered by whoever splits up
+// the work: Systems::Run uses the system index, ParallelEach and PrepareObjects the chunk index,
+// everything else is job 0. The same work always lands in the same buffer, so Flush creates
+// entities and applies conflicting commands in the same order every run, no matter which thread
+// got to it first. Threads started by the game have to pass their own job.
+//
+//   Entity::id entity = Scene::Commands::CreateEntity(Scene::GetCommands());
+//   Scene::Commands::AddComponent<POSITION2D>(Scene::GetCommands(), entity, {0, 0});
+namespace Temp::Scene::Commands
+{
+  // Upper bound on jobs recording between two flushes, no two threads may use the same job at once
+  constexpr size_t MAX_BUFFERS = 64;
+  constexpr size_t BLOCK_SIZE = 16 * 1024;
+  // Entities created from a buffer don't exist until Flush, until then they are referred to with
+  // PENDING | job << 20 | index
+  constexpr Entity::id PENDING = 1u << 31;
+  constexpr Entity::id PENDING_INDEX_BITS = 20;
+
+  enum Type : uint8_t
+  {
+    CREATE = 0,
+    ADD,
+    REMOVE,
+    DESTROY,
+    MAX
+  };
+
+  // payload == nullptr and scene == nullptr only destructs the payload
+  typedef void (*ApplyFunction)(Scene::Data* scene, Entity::id entity, void* payload);
+
+  struct Command
+  {
+    Entity::id entity{Entity::MAX};
+    // Recording order inside of the buffer
+    uint32_t order{0};
+    uint8_t buffer{0};
+    Type type{Type::MAX};
+    ApplyFunction apply{nullptr};
+    void* payload{nullptr};
+  };
+
+  // Grown with realloc instead of an arena, jobs record at the same time and the global arena has
+  // no lock. Kept around between flushes, T has to be trivially copyable.
+  template <typename T>
+  struct Storage
+  {
+    T* buffer{nullptr};
+    size_t size{0};
+    size_t capacity{0};
+
+    constexpr T& operator[](size_t index) { return buffer[index]; }
+    constexpr const T& operator[](size_t index) const { return buffer[index]; }
+    constexpr T* begin() { return buffer; }
+    constexpr T* end() { return buffer + size; }
+    constexpr const T* begin() const { return buffer; }
+    constexpr const T* end() const { return buffer + size; }
+  };
+
+  // Every buffer owns its memory, so recording never touches memory another job allocates from
+  struct Buffer
+  {
+    Storage<Command> commands{};
+    // Component payloads, BLOCK_SIZE each
+    Storage<std::byte*> blocks{};
+    size_t block{0};
+    size_t offset{0};
+    // Value = Entity::id | Index = Pending index
+    Storage<Entity::id> created{};
+  };
+
+  struct Data
+  {
+    // Index = Job
+    Buffer buffers[MAX_BUFFERS]{};
+    // Commands of every buffer sorted by Flush
+    GlobalDynamicArray<Command> sorted{};
+  };
+
+  // Job the calling thread works on, set with JobScope
+  [[nodiscard]] size_t CurrentJob();
+
+  struct JobScope
+  {
+    size_t previous;
+
+    explicit JobScope(size_t job);
+    ~JobScope();
+  };
+
+  Buffer& Local(Data& data, size_t job);
+  void* Allocate(Buffer& buffer, size_t size, size_t align);
+  void Record(Data& data, Buffer& buffer, Entity::id entity, Type type, ApplyFunction apply, void* payload);
+
+  [[nodiscard]] Entity::id CreateEntity(Data& data, size_t job = CurrentJob());
+  void DestroyEntity(Data& data, Entity::id entity, size_t job = CurrentJob());
+
+  template <uint8_t T>
+  inline void AddComponent(Data& data,
+                           Entity::id entity,
+                           Component::MapToComponentDataType<T> component,
+                           size_t job = CurrentJob())
+  {
+    using C = Component::MapToComponentDataType<T>;
+    Buffer& buffer = Local(data, job);
+    void* payload = new (Allocate(buffer, sizeof(C), alignof(C))) C(std::move(component));
+    Record(data, buffer, entity, Type::ADD, [](Scene::Data* scene, Entity::id entity, void* payload) {
+      C* component = static_cast<C*>(payload);
+      if (scene)
+      {
+        Scene::AddComponent<T>(*scene, entity, std::move(*component));
+      }
+      component->~C();
+    }, payload);
+  }
+
+  template <uint8_t T>
+  inline void RemoveComponent(Data& data, Entity::id entity, size_t job = CurrentJob())
+  {
+    Record(data, Local(data, job), entity, Type::REMOVE, [](Scene::Data* scene, Entity::id entity, void*) {
+      if (scene && Test(Scene::ComponentBits(*scene, entity), T))
+      {
+        Scene::RemoveComponent<T>(*scene, entity);
+      }
+    }, nullptr);
+  }
+
+  [[nodiscard]] inline bool IsPending(Entity::id entity) { return entity & PENDING; }
+
+  [[nodiscard]] bool IsEmpty(const Data& data);
+  // Creates the pending entities in job order, then applies every recorded command sorted by
+  // entity and clears all buffers.
+  // Must only be called while no other thread is recording!
+  void Flush(Scene::Data& scene, Data& data);
+  // Drops every recorded command without applying it
+  void Clear(Data& data);
+}
@@ -0,0 +1,248 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#include "SceneLoader.hpp"
+#include "EngineUtils.hpp"
+#include "LevelSerializer.hpp"
+#include "Logger.hpp"
+#include "Scene.hpp"
+
+namespace Temp::Scene
+{
+  namespace
+  {
+    Loader::Data loader{};
+  }
+
+  Loader::Data& GetLoader() { return loader; }
+}
+
+namespace Temp::Scene::Loader
+{
+  namespace
+  {
+    bool IsDecoded(const Data& loader, std::string_view file)
+    {
+      for (size_t i = 0; i < loader.numTextures; ++i)
+      {
+        if (loader.textures[i].file == file)
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // Runs on the worker after the level got parsed, the images of every sprite are decoded
+    void Decode(Data& loader)
+    {
+      for (size_t i = 0; i < loader.numBlocks; ++i)
+      {
+        const auto& fields = loader.blocks[i].fields;
+        if (loader.blocks[i].type != EntityType::SPRITE || fields.file.empty() ||
+            IsDecoded(loader, fields.file))
+        {
+          continue;
+        }
+        if (!loader.textures)
+        {
+          // At most one texture per block
+          loader.textures = static_cast<Texture*>(malloc(loader.numBlocks * sizeof(Texture)));
+          if (!loader.textures)
+          {
+            return;
+          }
+        }
+        auto& texture = loader.textures[loader.numTextures++];
+        texture = {};
+        texture.file = fields.file;
+        char path[sizeof(loader.imagesPath) + 256];
+        if (snprintf(path, sizeof(path), "%s%.*s", loader.imagesPath, (int)fields.file.size(), fields.file.data()) <
+            (int)sizeof(path))
+        {
+          // Errors get reported by DrawConstruct reading the image itself
+          const char* error = nullptr;
+          texture.pixels = TGA::Read(path, texture.header, error);
+        }
+      }
+    }
+
+    // Runs on the worker, nothing may log or touch an arena here
+    void Read(Data& loader)
+    {
+      FILE* fp = fopen(loader.path, "rb");
+      if (!fp)
+      {
+        loader.status = Status::FAILED;
+        return;
+      }
+      fseek(fp, 0, SEEK_END);
+      size_t length = (size_t)ftell(fp);
+      fseek(fp, 0, SEEK_SET);
+      loader.contents = static_cast<char*>(malloc(length + 1));
+      if (!loader.contents)
+      {
+        fclose(fp);
+        loader.status = Status::FAILED;
+        return;
+      }
+      loader.length = length;
+      size_t bytesRead = 0;
+      while (bytesRead < length)
+      {
+        size_t read = fread(loader.contents + bytesRead, 1, Math::Min(READ_CHUNK_SIZE, length - bytesRead), fp);
+        if (read == 0)
+        {
+          break;
+        }
+        bytesRead += read;
+        loader.bytesRead = bytesRead;
+      }
+      fclose(fp);
+      loader.contents[bytesRead] = '\0';
+      if (bytesRead != length)
+      {
+        loader.status = Status::FAILED;
+        return;
+      }
+      // Levels that can't be parsed here go through LevelSerializer::Deserialize on the main thread
+      if (LevelSerializer::Parse(loader.contents, length, loader.blocks, loader.numBlocks))
+      {
+        Decode(loader);
+      }
+      loader.status = Status::READY;
+    }
+
+    void Join(Data& loader)
+    {
+      if (loader.thread.joinable())
+      {
+        loader.thread.join();
+      }
+    }
+  }
+
+  void Prefetch(Data& loader, const char* file)
+  {
+    Release(loader);
+
+    auto path = AssetsDirectory() / "Levels" / file;
+    auto imagesPath = AssetsDirectory() / "Images" / "";
+    if (strlen(path.c_str()) >= sizeof(loader.path) || strlen(imagesPath.c_str()) >= sizeof(loader.imagesPath))
+    {
+      Logger::LogErr(String("[Loader] Path too long: ") + path.c_str());
+      loader.path[0] = '\0';
+      loader.status = Status::FAILED;
+      return;
+    }
+    strcpy(loader.path, path.c_str());
+    strcpy(loader.imagesPath, imagesPath.c_str());
+    loader.bytesRead = 0;
+    loader.length = 0;
+    loader.nextObject = 0;
+    loader.numObjects = 0;
+    loader.isDrawConstructed = false;
+    loader.status = Status::READING;
+    loader.thread = std::thread(Read, std::ref(loader));
+  }
+
+  char* Wait(Data& loader, const char* file)
+  {
+    Join(loader);
+    auto path = AssetsDirectory() / "Levels" / file;
+    if (strcmp(loader.path, path.c_str()) != 0)
+    {
+      return nullptr;
+    }
+    if (loader.status == Status::FAILED)
+    {
+      Logger::LogErr(String("[Loader] Failed to read file: ") + loader.path);
+      Release(loader);
+      return nullptr;
+    }
+    return loader.status == Status::READY ? loader.contents : nullptr;
+  }
+
+  bool Deserialize(Scene::Data& scene, const Data& loader)
+  {
+    if (loader.status != Status::READY || !loader.blocks)
+    {
+      return false;
+    }
+    LevelSerializer::Deserialize(scene, loader.blocks, loader.numBlocks);
+    return true;
+  }
+
+  uint8_t* FindTexture(const Data& loader, const char* file, TGA::Header& header)
+  {
+    if (loader.status != Status::READY)
+    {
+      return nullptr;
+    }
+    for (size_t i = 0; i < loader.numTextures; ++i)
+    {
+      const auto& texture = loader.textures[i];
+      if (texture.pixels && texture.file == file)
+      {
+        header = texture.header;
+        return texture.pixels;
+      }
+    }
+    return nullptr;
+  }
+
+  void BeginDrawConstruct(Data& loader)
+  {
+    loader.nextObject = 0;
+    loader.numObjects = 0;
+    loader.isDrawConstructed = false;
+  }
+
+  bool DrawConstruct(Scene::Data& scene, Data& loader, float budget)
+  {
+    loader.numObjects = scene.objects.size;
+    loader.isDrawConstructed = Scene::DrawConstruct(scene, loader.nextObject, budget);
+    if (loader.isDrawConstructed && loader.status == Status::READY)
+    {
+      Release(loader);
+    }
+    return loader.isDrawConstructed;
+  }
+
+  float Progress(const Data& loader)
+  {
+    float read = 1.f;
+    if (loader.status == Status::READING)
+    {
+      size_t length = loader.length;
+      read = length > 0 ? (float)loader.bytesRead / (float)length : 0.f;
+    }
+    float draw = 1.f;
+    if (!loader.isDrawConstructed)
+    {
+      draw = loader.numObjects > 0 ? (float)loader.nextObject / (float)loader.numObjects : 0.f;
+    }
+    return READ_SHARE * read + (1.f - READ_SHARE) * draw;
+  }
+
+  void Release(Data& loader)
+  {
+    Join(loader);
+    for (size_t i = 0; i < loader.numTextures; ++i)
+    {
+      free(loader.textures[i].pixels);
+    }
+    free(loader.textures);
+    free(loader.blocks);
+    free(loader.contents);
+    loader.textures = nullptr;
+    loader.numTextures = 0;
+    loader.blocks = nullptr;
+    loader.numBlocks = 0;
+    loader.contents = nullptr;
+    loader.path[0] = '\0';
+    loader.status = Status::IDLE;
+  }
+
+  void Destroy(Data& loader) { Release(loader); }
+}
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "STDPCH.hpp" // IWYU pragma: keep
+#include "TGA.hpp"
+
+namespace Temp::Scene
+{
+  struct Data;
+}
+
+namespace Temp::LevelSerializer
+{
+  struct Block;
+}
+
+// Keeps scene transitions from hitching. The next scene's .level file is read and parsed on a
+// worker thread while the current scene is still running, and the images of its sprites are
+// decoded there too. Construct then only creates the objects from the parsed blocks and
+// DrawConstruct only uploads the decoded pixels, spread over frames in Scene::State::LOAD.
+//
+// The scene arena and the TEMP arena aren't thread safe, so everything the worker produces is
+// malloc'd and sized to what it read. It's freed once DrawConstruct is done.
+//
+//   Scene::Loader::Prefetch(Scene::GetLoader(), "Level2.level");
+//   ...
+//   char* contents = Scene::Loader::Wait(Scene::GetLoader(), "Level2.level");
+namespace Temp::Scene::Loader
+{
+  enum class Status : uint8_t
+  {
+    IDLE = 0,
+    READING,
+    READY,
+    FAILED
+  };
+
+  constexpr size_t READ_CHUNK_SIZE = 1048576;
+  // Time DrawConstruct gets per frame while loading, in seconds
+  constexpr float DRAW_CONSTRUCT_BUDGET = 0.004f;
+  // Share of Progress taken by the read, the rest is DrawConstruct
+  constexpr float READ_SHARE = 0.5f;
+
+  struct Texture
+  {
+    // Relative to Assets/Images, points into contents
+    std::string_view file{};
+    TGA::Header header{};
+    // nullptr when the image couldn't be decoded, DrawConstruct then reads it itself
+    uint8_t* pixels{nullptr};
+  };
+
+  struct Data
+  {
+    // Full path of the file being read
+    char path[4096]{};
+    // Assets/Images including the trailing separator, the worker can't build paths itself
+    char imagesPath[4096]{};
+    // Null terminated
+    char* contents{nullptr};
+    // Only set when the whole level could be parsed on the worker
+    LevelSerializer::Block* blocks{nullptr};
+    size_t numBlocks{0};
+    // One per image file the sprites of the level use
+    Texture* textures{nullptr};
+    size_t numTextures{0};
+    std::thread thread{};
+    std::atomic<Status> status{Status::IDLE};
+    std::atomic<size_t> bytesRead{0};
+    std::atomic<size_t> length{0};
+    // Next object to DrawConstruct
+    size_t nextObject{0};
+    size_t numObjects{0};
+    bool isDrawConstructed{true};
+  };
+
+  // file is relative to Assets/Levels. Everything from a previous Prefetch is released.
+  void Prefetch(Data& loader, const char* file);
+  // Blocks until the read of file is done. Returns nullptr if file wasn't the one prefetched or
+  // it couldn't be read, in which case the caller should read it itself.
+  [[nodiscard]] char* Wait(Data& loader, const char* file);
+  // Creates the objects of the prefetched level when the worker could parse it, otherwise
+  // contents from Wait have to go through LevelSerializer::Deserialize. Call after Wait.
+  [[nodiscard]] bool Deserialize(Scene::Data& scene, const Data& loader);
+  // Pixels the worker decoded for file (relative to Assets/Images), nullptr when there are none
+  [[nodiscard]] uint8_t* FindTexture(const Data& loader, const char* file, TGA::Header& header);
+  void BeginDrawConstruct(Data& loader);
+  // DrawConstructs objects of scene until the budget (seconds) runs out. Returns true once
+  // everything, DrawConstructFunc included, is done and releases what the worker produced.
+  bool DrawConstruct(Scene::Data& scene, Data& loader, float budget = DRAW_CONSTRUCT_BUDGET);
+  // 0 to 1 across the read and DrawConstruct of the scene being loaded
+  [[nodiscard]] float Progress(const Data& loader);
+  // Frees the contents, blocks and textures, waits for the worker first
+  void Release(Data& loader);
+  void Destroy(Data& loader);
+}
+
+namespace Temp::Scene
+{
+  Loader::Data& GetLoader();
+}
@@ -49,6 +49,12 @@ namespace Temp::SceneObject
                     object.entity);
         };
       }
+      if constexpr (requires(Scene::Data& scene, T& data) { Prepare(scene, data); })
+      {
+        FnTable[FnType::PREPARE][type] = [](auto& scene, auto& object) {
+          Prepare(scene, *static_cast<T*>(object.data));
+        };
+      }
       FnTable[FnType::DRAWCONSTRUCT][type] = [](auto& scene, auto& object) {
         if (object.shaderType < 0)
           DrawConstruct(scene, *static_cast<T*>(object.data));
@@ -57,7 +63,10 @@ namespace Temp::SceneObject
       };
       FnTable[FnType::DRAWDESTRUCT][type] = [](auto& scene, auto& object) {
         DrawDestruct(scene, *static_cast<T*>(object.data));
-        if (Test(Scene::ComponentBits(scene, object.entity), Component::Type::DRAWABLE))
+        // A disabled drawable holds on to its GL objects too, destroying the entity only drops it
+        const auto& drawableArray = Scene::GetComponentArray<Component::Type::DRAWABLE>(scene);
+        if (Test(Scene::ComponentBits(scene, object.entity), Component::Type::DRAWABLE) ||
+            drawableArray.disabledIndices[object.entity] != SIZE_MAX)
         {
           auto& drawable = Scene::Get<Component::Type::DRAWABLE>(scene, object.entity);
           Component::Drawable::Destruct(drawable);
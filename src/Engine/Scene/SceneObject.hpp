@@ -23,6 +23,8 @@ namespace Temp::SceneObject
     enum FnType
     {
       CONSTRUCT = 0,
+      // Optional, CPU side work that can run on the thread pool after every object's CONSTRUCT
+      PREPARE,
       DRAWCONSTRUCT,
       DRAWDESTRUCT,
       DESTRUCT,
@@ -73,11 +75,26 @@ namespace Temp::SceneObject
   inline Data (*CopyTable[256])(Data&);
 #endif
 
-  inline void Construct(Scene::Data& scene, Data& object)
+  inline void BeginConstruct(Scene::Data& scene, Data& object)
   {
     FnTable[FnType::CONSTRUCT][object.type](scene, object);
   }
 
+  // Must not add/remove components or allocate from the arenas, record into Scene::GetCommands()
+  inline void Prepare(Scene::Data& scene, Data& object)
+  {
+    if (FnTable[FnType::PREPARE][object.type])
+    {
+      FnTable[FnType::PREPARE][object.type](scene, object);
+    }
+  }
+
+  inline void Construct(Scene::Data& scene, Data& object)
+  {
+    BeginConstruct(scene, object);
+    Prepare(scene, object);
+  }
+
   inline void Destruct(Scene::Data& scene, Data& object)
   {
     FnTable[FnType::DESTRUCT][object.type](scene, object);
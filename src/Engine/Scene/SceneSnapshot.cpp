@@ -0,0 +1,399 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#include "SceneSnapshot.hpp"
+#include "ComponentData.hpp"
+#include "Logger.hpp"
+#include "MemoryManager.hpp"
+#include "Scene.hpp"
+#include "SceneCommands.hpp"
+
+namespace Temp::Scene::Snapshots
+{
+  namespace
+  {
+    // Unchanged words in between changed ones that still get merged into the same run, every run
+    // costs a header word
+    constexpr size_t MAX_GAP = 4;
+    // Unchanged parts are skipped this many words at a time
+    constexpr size_t BLOCK_WORDS = 8;
+
+    constexpr size_t NumWords(size_t arenaOffset) { return (arenaOffset + 7) / 8; }
+
+    // Used part of the scene arena rounded up to whole words, the arena is always a lot bigger
+    // than what's used
+    const uint64_t* ArenaWords(size_t& numWords)
+    {
+      auto& arena = MemoryManager::data.sceneArena;
+      numWords = NumWords(arena.offset);
+      return reinterpret_cast<const uint64_t*>(arena.buffer);
+    }
+
+    // Regrowing leaves the old buffer behind in the global arena, so grow with some headroom
+    void Grow(GlobalDynamicArray<uint64_t>& array, size_t size)
+    {
+      if (!array.buffer)
+      {
+        array.capacity = std::max(array.capacity, size + size / 2);
+        array.Initialize();
+      }
+      else if (size > array.capacity)
+      {
+        array.Reserve(size + size / 2);
+      }
+      array.size = std::max(array.size, size);
+    }
+
+    void Append(GlobalDynamicArray<uint64_t>& array, const uint64_t* words, size_t numWords)
+    {
+      size_t size = array.size;
+      Grow(array, size + numWords);
+      memcpy(array.buffer + size, words, numWords * sizeof(uint64_t));
+    }
+
+    // Only the headers of the containers are copied, what they point at is part of the arena.
+    // Assigning them would copy the contents into new allocations instead.
+    template <typename T, MemoryManager::Data::Type Type>
+    void Copy(DynamicArray<T, Type>& to, const DynamicArray<T, Type>& from)
+    {
+      to.buffer = from.buffer;
+      to.offset = from.offset;
+      to.prevOffset = from.prevOffset;
+      to.size = from.size;
+      to.capacity = from.capacity;
+    }
+
+    void Copy(Component::Transform::Data& to, const Component::Transform::Data& from)
+    {
+      Copy(to.models, from.models);
+      Copy(to.rows, from.rows);
+      Copy(to.x, from.x);
+      Copy(to.y, from.y);
+      Copy(to.scaleX, from.scaleX);
+      Copy(to.scaleY, from.scaleY);
+      Copy(to.cos, from.cos);
+      Copy(to.sin, from.sin);
+      Copy(to.nodes, from.nodes);
+      Copy(to.roots, from.roots);
+      to.nodeIndices = from.nodeIndices;
+      Copy(to.previousModels, from.previousModels);
+      to.lastTick = from.lastTick;
+      to.isHierarchyChanged = from.isHierarchyChanged;
+      to.isEntityDestroyed = from.isEntityDestroyed;
+      to.alpha = from.alpha;
+      to.isInterpolated = from.isInterpolated;
+    }
+
+    void Copy(Component::Hoverable::IndexData& to, const Component::Hoverable::IndexData& from)
+    {
+      to.grid.cellSize = from.grid.cellSize;
+      Copy(to.grid.buckets, from.grid.buckets);
+      Copy(to.grid.nodes, from.grid.nodes);
+      to.grid.freeNodes = from.grid.freeNodes;
+      Copy(to.grid.oversized, from.grid.oversized);
+      to.grid.entries = from.grid.entries;
+      to.grid.size = from.grid.size;
+      Copy(to.minX, from.minX);
+      Copy(to.minY, from.minY);
+      Copy(to.maxX, from.maxX);
+      Copy(to.maxY, from.maxY);
+      Copy(to.mask, from.mask);
+      Copy(to.hovered, from.hovered);
+      Copy(to.nextHovered, from.nextHovered);
+      Copy(to.candidates, from.candidates);
+      to.lastTick = from.lastTick;
+    }
+
+    void Copy(Component::Collision::Data& to, const Component::Collision::Data& from)
+    {
+      Copy(to.bodies, from.bodies);
+      Copy(to.order, from.order);
+      Copy(to.entities, from.entities);
+      Copy(to.minX, from.minX);
+      Copy(to.minY, from.minY);
+      Copy(to.maxX, from.maxX);
+      Copy(to.maxY, from.maxY);
+      Copy(to.centerX, from.centerX);
+      Copy(to.centerY, from.centerY);
+      Copy(to.radius, from.radius);
+      Copy(to.shapes, from.shapes);
+      Copy(to.layers, from.layers);
+      Copy(to.masks, from.masks);
+      for (size_t i = 0; i < Component::Collision::MAX_CHUNKS; ++i)
+      {
+        Copy(to.chunkContacts[i], from.chunkContacts[i]);
+      }
+      Copy(to.pairs, from.pairs);
+      Copy(to.lastPairs, from.lastPairs);
+      Copy(to.events, from.events);
+      for (size_t i = 0; i < Component::Collision::MAX_LISTENERS; ++i)
+      {
+        to.listeners[i] = from.listeners[i];
+      }
+      to.numListeners = from.numListeners;
+    }
+
+    void Copy(Component::Tween::Data& to, const Component::Tween::Data& from)
+    {
+      Copy(to.entities, from.entities);
+      Copy(to.properties, from.properties);
+      Copy(to.easings, from.easings);
+      Copy(to.start, from.start);
+      Copy(to.end, from.end);
+      Copy(to.elapsed, from.elapsed);
+      Copy(to.invDuration, from.invDuration);
+      Copy(to.targets, from.targets);
+      Copy(to.serials, from.serials);
+      to.entitySerials = from.entitySerials;
+      Copy(to.values, from.values);
+    }
+
+    void Copy(Entity::Data& to, const Entity::Data& from)
+    {
+      Copy(to.used, from.used);
+      Copy(to.componentBits, from.componentBits);
+      Copy(to.freeEntities, from.freeEntities);
+      // The component arrays themselves live in the arena
+      to.componentContainer = from.componentContainer;
+      Copy(to.archetypes.tables, from.archetypes.tables);
+      to.archetypes.locations = from.archetypes.locations;
+      to.storage = from.storage;
+    }
+
+    // Everything but state, sceneFns and gameData, which belong to whoever drives the scene
+    void CopyScene(Scene::Data& to, const Scene::Data& from)
+    {
+      Copy(to.objects, from.objects);
+      Copy(to.objectsNameIdxTable.buffer, from.objectsNameIdxTable.buffer);
+      to.objectsNameIdxTable.size = from.objectsNameIdxTable.size;
+      Copy(to.entityObjectIdxTable, from.entityObjectIdxTable);
+      Copy(to.renderQueue.buffer, from.renderQueue.buffer);
+      to.renderQueue.head = from.renderQueue.head;
+      to.renderQueue.tail = from.renderQueue.tail;
+      Copy(to.transforms, from.transforms);
+      Copy(to.hoverIndex, from.hoverIndex);
+      Copy(to.collisions, from.collisions);
+      Copy(to.tweens, from.tweens);
+      Copy(to.entityData, from.entityData);
+      to.systems = from.systems;
+    }
+
+    void WriteKeyframe(Data& snapshots, Slot& slot, const uint64_t* words, size_t numWords)
+    {
+      slot.words.Clear();
+      Append(slot.words, words, numWords);
+      Grow(snapshots.image, numWords);
+      memcpy(snapshots.image.buffer, words, numWords * sizeof(uint64_t));
+      snapshots.numImageWords = numWords;
+    }
+
+    void WriteDelta(Data& snapshots, Slot& slot, const uint64_t* words, size_t numWords)
+    {
+      auto& image = snapshots.image;
+      Grow(image, numWords);
+      // Words past the previous image are always new
+      size_t numCompared = std::min(numWords, snapshots.numImageWords);
+      slot.words.Clear();
+      size_t i = 0;
+      while (i < numWords)
+      {
+        while (i + BLOCK_WORDS <= numCompared &&
+               memcmp(words + i, image.buffer + i, BLOCK_WORDS * sizeof(uint64_t)) == 0)
+        {
+          i += BLOCK_WORDS;
+        }
+        while (i < numCompared && words[i] == image[i])
+        {
+          ++i;
+        }
+        if (i >= numWords)
+        {
+          break;
+        }
+        size_t start = i;
+        size_t end = ++i;
+        while (i < numWords && i - end <= MAX_GAP)
+        {
+          if (i >= numCompared || words[i] != image[i])
+          {
+            end = i + 1;
+          }
+          ++i;
+        }
+        uint64_t header = ((uint64_t)start << 32) | (uint64_t)(end - start);
+        Append(slot.words, &header, 1);
+        Append(slot.words, words + start, end - start);
+        memcpy(image.buffer + start, words + start, (end - start) * sizeof(uint64_t));
+        i = end;
+      }
+      snapshots.numImageWords = numWords;
+    }
+
+    void ApplyDelta(GlobalDynamicArray<uint64_t>& image, const Slot& slot)
+    {
+      const uint64_t* run = slot.words.buffer;
+      const uint64_t* end = run + slot.words.size;
+      while (run < end)
+      {
+        size_t start = (size_t)(*run >> 32);
+        size_t count = (size_t)(*run & UINT32_MAX);
+        ++run;
+        memcpy(image.buffer + start, run, count * sizeof(uint64_t));
+        run += count;
+      }
+    }
+
+    size_t SlotIndex(const Data& snapshots, uint64_t frame) { return (size_t)(frame % snapshots.slots.size); }
+
+    size_t KeyframeIndex(const Data& snapshots, size_t slotIndex)
+    {
+      return slotIndex - slotIndex % snapshots.keyframeInterval;
+    }
+  }
+
+  void Init(Data& snapshots, size_t capacity)
+  {
+    capacity = std::max(capacity, (size_t)1);
+    snapshots.keyframeInterval = std::min(KEYFRAME_INTERVAL, capacity);
+    size_t numSlots = (capacity + snapshots.keyframeInterval - 1) / snapshots.keyframeInterval *
+                      snapshots.keyframeInterval;
+    if (snapshots.slots.size != numSlots)
+    {
+      snapshots.slots.Clear();
+      snapshots.slots.Resize(numSlots);
+    }
+    Clear(snapshots);
+  }
+
+  void Clear(Data& snapshots)
+  {
+    for (auto& slot : snapshots.slots)
+    {
+      slot.frame = INVALID_FRAME;
+    }
+    snapshots.numImageWords = 0;
+    snapshots.nextFrame = 0;
+  }
+
+  void Destroy(Data& snapshots)
+  {
+    snapshots = {};
+  }
+
+  bool IsRestorable(const Data& snapshots, uint64_t frame)
+  {
+    if (snapshots.slots.size == 0 || frame == INVALID_FRAME)
+    {
+      return false;
+    }
+    // Every slot from the keyframe on has to still hold this frame's chain
+    size_t slotIndex = SlotIndex(snapshots, frame);
+    size_t keyframeIndex = KeyframeIndex(snapshots, slotIndex);
+    for (size_t i = keyframeIndex; i <= slotIndex; ++i)
+    {
+      if (snapshots.slots[i].frame != frame - (slotIndex - i))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  size_t Size(const Data& snapshots, uint64_t frame)
+  {
+    if (snapshots.slots.size == 0)
+    {
+      return 0;
+    }
+    const Slot& slot = snapshots.slots[SlotIndex(snapshots, frame)];
+    if (slot.frame != frame)
+    {
+      return 0;
+    }
+    return slot.words.size * sizeof(uint64_t) + sizeof(Scene::Data);
+  }
+}
+
+namespace Temp::Scene
+{
+  uint64_t Snapshot(const Data& scene, Snapshots::Data& snapshots)
+  {
+    if (snapshots.slots.size == 0)
+    {
+      Snapshots::Init(snapshots, Snapshots::KEYFRAME_INTERVAL);
+    }
+    uint64_t frame = snapshots.nextFrame++;
+    size_t slotIndex = Snapshots::SlotIndex(snapshots, frame);
+    auto& slot = snapshots.slots[slotIndex];
+
+    size_t numWords;
+    const uint64_t* words = Snapshots::ArenaWords(numWords);
+    if (slotIndex % snapshots.keyframeInterval == 0)
+    {
+      Snapshots::WriteKeyframe(snapshots, slot, words, numWords);
+      // The deltas after this slot belonged to the keyframe that just got overwritten
+      for (size_t i = slotIndex + 1; i < slotIndex + snapshots.keyframeInterval; ++i)
+      {
+        snapshots.slots[i].frame = Snapshots::INVALID_FRAME;
+      }
+    }
+    else
+    {
+      Snapshots::WriteDelta(snapshots, slot, words, numWords);
+    }
+
+    if (!slot.scene)
+    {
+      slot.scene = MemoryManager::CreateGlobal<Data>();
+    }
+    Snapshots::CopyScene(*slot.scene, scene);
+    slot.arenaOffset = MemoryManager::data.sceneArena.offset;
+    slot.tick = Component::Tick();
+    slot.frame = frame;
+    return frame;
+  }
+
+  bool Restore(Data& scene, Snapshots::Data& snapshots, uint64_t frame)
+  {
+    if (!Snapshots::IsRestorable(snapshots, frame))
+    {
+      Logger::LogErr("[Scene] Snapshot to restore isn't in the ring anymore!");
+      return false;
+    }
+
+    size_t slotIndex = Snapshots::SlotIndex(snapshots, frame);
+    size_t keyframeIndex = Snapshots::KeyframeIndex(snapshots, slotIndex);
+    auto& image = snapshots.image;
+    for (size_t i = keyframeIndex; i <= slotIndex; ++i)
+    {
+      Snapshots::Grow(image, Snapshots::NumWords(snapshots.slots[i].arenaOffset));
+    }
+    const auto& keyframe = snapshots.slots[keyframeIndex];
+    memcpy(image.buffer, keyframe.words.buffer, keyframe.words.size * sizeof(uint64_t));
+    for (size_t i = keyframeIndex + 1; i <= slotIndex; ++i)
+    {
+      Snapshots::ApplyDelta(image, snapshots.slots[i]);
+    }
+
+    const auto& slot = snapshots.slots[slotIndex];
+    snapshots.numImageWords = Snapshots::NumWords(slot.arenaOffset);
+    auto& arena = MemoryManager::data.sceneArena;
+    memcpy(arena.buffer, image.buffer, snapshots.numImageWords * sizeof(uint64_t));
+    arena.offset = slot.arenaOffset;
+
+    Snapshots::CopyScene(scene, *slot.scene);
+    Component::changeTick.store(slot.tick, std::memory_order_relaxed);
+    Commands::Clear(GetCommands());
+
+    // Simulating again from here overwrites the newer frames
+    for (auto& other : snapshots.slots)
+    {
+      if (other.frame != Snapshots::INVALID_FRAME && other.frame > frame)
+      {
+        other.frame = Snapshots::INVALID_FRAME;
+      }
+    }
+    snapshots.nextFrame = frame + 1;
+    return true;
+  }
+}
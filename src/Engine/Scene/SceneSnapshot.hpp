@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "STDPCH.hpp" // IWYU pragma: keep
+#include "Array.hpp"
+
+namespace Temp::Scene
+{
+  struct Data;
+}
+
+// Every allocated part of a scene (objects, entity data, components, transforms, ...) lives in
+// the scene arena and Scene::Data only points into it, so a whole frame is the used part of the
+// arena plus the headers in Scene::Data and the change tick.
+//
+// Snapshots go into a ring. Every KEYFRAME_INTERVAL-th slot holds a full copy of the arena, the
+// slots in between only hold the 8 byte words that changed since the previous snapshot. Restoring
+// a frame rebuilds it from its keyframe and drops every newer frame, so simulating again from
+// there overwrites them.
+//
+// Not captured: GL objects, audio, pending Scene::Commands (dropped on restore) and anything a
+// game keeps outside of the scene arena. Rolling back over objects that were spawned or removed
+// leaks or loses their GL resources, so only roll back over entity and component changes or run
+// headless.
+namespace Temp::Scene::Snapshots
+{
+  constexpr size_t KEYFRAME_INTERVAL = 16;
+  constexpr uint64_t INVALID_FRAME = UINT64_MAX;
+
+  struct Slot
+  {
+    // Full arena image for keyframes. Otherwise runs of changed words, each one a header word
+    // (first word << 32 | number of words) followed by the words.
+    GlobalDynamicArray<uint64_t> words{};
+    // Never destructed, its containers point into the scene arena
+    Scene::Data* scene{nullptr};
+    size_t arenaOffset{0};
+    uint32_t tick{0};
+    uint64_t frame{INVALID_FRAME};
+  };
+
+  struct Data
+  {
+    GlobalDynamicArray<Slot> slots{};
+    // Arena as of the newest snapshot, deltas are taken against it
+    GlobalDynamicArray<uint64_t> image{};
+    size_t numImageWords{0};
+    size_t keyframeInterval{KEYFRAME_INTERVAL};
+    uint64_t nextFrame{0};
+  };
+
+  // Holds at least capacity frames, rounded up to a multiple of the keyframe interval. A capacity
+  // of 1 only keeps the last snapshot, e.g. the start of a level. Everything is kept in the global
+  // arena, which doesn't free, so set up rings once and reuse them.
+  void Init(Data& snapshots, size_t capacity);
+  // Has to be called whenever the scene gets destructed or replaced
+  void Clear(Data& snapshots);
+  void Destroy(Data& snapshots);
+  [[nodiscard]] bool IsRestorable(const Data& snapshots, uint64_t frame);
+  // Bytes stored for frame, 0 when it isn't in the ring
+  [[nodiscard]] size_t Size(const Data& snapshots, uint64_t frame);
+}
+
+namespace Temp::Scene
+{
+  // Returns the frame id of the snapshot
+  uint64_t Snapshot(const Data& scene, Snapshots::Data& snapshots);
+  // Returns false when frame isn't in the ring anymore. sceneFns, gameData and state stay as they
+  // are.
+  bool Restore(Data& scene, Snapshots::Data& snapshots, uint64_t frame);
+}
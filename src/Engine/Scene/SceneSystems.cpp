@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#include "SceneSystems.hpp"
+#include "Logger.hpp"
+#include "Scene.hpp"
+#include "SceneCommands.hpp"
+#include "ThreadPool.hpp"
+
+namespace Temp::Scene::Systems
+{
+  static_assert(MAX_SYSTEMS <= Commands::MAX_BUFFERS, "Every system needs its own command buffer");
+
+  namespace
+  {
+    struct Job
+    {
+      Scene::Data* scene{nullptr};
+      System* system{nullptr};
+      float deltaTime{0};
+      // Index of the system, commands it records go into that buffer
+      size_t index{0};
+    };
+
+    void RunJob(void* data)
+    {
+      auto& job = *static_cast<Job*>(data);
+      Commands::JobScope scope(job.index);
+      auto start = std::chrono::steady_clock::now();
+      job.system->func(*job.scene, job.deltaTime);
+      auto stop = std::chrono::steady_clock::now();
+      job.system->time = std::chrono::duration<float, std::milli>(stop - start).count();
+    }
+
+    size_t IndexOf(const Data& systems, const char* name)
+    {
+      for (size_t i = 0; i < systems.size; ++i)
+      {
+        if (strcmp(systems.systems[i].name, name) == 0)
+        {
+          return i;
+        }
+      }
+      return SIZE_MAX;
+    }
+  }
+
+  void Add(Data& systems,
+           const char* name,
+           SystemFunction func,
+           ::Temp::ComponentBits reads,
+           ::Temp::ComponentBits writes)
+  {
+    if (systems.size == MAX_SYSTEMS)
+    {
+      Logger::LogErr("[Systems] Add: Too many systems!");
+      assert(false);
+      return;
+    }
+    if (IndexOf(systems, name) != SIZE_MAX)
+    {
+      Logger::LogErr("[Systems] Add: System name already registered!");
+      assert(false);
+      return;
+    }
+    systems.systems[systems.size++] = {name, func, reads, writes};
+  }
+
+  void Remove(Data& systems, const char* name)
+  {
+    size_t index = IndexOf(systems, name);
+    if (index == SIZE_MAX)
+    {
+      return;
+    }
+    // Shifting keeps the registration order
+    for (size_t i = index + 1; i < systems.size; ++i)
+    {
+      systems.systems[i - 1] = systems.systems[i];
+    }
+    systems.systems[--systems.size] = {};
+  }
+
+  void SetEnabled(Data& systems, const char* name, bool enabled)
+  {
+    size_t index = IndexOf(systems, name);
+    if (index != SIZE_MAX)
+    {
+      systems.systems[index].enabled = enabled;
+    }
+  }
+
+  const System* Find(const Data& systems, const char* name)
+  {
+    size_t index = IndexOf(systems, name);
+    return index != SIZE_MAX ? &systems.systems[index] : nullptr;
+  }
+
+  size_t Build(Data& systems)
+  {
+    systems.numBatches = 0;
+    for (size_t i = 0; i < systems.size; ++i)
+    {
+      auto& system = systems.systems[i];
+      if (!system.enabled)
+      {
+        continue;
+      }
+      size_t batch = 0;
+      for (size_t j = 0; j < i; ++j)
+      {
+        const auto& other = systems.systems[j];
+        if (other.enabled && IsConflicting(system, other))
+        {
+          batch = Math::Max(batch, (size_t)other.batch + 1);
+        }
+      }
+      system.batch = (uint8_t)batch;
+      systems.numBatches = Math::Max(systems.numBatches, batch + 1);
+    }
+    return systems.numBatches;
+  }
+
+  void Run(Scene::Data& scene, Data& systems, float deltaTime)
+  {
+    Build(systems);
+
+    auto& threadPool = GetThreadPool();
+    Job jobs[MAX_SYSTEMS];
+    for (size_t batch = 0; batch < systems.numBatches; ++batch)
+    {
+      size_t count = 0;
+      for (size_t i = 0; i < systems.size; ++i)
+      {
+        auto& system = systems.systems[i];
+        if (system.enabled && system.batch == batch)
+        {
+          jobs[count++] = {&scene, &system, deltaTime, i};
+        }
+      }
+
+      if (count == 1)
+      {
+        RunJob(&jobs[0]);
+        continue;
+      }
+      // None of them run here, a ParallelEach on this thread would record into the buffers of
+      // the other systems and wait on them too
+      for (size_t i = 0; i < count; ++i)
+      {
+        ThreadPool::Enqueue(threadPool, RunJob, &jobs[i]);
+      }
+      ThreadPool::Wait(threadPool);
+    }
+  }
+
+  void Clear(Data& systems) { systems = Systems::Data(); }
+}
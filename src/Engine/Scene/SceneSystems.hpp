@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "STDPCH.hpp" // IWYU pragma: keep
+#include "Component.hpp"
+
+namespace Temp::Scene
+{
+  struct Data;
+}
+
+// Game systems registered with the component types they read and write. Every frame Run splits
+// the enabled systems into batches where no system writes what another one reads or writes,
+// and runs each batch on the thread pool. Systems that conflict keep their registration order.
+//
+//   Scene::Systems::Add(scene.systems, "AI", AI::Update,
+//                       Scene::Systems::Access<POSITION2D>(),
+//                       Scene::Systems::Access<UPDATEABLE>());
+//
+// Systems sharing a batch all run on worker threads: structural changes have to go through
+// Scene::Commands and ParallelEach falls back to a serial loop there (waiting on the pool from a
+// worker never returns). Only a system that ends up alone in its batch runs on the calling thread
+// and gets the parallel one.
+namespace Temp::Scene::Systems
+{
+  constexpr size_t MAX_SYSTEMS = 64;
+
+  typedef void (*SystemFunction)(Scene::Data& scene, float deltaTime);
+
+  struct System
+  {
+    const char* name{nullptr};
+    SystemFunction func{nullptr};
+    ::Temp::ComponentBits reads{0};
+    ::Temp::ComponentBits writes{0};
+    bool enabled{true};
+    // Batch of the last Build
+    uint8_t batch{0};
+    // Duration of the last run in milliseconds
+    float time{0};
+  };
+
+  struct Data
+  {
+    System systems[MAX_SYSTEMS]{};
+    size_t size{0};
+    size_t numBatches{0};
+  };
+
+  template <uint8_t... Ts>
+  [[nodiscard]] constexpr ::Temp::ComponentBits Access()
+  {
+    ::Temp::ComponentBits bits{0};
+    (SetBit(bits, Ts), ...);
+    return bits;
+  }
+
+  [[nodiscard]] constexpr bool IsConflicting(const System& a, const System& b)
+  {
+    return (a.writes & (b.reads | b.writes)) || (b.writes & a.reads);
+  }
+
+  // Name has to outlive the registration, use string literals
+  void Add(Data& systems,
+           const char* name,
+           SystemFunction func,
+           ::Temp::ComponentBits reads,
+           ::Temp::ComponentBits writes);
+  void Remove(Data& systems, const char* name);
+  void SetEnabled(Data& systems, const char* name, bool enabled);
+  [[nodiscard]] const System* Find(const Data& systems, const char* name);
+  // Assigns every enabled system the first batch after all earlier systems it conflicts with
+  size_t Build(Data& systems);
+  void Run(Scene::Data& scene, Data& systems, float deltaTime);
+  void Clear(Data& systems);
+}
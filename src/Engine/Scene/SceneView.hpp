@@ -0,0 +1,245 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Archetype.hpp"
+#include "ComponentType.hpp"
+#include "Entity.hpp"
+#include "EntityData.hpp"
+#include "Math.hpp"
+#include "Scene.hpp"
+#include "SceneCommands.hpp"
+#include "ThreadPool.hpp"
+
+namespace Temp::Scene
+{
+  // Upper bound on how many chunks ParallelEach splits a view into
+  constexpr size_t MAX_PARALLEL_CHUNKS = 64;
+  // Below this many entities per chunk it's not worth waking up workers
+  constexpr size_t PARALLEL_MIN_CHUNK = 256;
+  static_assert(MAX_PARALLEL_CHUNKS <= Commands::MAX_BUFFERS, "Every chunk needs its own command buffer");
+
+  // Iterates every entity that has all of the components Ts.
+  // The smallest component array drives the iteration and the rest are filtered with the
+  // entity's ComponentBits, so a view over a rare component stays cheap.
+  // With archetype storage the view walks the chunks of every matching table instead.
+  //
+  //   for (auto [entity, position, scale] : Scene::View<POSITION2D, SCALE>(scene))
+  //
+  // Every component handed out counts as changed, like a mutable Component::Get. Systems that
+  // only read should use the const Get instead. Archetype storage doesn't track changes.
+  //
+  // Don't add or remove any of the viewed components while iterating!
+  template <uint8_t... Ts>
+  struct View
+  {
+    static_assert(sizeof...(Ts) > 0, "View needs at least one component type");
+
+    using Tuple = std::tuple<Entity::id, Component::MapToComponentDataType<Ts>&...>;
+
+    Entity::Data* entityData{nullptr};
+    // Dense entity list of the smallest array
+    const SceneDynamicArray<Entity::id>* entities{nullptr};
+    // Sparse sets: size of the driving array | Archetypes: number of matching rows
+    size_t size{0};
+    ::Temp::ComponentBits mask{0};
+
+    struct Iterator
+    {
+      const View* view{nullptr};
+      size_t index{0};
+      // Only used with archetype storage
+      size_t table{0};
+      size_t row{0};
+
+      Iterator& operator++()
+      {
+        if (view->IsArchetype())
+        {
+          ++index;
+          ++row;
+          view->Seek(*this);
+        }
+        else
+        {
+          index = view->Next(index + 1);
+        }
+        return *this;
+      }
+
+      bool operator!=(const Iterator& other) const { return index != other.index; }
+
+      Tuple operator*() const
+      {
+        if (view->IsArchetype())
+        {
+          const auto& table = view->entityData->archetypes.tables[this->table];
+          return Tuple(*Archetype::Entities(table, row), *Archetype::Column<Ts>(table, row)...);
+        }
+        return view->Fetch((*view->entities)[index]);
+      }
+    };
+
+    explicit View(Data& scene)
+      : entityData(&scene.entityData)
+    {
+      (SetBit(mask, Ts), ...);
+      if (IsArchetype())
+      {
+        size = Archetype::Count(entityData->archetypes, mask);
+        return;
+      }
+      size = SIZE_MAX;
+      (Consider(Entity::GetComponentArray<Ts>(*entityData)), ...);
+    }
+
+    [[nodiscard]] Iterator begin() const
+    {
+      Iterator it{this, 0, 0, 0};
+      if (IsArchetype())
+      {
+        Seek(it);
+      }
+      else
+      {
+        it.index = Next(0);
+      }
+      return it;
+    }
+
+    [[nodiscard]] Iterator end() const { return {this, size}; }
+
+    [[nodiscard]] bool IsArchetype() const
+    {
+      return entityData->storage == Entity::Storage::ARCHETYPE;
+    }
+
+    [[nodiscard]] bool Contains(Entity::id entity) const
+    {
+      if constexpr (sizeof...(Ts) == 1)
+      {
+        return true;
+      }
+      else
+      {
+        return (entityData->componentBits[entity] & mask) == mask;
+      }
+    }
+
+    // Returns the first index >= index that matches the view
+    [[nodiscard]] size_t Next(size_t index) const
+    {
+      while (index < size && !Contains((*entities)[index]))
+      {
+        ++index;
+      }
+      return index;
+    }
+
+    // Moves the iterator to the next row of a matching table
+    void Seek(Iterator& it) const
+    {
+      const auto& tables = entityData->archetypes.tables;
+      while (it.table < tables.size &&
+             ((tables[it.table].bits & mask) != mask || it.row >= tables[it.table].size))
+      {
+        ++it.table;
+        it.row = 0;
+      }
+    }
+
+    [[nodiscard]] Tuple Fetch(Entity::id entity) const
+    {
+      return Tuple(entity, Dense<Ts>(entity)...);
+    }
+
+  private:
+    template <typename A>
+    void Consider(const A& array)
+    {
+      if (array.size < size)
+      {
+        size = array.size;
+        entities = &array.sparseEntities;
+      }
+    }
+
+    template <uint8_t T>
+    Component::MapToComponentDataType<T>& Dense(Entity::id entity) const
+    {
+      auto& array = Entity::GetComponentArray<T>(*entityData);
+      size_t index = array.sparseIndices[entity];
+      // Rows are split between chunks, so stamping from ParallelEach doesn't race
+      array.changed[index] = Component::Tick();
+      return array.array[index];
+    }
+  };
+
+  // func(Entity::id, Ts&...)
+  template <uint8_t... Ts, typename F>
+  inline void Each(const View<Ts...>& view, F&& func, size_t begin = 0, size_t end = SIZE_MAX)
+  {
+    if (view.IsArchetype())
+    {
+      Archetype::Each<Ts...>(view.entityData->archetypes, view.mask, func, begin, end);
+      return;
+    }
+    end = Math::Min(end, view.size);
+    for (size_t i = begin; i < end; ++i)
+    {
+      Entity::id entity = (*view.entities)[i];
+      if (view.Contains(entity))
+      {
+        std::apply(func, view.Fetch(entity));
+      }
+    }
+  }
+
+  // Splits the driving array into chunks and runs them across the thread pool.
+  // The calling thread works on the first chunk. func must be safe to call concurrently!
+  // Commands recorded by func go into the buffer of its chunk.
+  // Called from a worker (a system sharing its batch) it runs serially, waiting on the pool there
+  // would never return.
+  template <uint8_t... Ts, typename F>
+  inline void ParallelEach(const View<Ts...>& view,
+                           F&& func,
+                           size_t minChunkSize = PARALLEL_MIN_CHUNK,
+                           ThreadPool::Data& threadPool = GetThreadPool())
+  {
+    size_t numChunks = Math::Min(threadPool.threads.size + 1, MAX_PARALLEL_CHUNKS);
+    numChunks = Math::Min(numChunks, view.size / Math::Max(minChunkSize, (size_t)1));
+    if (numChunks <= 1 || ThreadPool::IsWorker())
+    {
+      Each(view, func);
+      return;
+    }
+
+    struct Chunk
+    {
+      const View<Ts...>* view{nullptr};
+      std::remove_reference_t<F>* func{nullptr};
+      size_t begin{0};
+      size_t end{0};
+      size_t index{0};
+    };
+    auto run = [](void* data) {
+      auto* chunk = static_cast<Chunk*>(data);
+      Commands::JobScope scope(chunk->index);
+      Each(*chunk->view, *chunk->func, chunk->begin, chunk->end);
+    };
+
+    Chunk chunks[MAX_PARALLEL_CHUNKS];
+    size_t stride = (view.size + numChunks - 1) / numChunks;
+    for (size_t i = 0; i < numChunks; ++i)
+    {
+      chunks[i] = {&view, &func, i * stride, Math::Min((i + 1) * stride, view.size), i};
+    }
+    for (size_t i = 1; i < numChunks; ++i)
+    {
+      ThreadPool::Enqueue(threadPool, run, &chunks[i]);
+    }
+    run(&chunks[0]);
+    ThreadPool::Wait(threadPool);
+  }
+}
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#include "SpatialGrid.hpp"
+
+namespace Temp::SpatialGrid
+{
+  namespace
+  {
+    // Cells of one entity can share a bucket, it's only linked into each bucket once
+    template <typename F>
+    void EachBucket(const Entry& entry, F&& func)
+    {
+      size_t visited[MAX_CELLS];
+      size_t numVisited = 0;
+      for (int y = entry.minY; y <= entry.maxY; ++y)
+      {
+        for (int x = entry.minX; x <= entry.maxX; ++x)
+        {
+          size_t bucket = Bucket(x, y);
+          bool isVisited = false;
+          for (size_t i = 0; i < numVisited && !isVisited; ++i)
+          {
+            isVisited = visited[i] == bucket;
+          }
+          if (!isVisited)
+          {
+            visited[numVisited++] = bucket;
+            func(bucket);
+          }
+        }
+      }
+    }
+
+    void Link(Data& grid, Entity::id entity, const Entry& entry)
+    {
+      if (entry.oversized)
+      {
+        grid.oversized.PushBack(entity);
+        return;
+      }
+      EachBucket(entry, [&grid, entity](size_t bucket) {
+        uint32_t node = grid.freeNodes;
+        if (node != INVALID)
+        {
+          grid.freeNodes = grid.nodes[node].next;
+        }
+        else
+        {
+          node = (uint32_t)grid.nodes.size;
+          grid.nodes.PushBack({});
+        }
+        grid.nodes[node] = {entity, grid.buckets[bucket]};
+        grid.buckets[bucket] = node;
+      });
+    }
+
+    void Unlink(Data& grid, Entity::id entity, const Entry& entry)
+    {
+      if (entry.oversized)
+      {
+        size_t index = grid.oversized.Find(entity);
+        grid.oversized[index] = grid.oversized[grid.oversized.size - 1];
+        grid.oversized.PopBack();
+        return;
+      }
+      EachBucket(entry, [&grid, entity](size_t bucket) {
+        uint32_t* link = &grid.buckets[bucket];
+        while (*link != INVALID && grid.nodes[*link].entity != entity)
+        {
+          link = &grid.nodes[*link].next;
+        }
+        if (*link == INVALID)
+        {
+          return;
+        }
+        uint32_t node = *link;
+        *link = grid.nodes[node].next;
+        grid.nodes[node] = {Entity::MAX, grid.freeNodes};
+        grid.freeNodes = node;
+      });
+    }
+  }
+
+  void Init(Data& grid, float cellSize)
+  {
+    grid.cellSize = cellSize;
+    grid.buckets = SceneDynamicArray<uint32_t>(true, NUM_BUCKETS);
+    grid.buckets.size = NUM_BUCKETS;
+    grid.buckets.Fill(INVALID);
+    grid.nodes = SceneDynamicArray<Node>(true, Entity::PAGE_SIZE);
+    grid.freeNodes = INVALID;
+    grid.oversized = SceneDynamicArray<Entity::id>();
+    grid.entries.Init();
+    grid.size = 0;
+  }
+
+  void Update(Data& grid, Entity::id entity, const Math::Vec4f& bounds)
+  {
+    if (!IsInitialized(grid))
+    {
+      Init(grid, grid.cellSize);
+    }
+
+    Entry next{bounds};
+    float numCellsX = (bounds.z - bounds.x) / grid.cellSize + 1.f;
+    float numCellsY = (bounds.w - bounds.y) / grid.cellSize + 1.f;
+    next.oversized = !(numCellsX * numCellsY <= (float)MAX_CELLS);
+    if (!next.oversized)
+    {
+      next.minX = Cell(grid, bounds.x);
+      next.minY = Cell(grid, bounds.y);
+      next.maxX = Cell(grid, bounds.z);
+      next.maxY = Cell(grid, bounds.w);
+      // Rounding can add a row or column of cells
+      next.oversized = (size_t)(next.maxX - next.minX + 1) * (next.maxY - next.minY + 1) > MAX_CELLS;
+    }
+    next.inserted = true;
+
+    auto& entry = grid.entries.At(entity);
+    if (entry.inserted && entry.oversized == next.oversized && entry.minX == next.minX &&
+        entry.minY == next.minY && entry.maxX == next.maxX && entry.maxY == next.maxY)
+    {
+      // Same cells, only the bounds used for filtering change
+      entry.bounds = bounds;
+      return;
+    }
+
+    if (entry.inserted)
+    {
+      Unlink(grid, entity, entry);
+    }
+    else
+    {
+      ++grid.size;
+    }
+    entry = next;
+    Link(grid, entity, entry);
+  }
+
+  void Remove(Data& grid, Entity::id entity)
+  {
+    if (!IsInitialized(grid) || !grid.entries[entity].inserted)
+    {
+      return;
+    }
+    auto& entry = grid.entries.At(entity);
+    Unlink(grid, entity, entry);
+    entry = {};
+    --grid.size;
+  }
+}
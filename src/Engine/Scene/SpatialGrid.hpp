@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "STDPCH.hpp" // IWYU pragma: keep
+#include "Entity.hpp"
+#include "Math.hpp"
+#include "MemoryManager.hpp"
+#include "PagedArray.hpp"
+
+// Uniform grid over 2D bounds (minX, minY, maxX, maxY) for point queries.
+// Cells are hashed into a fixed number of buckets so the grid doesn't need world extents.
+// Entities covering more than MAX_CELLS cells go into a list every query checks instead.
+namespace Temp::SpatialGrid
+{
+  constexpr size_t NUM_BUCKETS = 4096;
+  constexpr size_t MAX_CELLS = 64;
+  constexpr uint32_t INVALID = UINT32_MAX;
+
+  struct Node
+  {
+    Entity::id entity{Entity::MAX};
+    uint32_t next{INVALID};
+
+    bool operator==(const Node& other) const = default;
+  };
+
+  struct Entry
+  {
+    Math::Vec4f bounds{};
+    // Cell range the entity is linked into
+    int minX{0};
+    int minY{0};
+    int maxX{0};
+    int maxY{0};
+    bool inserted{false};
+    bool oversized{false};
+
+    bool operator==(const Entry& other) const = default;
+  };
+
+  struct Data
+  {
+    float cellSize{8.f};
+    // Value = First node | Index = Hashed cell
+    SceneDynamicArray<uint32_t> buckets{};
+    SceneDynamicArray<Node> nodes{};
+    uint32_t freeNodes{INVALID};
+    SceneDynamicArray<Entity::id> oversized{};
+    // Value = Entry | Index = Entity
+    ScenePagedArray<Entry, Entity::PAGE_SIZE, Entity::NUM_PAGES> entries{};
+    size_t size{0};
+
+    bool operator==(const Data& other) const = default;
+  };
+
+  void Init(Data& grid, float cellSize = 8.f);
+  [[nodiscard]] inline bool IsInitialized(const Data& grid) { return grid.buckets.size == NUM_BUCKETS; }
+  // Inserts the entity or moves it to its new bounds
+  void Update(Data& grid, Entity::id entity, const Math::Vec4f& bounds);
+  void Remove(Data& grid, Entity::id entity);
+
+  [[nodiscard]] inline bool Contains(const Math::Vec4f& bounds, float x, float y)
+  {
+    return x >= bounds.x && y >= bounds.y && x <= bounds.z && y <= bounds.w;
+  }
+
+  [[nodiscard]] inline int Cell(const Data& grid, float value)
+  {
+    return Math::Floor(Math::Max(Math::Min(value / grid.cellSize, 1e9f), -1e9f));
+  }
+
+  [[nodiscard]] inline size_t Bucket(int x, int y)
+  {
+    return ((uint32_t)x * 73856093u ^ (uint32_t)y * 19349663u) & (NUM_BUCKETS - 1);
+  }
+
+  // func(Entity::id) for every entity whose bounds contain the point. Entities are only
+  // reported once, in no particular order.
+  template <typename F>
+  inline void Query(const Data& grid, float x, float y, F&& func)
+  {
+    if (!IsInitialized(grid))
+    {
+      return;
+    }
+    int cellX = Cell(grid, x);
+    int cellY = Cell(grid, y);
+    for (uint32_t node = grid.buckets[Bucket(cellX, cellY)]; node != INVALID;
+         node = grid.nodes[node].next)
+    {
+      Entity::id entity = grid.nodes[node].entity;
+      const auto& entry = grid.entries[entity];
+      // Buckets are shared between cells so the bounds filter hash collisions too
+      if (Contains(entry.bounds, x, y))
+      {
+        func(entity);
+      }
+    }
+    for (auto entity : grid.oversized)
+    {
+      if (Contains(grid.entries[entity].bounds, x, y))
+      {
+        func(entity);
+      }
+    }
+  }
+}
@@ -3,10 +3,10 @@
 
 #pragma once
 
-#include "String.hpp"
-#include "Logger.hpp"
-#include "Array.hpp" // IWYU pragma: keep
+#include <cstdint>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 namespace Temp::TGA
 {
@@ -29,47 +29,50 @@ namespace Temp::TGA
 #pragma pack(pop)
 
   // NOTE: Exporting from Krita requires to flip the image to come right-side up here
-  inline bool Read(const String& filename, Header& header, DynamicArray<uint8_t>& pixels)
+  // Doesn't log or touch any arena so it can run on any thread. Returns the pixels malloc'd for
+  // the caller to free, or nullptr with error set.
+  inline uint8_t* Read(const char* filename, Header& header, const char*& error)
   {
     int components;
-    DynamicArray<uint8_t> bufferedPixels;
-    FILE* file = fopen(filename.c_str(), "rb");
-    
+    size_t size;
+    uint8_t* pixels = nullptr;
+    FILE* file = fopen(filename, "rb");
+
     if (!file)
     {
-      Logger::LogErr(String("[TGA] Could not open file: ") + filename);
-      return false;
+      error = "Could not open file";
+      return nullptr;
     }
 
     if (fread(&header, sizeof(Header), 1, file) != 1)
     {
-      Logger::LogErr(String("[TGA] Failed to read header for file: ") + filename);
+      error = "Failed to read header for file";
       goto end;
     }
 
-    // std::cout << header.width << std::endl;
-
     // Ensure the image type is uncompressed RGB (2 or 10)
     if (header.imageType != 2 && header.imageType != 10)
     {
-      Logger::LogErr(String("[TGA] Unsupported TGA image type: ") +
-                     String::ToString(static_cast<int>(header.imageType)));
+      error = "Unsupported TGA image type";
       goto end;
     }
 
     // Move the file pointer to the pixel data
     if (fseek(file, header.idLength + sizeof(struct Header), SEEK_SET) != 0)
     {
-      Logger::LogErr(String("[TGA] Failed to seek to pixel data."));
+      error = "Failed to seek to pixel data";
       goto end;
     }
 
     // Read pixel data
     components = header.bitsPerPixel / 8;
-    bufferedPixels.Resize((size_t)(header.width * header.height * components));
-    if (fread(bufferedPixels.buffer, 1, bufferedPixels.size, file) != bufferedPixels.size)
+    size = (size_t)(header.width * header.height * components);
+    pixels = static_cast<uint8_t*>(malloc(size));
+    if (!pixels || fread(pixels, 1, size, file) != size)
     {
-      Logger::LogErr(String("[TGA] Failed to read pixel data."));
+      error = "Failed to read pixel data";
+      free(pixels);
+      pixels = nullptr;
       goto end;
     }
 
@@ -77,24 +80,28 @@ namespace Temp::TGA
     // If so, flip it
     if ((header.imageDescriptor & (1 << 3)) == 0 && (header.imageDescriptor & (1 << 4)) == 0)
     {
-      pixels.Resize(bufferedPixels.size);
-      for (int r = 0; r < header.height; ++r)
+      size_t rowSize = (size_t)(components * header.width);
+      auto* row = static_cast<uint8_t*>(malloc(rowSize));
+      if (!row)
       {
-        unsigned char* src = &bufferedPixels.buffer[r * components * header.width];
-        unsigned char* dst = &pixels.buffer[(header.height - r - 1) * components * header.width];
-        memcpy(dst, src, components * header.width);
+        error = "Failed to flip pixel data";
+        free(pixels);
+        pixels = nullptr;
+        goto end;
       }
+      for (int r = 0; r < header.height / 2; ++r)
+      {
+        uint8_t* top = pixels + r * rowSize;
+        uint8_t* bottom = pixels + (header.height - r - 1) * rowSize;
+        memcpy(row, top, rowSize);
+        memcpy(top, bottom, rowSize);
+        memcpy(bottom, row, rowSize);
+      }
+      free(row);
     }
-    else
-    {
-      pixels = std::move(bufferedPixels);
-    }
-
-    fclose(file);
-    return true;
 
 end:
     fclose(file);
-    return false;
+    return pixels;
   }
 }
\ No newline at end of file
@@ -7,8 +7,11 @@ namespace Temp::ThreadPool
 {
   namespace
   {
+    thread_local bool isWorker = false;
+
     void WorkerThread(Data& threadPool, int /*id*/)
     {
+      isWorker = true;
       while (true)
       {
         Task task;
@@ -26,8 +29,10 @@ namespace Temp::ThreadPool
             task = threadPool.tasks.Front();
             threadPool.tasks.Pop();
           }
+          // Marking active while still locked so Wait can't see an empty queue
+          // before this task has started
+          threadPool.activeThreads.fetch_add(1);
         }
-        threadPool.activeThreads.fetch_add(1);
         if (task.func && task.data)
         {
           task.func(task.data);
@@ -118,12 +123,15 @@ namespace Temp::ThreadPool
 
   void Wait(Data& threadPool)
   {
+    assert(!isWorker && "[ThreadPool] Wait: Called from a worker thread!");
     while (IsActive(threadPool))
     {
       Poll(threadPool);
     }
   }
 
+  bool IsWorker() { return isWorker; }
+
   // NOTE: Keeping for reference in case it's needed later
   // template <typename Collection, typename Function>
   // inline void EnqueueForEach(Data& threadPool, Collection& collection, Function&& f)
@@ -36,7 +36,10 @@ namespace Temp::ThreadPool
   void Destruct(Data& threadPool);
   void RecreateThreads(Data& threadPool, size_t collectionSize);
   bool IsActive(Data& threadPool);
+  // Must not be called from a worker, it counts itself as active and would wait forever
   void Wait(Data& threadPool);
+  // True on the worker threads of any pool
+  [[nodiscard]] bool IsWorker();
 
   inline void Enqueue(Data& threadPool, void(*f)(void*), void* data)
   {
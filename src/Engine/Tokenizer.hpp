@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "STDPCH.hpp" // IWYU pragma: keep
+#include <charconv>
+#include <string_view>
+
+// Single pass over a text buffer that hands out views into it, nothing gets copied or allocated.
+// Views are only valid for as long as the buffer is.
+namespace Temp::Tokenizer
+{
+  constexpr const char* WHITESPACE = " \r\n\t\v\f";
+
+  struct Data
+  {
+    const char* cursor{nullptr};
+    const char* end{nullptr};
+    // Current line without surrounding whitespace
+    std::string_view line{};
+    int lineNumber{0};
+  };
+
+  inline void Init(Data& tokenizer, const char* buffer, size_t length)
+  {
+    tokenizer.cursor = buffer;
+    tokenizer.end = buffer + length;
+    tokenizer.line = {};
+    tokenizer.lineNumber = 0;
+  }
+
+  inline std::string_view Trim(std::string_view view)
+  {
+    size_t start = view.find_first_not_of(WHITESPACE);
+    if (start == std::string_view::npos)
+    {
+      return {};
+    }
+    return view.substr(start, view.find_last_not_of(WHITESPACE) - start + 1);
+  }
+
+  inline bool IsIgnored(std::string_view line)
+  {
+    return line.empty() || line.starts_with("//");
+  }
+
+  // The last line doesn't need a trailing newline
+  inline bool NextLine(Data& tokenizer)
+  {
+    if (tokenizer.cursor >= tokenizer.end)
+    {
+      tokenizer.line = {};
+      return false;
+    }
+    const char* start = tokenizer.cursor;
+    const char* newLine =
+      static_cast<const char*>(memchr(start, '\n', (size_t)(tokenizer.end - start)));
+    const char* lineEnd = newLine ? newLine : tokenizer.end;
+    tokenizer.cursor = newLine ? newLine + 1 : tokenizer.end;
+    tokenizer.line = Trim(std::string_view(start, (size_t)(lineEnd - start)));
+    ++tokenizer.lineNumber;
+    return true;
+  }
+
+  // Skips empty lines and comments
+  inline bool NextContentLine(Data& tokenizer)
+  {
+    while (NextLine(tokenizer))
+    {
+      if (!IsIgnored(tokenizer.line))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Splits at the first delimiter, value is everything after it
+  inline bool Split(std::string_view line, std::string_view delimiter, std::string_view& key, std::string_view& value)
+  {
+    size_t pos = line.find(delimiter);
+    if (pos == std::string_view::npos)
+    {
+      return false;
+    }
+    key = line.substr(0, pos);
+    value = line.substr(pos + delimiter.size());
+    return true;
+  }
+
+  // Pops the next whitespace separated token off of rest
+  inline std::string_view NextToken(std::string_view& rest)
+  {
+    size_t start = rest.find_first_not_of(WHITESPACE);
+    if (start == std::string_view::npos)
+    {
+      rest = {};
+      return {};
+    }
+    size_t end = rest.find_first_of(WHITESPACE, start);
+    std::string_view token = rest.substr(start, end == std::string_view::npos ? end : end - start);
+    rest = end == std::string_view::npos ? std::string_view{} : rest.substr(end);
+    return token;
+  }
+
+  // Parses a leading number like atoi/strtof would, trailing characters are ignored. Returns false
+  // when token doesn't start with a number.
+  template <typename T>
+  inline bool Parse(std::string_view token, T& out)
+  {
+    token = Trim(token);
+    if (token.starts_with('+'))
+    {
+      token.remove_prefix(1);
+    }
+    if constexpr (std::is_same_v<T, bool>)
+    {
+      int value = 0;
+      auto result = std::from_chars(token.data(), token.data() + token.size(), value);
+      out = value != 0;
+      return result.ec == std::errc();
+    }
+    else
+    {
+      auto result = std::from_chars(token.data(), token.data() + token.size(), out);
+      return result.ec == std::errc();
+    }
+  }
+
+  // Parses exactly count whitespace separated numbers
+  template <typename T>
+  inline bool ParseAll(std::string_view tokens, T* out, int count)
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      if (!Parse(NextToken(tokens), out[i]))
+      {
+        return false;
+      }
+    }
+    return NextToken(tokens).empty();
+  }
+}
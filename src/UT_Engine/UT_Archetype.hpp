@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Archetype.hpp"
+#include "ComponentType.hpp"
+#include "Entity.hpp"
+#include "EntityData.hpp"
+#include "Math.hpp"
+#include "Scene.hpp"
+#include "SceneView.hpp"
+#include "UT_Common.hpp"
+
+namespace Temp::Archetype::UnitTests
+{
+  inline void RunScene(Entity::Storage::Type storage, const char* name, int numEntities)
+  {
+    using namespace Component::Type;
+
+    Scene::SceneFns sceneFns;
+    Scene::Data scene;
+    scene.sceneFns = &sceneFns;
+    scene.entityData.storage = storage;
+    Scene::Initialize(scene);
+
+    for (int i = 0; i < numEntities; ++i)
+    {
+      Entity::id entity = Scene::CreateEntity(scene);
+      Scene::AddComponent<POSITION2D>(scene, entity, {(float)i, 0});
+      Scene::AddComponent<SCALE>(scene, entity, {1, 1});
+    }
+
+    {
+      auto timer = Timer(std::string("View<POSITION2D, SCALE> ") + name);
+      for (auto [entity, position, scale] : Scene::View<POSITION2D, SCALE>(scene))
+      {
+        position = position + scale;
+      }
+    }
+
+    {
+      auto timer = Timer(std::string("Each<POSITION2D, SCALE> ") + name);
+      Scene::Each(Scene::View<POSITION2D, SCALE>(scene),
+                  [](Entity::id, Math::Vec2f& position, Math::Vec2f& scale) {
+                    position = position + scale;
+                  });
+    }
+
+    AssertEqual(String("Test Archetype Benchmark Applied ") + name,
+                Scene::Get<POSITION2D>(scene, 2),
+                Math::Vec2f{4, 2});
+
+    Entity::Reset(scene.entityData);
+    Scene::Destroy(scene);
+  }
+
+  inline void Run()
+  {
+    using namespace Component::Type;
+
+    Entity::Data entityData;
+    entityData.storage = Entity::Storage::ARCHETYPE;
+    Entity::Init(entityData);
+
+    Entity::id a = Entity::Create(entityData);
+    Entity::id b = Entity::Create(entityData);
+    Entity::id c = Entity::Create(entityData);
+
+    Entity::AddComponent<POSITION2D>(entityData, a, {1, 1});
+    Entity::AddComponent<POSITION2D>(entityData, b, {2, 2});
+    Entity::AddComponent<POSITION2D>(entityData, c, {3, 3});
+    AssertEqual("Test Archetype Same Bits Share Table", entityData.archetypes.tables.size, 1ul);
+    AssertEqual("Test Archetype Table Rows", entityData.archetypes.tables[0].size, 3ul);
+
+    Entity::AddComponent<TEXT>(entityData, b, "Moved");
+    AssertEqual("Test Archetype Add Component Creates Table",
+                entityData.archetypes.tables.size,
+                2ul);
+    AssertEqual("Test Archetype Add Component Moves Row", entityData.archetypes.tables[0].size, 2ul);
+    AssertEqual("Test Archetype Moved Row Keeps Value",
+                Entity::Get<POSITION2D>(entityData, b),
+                Math::Vec2f{2, 2});
+    Assert("Test Archetype Moved Row New Value", Entity::Get<TEXT>(entityData, b) == "Moved");
+    AssertEqual("Test Archetype Hole Filled By Last Row",
+                Entity::Get<POSITION2D>(entityData, c),
+                Math::Vec2f{3, 3});
+    Assert("Test Archetype Sparse Set Stays Empty",
+           Entity::GetComponentArray<POSITION2D>(entityData).size == 0);
+
+    Entity::AddComponent<POSITION2D>(entityData, b, {5, 5});
+    AssertEqual("Test Archetype Overwrite Component",
+                Entity::Get<POSITION2D>(entityData, b),
+                Math::Vec2f{5, 5});
+
+    Entity::RemoveComponent<TEXT>(entityData, b);
+    AssertEqual("Test Archetype Remove Component Moves Row Back",
+                entityData.archetypes.tables[0].size,
+                3ul);
+    AssertEqual("Test Archetype Remove Component Empties Table",
+                entityData.archetypes.tables[1].size,
+                0ul);
+    Assert("Test Archetype Removed Component Not Found",
+           Archetype::Get<TEXT>(entityData.archetypes, b) == nullptr);
+
+    Entity::AddCacheComponent<POSITION2D>(entityData, a);
+    Assert("Test Archetype Cache Component Removes Row",
+           entityData.archetypes.locations[a].table == Archetype::INVALID);
+    Entity::RemoveCacheComponent<POSITION2D>(entityData, a);
+    AssertEqual("Test Archetype Cache Component Restored",
+                Entity::Get<POSITION2D>(entityData, a),
+                Math::Vec2f{1, 1});
+    // b lost its TEXT above
+    Entity::AddCacheComponent<TEXT>(entityData, b);
+    Assert("Test Archetype Cache Missing Component Ignored",
+           Entity::GetComponentArray<TEXT>(entityData).disabled.size == 0 &&
+             entityData.archetypes.locations[b].table == 0);
+
+    Entity::Destroy(entityData, c);
+    AssertEqual("Test Archetype Destroy Entity Removes Row",
+                entityData.archetypes.tables[0].size,
+                2ul);
+    AssertEqual("Test Archetype Destroy Keeps Other Rows",
+                Entity::Get<POSITION2D>(entityData, b),
+                Math::Vec2f{5, 5});
+
+    // Rows spilling over into more than one chunk
+    constexpr int numEntities = 10000;
+    for (int i = 0; i < numEntities; ++i)
+    {
+      Entity::id entity = Entity::Create(entityData);
+      Entity::AddComponent<POSITION2D>(entityData, entity, {(float)entity, 0});
+      Entity::AddComponent<SCALE>(entityData, entity, {1, 1});
+    }
+    ComponentBits mask{0};
+    SetBit(mask, POSITION2D);
+    SetBit(mask, SCALE);
+    AssertEqual("Test Archetype Count", Archetype::Count(entityData.archetypes, mask), (size_t)numEntities);
+
+    bool isMatching = true;
+    size_t count = 0;
+    Archetype::Each<POSITION2D, SCALE>(entityData.archetypes,
+                                       mask,
+                                       [&](Entity::id entity, Math::Vec2f& position, Math::Vec2f&) {
+                                         isMatching &= position.x == (float)entity;
+                                         ++count;
+                                       });
+    Assert("Test Archetype Each Across Chunks", isMatching);
+    AssertEqual("Test Archetype Each Count", count, (size_t)numEntities);
+
+    count = 0;
+    Archetype::Each<POSITION2D>(entityData.archetypes,
+                                mask,
+                                [&](Entity::id, Math::Vec2f&) { ++count; },
+                                100,
+                                numEntities - 100);
+    AssertEqual("Test Archetype Each Range", count, (size_t)numEntities - 200);
+
+    Entity::Reset(entityData);
+    Entity::Destruct(entityData);
+
+    // Same query with both storages
+    RunScene(Entity::Storage::SPARSE_SET, "Sparse Set", 100000);
+    RunScene(Entity::Storage::ARCHETYPE, "Archetype", 100000);
+  }
+}
@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Collision.hpp"
+#include "ComponentType.hpp"
+#include "Scene.hpp"
+#include "UT_Common.hpp"
+
+namespace Temp::Component::Collision::UnitTests
+{
+  inline size_t numBatches = 0;
+  inline size_t numBegin = 0;
+  inline size_t numStay = 0;
+  inline size_t numEnd = 0;
+  inline Event lastEvent{};
+
+  inline void Listener(Scene::Data&, const Event* events, size_t count)
+  {
+    ++numBatches;
+    numBegin = numStay = numEnd = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      numBegin += events[i].phase == Phase::BEGIN;
+      numStay += events[i].phase == Phase::STAY;
+      numEnd += events[i].phase == Phase::END;
+      lastEvent = events[i];
+    }
+  }
+
+  inline Entity::id AddBox(Scene::Data& scene, Math::Vec2f position, AABB aabb = {})
+  {
+    Entity::id entity = Scene::CreateEntity(scene);
+    Scene::AddComponent<Type::POSITION2D>(scene, entity, position);
+    Scene::AddComponent<Type::AABB_COLLIDER>(scene, entity, aabb);
+    return entity;
+  }
+
+  inline Entity::id AddCircle(Scene::Data& scene, Math::Vec2f position, Circle circle = {})
+  {
+    Entity::id entity = Scene::CreateEntity(scene);
+    Scene::AddComponent<Type::POSITION2D>(scene, entity, position);
+    Scene::AddComponent<Type::CIRCLE_COLLIDER>(scene, entity, circle);
+    return entity;
+  }
+
+  inline void Run()
+  {
+    using namespace Component::Type;
+
+    Scene::SceneFns sceneFns;
+    Scene::Data scene;
+    scene.sceneFns = &sceneFns;
+    Scene::Initialize(scene);
+    auto& collisions = scene.collisions;
+    AddListener(collisions, Listener);
+
+    AssertEqual("Test Collision Empty", Update(scene, collisions), 0ul);
+    AssertEqual("Test Collision No Events No Listener Call", numBatches, 0ul);
+
+    // Boxes
+    Entity::id box0 = AddBox(scene, {0, 0});
+    Entity::id box1 = AddBox(scene, {0.75f, 0.1f});
+    AssertEqual("Test Collision Box Box", Update(scene, collisions), 1ul);
+    Assert("Test Collision Box Box Begin", numBegin == 1 && numStay == 0 && numEnd == 0);
+    AssertEqual("Test Collision Listener Called Once", numBatches, 1ul);
+    Assert("Test Collision Box Box Pair", lastEvent.a == box0 && lastEvent.b == box1);
+    AssertEqual("Test Collision Box Box Normal", lastEvent.normal, Math::Vec2f{1, 0});
+    Assert("Test Collision Box Box Depth", Math::FloatEqual(lastEvent.depth, 0.25f));
+
+    Update(scene, collisions);
+    Assert("Test Collision Box Box Stay", numBegin == 0 && numStay == 1 && numEnd == 0);
+
+    Scene::Get<POSITION2D>(scene, box1) = {3, 0};
+    AssertEqual("Test Collision Box Box Separated", Update(scene, collisions), 0ul);
+    Assert("Test Collision Box Box End", numBegin == 0 && numStay == 0 && numEnd == 1);
+
+    // SCALE grows the collider
+    Scene::AddComponent<SCALE>(scene, box0, {6.f, 1.f});
+    AssertEqual("Test Collision Scale", Update(scene, collisions), 1ul);
+
+    // Layers
+    Scene::Get<AABB_COLLIDER>(scene, box1).mask = 2;
+    AssertEqual("Test Collision Layer Filtered", Update(scene, collisions), 0ul);
+    Scene::Get<AABB_COLLIDER>(scene, box0).layer = 3;
+    AssertEqual("Test Collision Layer Matching", Update(scene, collisions), 1ul);
+    Scene::DestroyEntity(scene, box0);
+    Scene::DestroyEntity(scene, box1);
+    Update(scene, collisions);
+    AssertEqual("Test Collision Destroyed End", numEnd, 1ul);
+
+    // Circles, the corners of their bounds overlap but the circles don't
+    Entity::id circle0 = AddCircle(scene, {10, 10});
+    Entity::id circle1 = AddCircle(scene, {10.8f, 10.8f});
+    AssertEqual("Test Collision Circle Circle Miss", Update(scene, collisions), 0ul);
+    Scene::Get<POSITION2D>(scene, circle1) = {10, 10.6f};
+    AssertEqual("Test Collision Circle Circle", Update(scene, collisions), 1ul);
+    // Entity ids get recycled, the normal points from the lower one
+    AssertEqual("Test Collision Circle Circle Normal",
+                lastEvent.normal,
+                Math::Vec2f{0, circle0 < circle1 ? 1.f : -1.f});
+    Assert("Test Collision Circle Circle Depth", Math::FloatEqual(lastEvent.depth, 0.4f));
+    Scene::DestroyEntity(scene, circle1);
+
+    // Circle against the corner of a box
+    Entity::id box2 = AddBox(scene, {10.9f, 10.9f});
+    AssertEqual("Test Collision Box Circle Corner Miss", Update(scene, collisions), 0ul);
+    Scene::Get<POSITION2D>(scene, box2) = {10.9f, 10};
+    AssertEqual("Test Collision Box Circle", Update(scene, collisions), 1ul);
+    Assert("Test Collision Box Circle Pair",
+           lastEvent.a == Math::Min(circle0, box2) && lastEvent.b == Math::Max(circle0, box2));
+    AssertEqual("Test Collision Box Circle Normal",
+                lastEvent.normal,
+                Math::Vec2f{circle0 < box2 ? 1.f : -1.f, 0});
+    Assert("Test Collision Box Circle Depth", Math::FloatEqual(lastEvent.depth, 0.1f));
+    Scene::DestroyEntity(scene, circle0);
+    Scene::DestroyEntity(scene, box2);
+    Update(scene, collisions);
+
+    // Many bodies against brute force
+    constexpr int numBodies = 20000;
+    srand(7);
+    for (int i = 0; i < numBodies; ++i)
+    {
+      Math::Vec2f position{(float)(rand() % 4000) * 0.1f, (float)(rand() % 4000) * 0.1f};
+      if (i % 2)
+      {
+        AddBox(scene, position, {{0.5f, 0.25f}});
+      }
+      else
+      {
+        AddCircle(scene, position, {0.4f});
+      }
+    }
+
+    size_t numPairs = 0;
+    {
+      auto timer = Timer("Collision Update 20k");
+      numPairs = Update(scene, collisions);
+    }
+    {
+      auto timer = Timer("Collision Update 20k Sorted");
+      Update(scene, collisions);
+    }
+
+    size_t numBruteForce = 0;
+    {
+      auto timer = Timer("Collision Brute Force 20k");
+      size_t count = collisions.bodies.size;
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        for (uint32_t j = i + 1; j < count; ++j)
+        {
+          Contact contact;
+          numBruteForce += Narrow(collisions, i, j, contact);
+        }
+      }
+    }
+    Assert("Test Collision Many Bodies Touch", numPairs > 0);
+    AssertEqual("Test Collision Many Bodies Matches Brute Force", numPairs, numBruteForce);
+    AssertEqual("Test Collision Many Bodies Stay", numStay, numPairs);
+
+    RemoveListener(collisions, Listener);
+    AssertEqual("Test Collision Remove Listener", collisions.numListeners, 0ul);
+
+    Entity::Reset(scene.entityData);
+    Scene::Destroy(scene);
+  }
+}
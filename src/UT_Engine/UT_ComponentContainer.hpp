@@ -17,7 +17,7 @@ namespace Temp::Component::Container::UnitTests
                ->array[0] == MapToComponentDataType<T>());
     Assert("Test Component Container Get Array",
            GetComponentArray<T>(data).array[0] == MapToComponentDataType<T>() &&
-             GetComponentArray<T>(data).array[Entity::MAX - 1] == MapToComponentDataType<T>());
+             GetComponentArray<T>(data).size == 0);
     Assert("Test Component Container Get Component from Entity",
            Get<T>(data, 15) == MapToComponentDataType<T>() &&
              Get<T>(data, Entity::MAX - 1) == MapToComponentDataType<T>());
@@ -37,9 +37,9 @@ namespace Temp::Component::Container::UnitTests
     bool isAllDataInitialized = true;
     auto* arrayData = static_cast<Temp::Component::ArrayData<MapToComponentDataType<T>>*>(
       data.components[T]);
+    isAllDataInitialized &= arrayData->sparseEntities.size == 0;
     for (Entity::id e = 0; e < Entity::MAX; ++e)
     {
-      isAllDataInitialized &= arrayData->sparseEntities[e] == Entity::MAX;
       isAllDataInitialized &= arrayData->sparseIndices[e] == SIZE_MAX;
     }
     Assert("Test Component Container Init", isAllDataInitialized);
@@ -62,9 +62,9 @@ namespace Temp::Component::Container::UnitTests
   {
     const auto* const arrayData =
       static_cast<Temp::Component::ArrayData<MapToComponentDataType<E>>*>(data.components[E]);
+    isInitialized &= arrayData->sparseEntities.size == 0;
     for (Entity::id e = 0; e < Entity::MAX; ++e)
     {
-      isInitialized &= arrayData->sparseEntities[e] == Entity::MAX;
       isInitialized &= arrayData->sparseIndices[e] == SIZE_MAX;
     }
   }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "ComponentData.hpp"
+#include "Drawable.hpp"
 #include "Entity.hpp"
 #include "UT_Common.hpp"
 
@@ -19,13 +20,13 @@ namespace Temp::Component::UnitTests
                              T Component6)
   {
     Init(data);
-    bool isAllDataInitialized = true;
+    bool isAllDataInitialized = data.size == 0 && data.sparseEntities.size == 0;
     for (Entity::id e = 0; e < Entity::MAX; ++e)
     {
-      isAllDataInitialized &= data.sparseEntities[e] == Entity::MAX;
       isAllDataInitialized &= data.sparseIndices[e] == SIZE_MAX;
     }
     Assert("Test ArrayData Init", isAllDataInitialized);
+    Assert("Test ArrayData Init No Pages", data.sparseIndices.numPages == 0);
 
     Set(data, 5, Component1);
     Set(data, 15, Component2);
@@ -63,10 +64,221 @@ namespace Temp::Component::UnitTests
     Assert("Test ArrayData Entity::id Destroyed Array",
            data.array[0] == Component1 && data.array[1] == Component4 && data.array[2] == T() &&
              data.array[3] == T());
+
+    Set(data, Entity::MAX - 1, Component2);
+    Assert("Test ArrayData Set Last Entity", Get(data, Entity::MAX - 1) == Component2 && data.size == 3);
+    Assert("Test ArrayData Pages Allocated On Demand",
+           data.sparseIndices.numPages == 2 && data.sparseIndices[Entity::MAX / 2] == SIZE_MAX);
+    Remove(data, Entity::MAX - 1);
+    Assert("Test ArrayData Remove Last Entity",
+           data.size == 2 && data.sparseIndices[Entity::MAX - 1] == SIZE_MAX);
+  }
+
+  inline void TestChanges()
+  {
+    ArrayData<int> data{};
+    Init(data);
+
+    uint32_t start = Tick();
+    Set(data, 1, 10);
+    Set(data, 2, 20);
+    Set(data, 3, 30);
+    AdvanceTick();
+    uint32_t frame = Tick();
+
+    auto count = [&data](uint32_t tick, bool added) {
+      int count = 0;
+      auto f = [&count](Entity::id, int&) { ++count; };
+      added ? AddedSince(data, tick, f) : ChangedSince(data, tick, f);
+      return count;
+    };
+    Assert("Test ArrayData Added Since", count(start, true) == 3 && count(frame, true) == 0);
+    Assert("Test ArrayData Nothing Changed", count(frame, false) == 0);
+
+    [[maybe_unused]] const int& read = Get(static_cast<const ArrayData<int>&>(data), 2);
+    Assert("Test ArrayData Const Get Is Not A Change", count(frame, false) == 0);
+
+    Get(data, 2) = 21;
+    Set(data, 3, 31);
+    Entity::id changed = 0;
+    ChangedSince(data, frame, [&changed](Entity::id entity, int&) { changed += entity; });
+    Assert("Test ArrayData Changed Since", count(frame, false) == 2 && changed == 5);
+
+    Remove(data, 1);
+    Assert("Test ArrayData Remove Keeps Versions",
+           count(frame, false) == 2 && count(start, true) == 2);
+    Entity::id removed = 0;
+    RemovedSince(data, frame, [&removed](Entity::id entity) { removed = entity; });
+    Assert("Test ArrayData Removed Since", removed == 1 && data.removed.size == 1);
+
+    AdvanceTick();
+    AdvanceTick();
+    TrimRemoved(data, Tick() - 1);
+    Assert("Test ArrayData Trim Removed", data.removed.size == 0);
+
+    Init(data);
+    Assert("Test ArrayData Init Clears Versions",
+           data.changed.size == 0 && data.added.size == 0 && data.removed.size == 0);
+  }
+
+  inline void TestSort()
+  {
+    ArrayData<int> data{};
+    Init(data);
+
+    Set(data, 4, 40);
+    Set(data, 1, 10);
+    Set(data, 3, 30);
+    Set(data, 2, 30);
+    Set(data, 0, 0);
+    AdvanceTick();
+    Get(data, 1) = 15;
+
+    auto key = [](const int& value) { return value; };
+    AssertEqual("Test ArrayData Sort Moved", Sort(data, key), 7ul);
+    bool isSorted = true;
+    bool isConsistent = true;
+    for (size_t i = 0; i < data.size; ++i)
+    {
+      isSorted &= i == 0 || data.array[i - 1] <= data.array[i];
+      isConsistent &= data.sparseIndices[data.sparseEntities[i]] == i;
+    }
+    Assert("Test ArrayData Sort Order", isSorted);
+    Assert("Test ArrayData Sort Sparse Indices", isConsistent);
+    Assert("Test ArrayData Sort Is Stable", data.sparseEntities[2] == 3 && data.sparseEntities[3] == 2);
+    Assert("Test ArrayData Sort Keeps Values",
+           Get(static_cast<const ArrayData<int>&>(data), 1) == 15 &&
+             Get(static_cast<const ArrayData<int>&>(data), 4) == 40);
+    Entity::id changed = Entity::MAX;
+    ChangedSince(data, Tick(), [&changed](Entity::id entity, int&) { changed = entity; });
+    Assert("Test ArrayData Sort Keeps Versions", changed == 1 && data.sorted == Tick());
+
+    AssertEqual("Test ArrayData Sort Already Sorted", Sort(data, key), 0ul);
+    Get(data, 0) = 35;
+    AssertEqual("Test ArrayData Sort Incremental", Sort(data, key), 3ul);
+    Assert("Test ArrayData Sort Incremental Order",
+           data.sparseEntities[3] == 0 && data.sparseIndices[0] == 3);
+
+    // Large mostly sorted array
+    constexpr int numComponents = 100000;
+    ArrayData<int> large{};
+    Init(large);
+    for (int i = 0; i < numComponents; ++i)
+    {
+      Set(large, i, i);
+    }
+    for (int i = 0; i < numComponents; i += 1000)
+    {
+      Get(large, i) = i + 500;
+    }
+    {
+      auto timer = Timer("Sort Mostly Sorted 100000");
+      Sort(large, key);
+    }
+    isSorted = true;
+    for (size_t i = 1; i < large.size; ++i)
+    {
+      isSorted &= large.array[i - 1] <= large.array[i] &&
+                  large.sparseIndices[large.sparseEntities[i]] == i;
+    }
+    Assert("Test ArrayData Sort Large", isSorted);
+
+    // Reversed array, too far out of order for the insertion sort
+    ArrayData<int> reversed{};
+    Init(reversed);
+    for (int i = 0; i < numComponents; ++i)
+    {
+      Set(reversed, i, (numComponents - i) / 2);
+    }
+    {
+      auto timer = Timer("Sort Reversed 100000");
+      Sort(reversed, key);
+    }
+    isSorted = true;
+    bool isStable = true;
+    for (size_t i = 1; i < reversed.size; ++i)
+    {
+      isSorted &= reversed.array[i - 1] <= reversed.array[i] &&
+                  reversed.sparseIndices[reversed.sparseEntities[i]] == i;
+      isStable &= reversed.array[i - 1] != reversed.array[i] ||
+                  reversed.sparseEntities[i - 1] < reversed.sparseEntities[i];
+    }
+    Assert("Test ArrayData Sort Reversed", isSorted && reversed.sparseIndices[0] == reversed.size - 1);
+    Assert("Test ArrayData Sort Reversed Is Stable", isStable);
+  }
+
+  inline void TestDrawableSortKey()
+  {
+    using Drawable::SortKey;
+    auto drawable = [](float z, GLuint shaderProgram, GLuint texture) {
+      Drawable::Data data;
+      data.model.setTranslation({0, 0, z});
+      data.shaderProgram = shaderProgram;
+      data.texture = texture;
+      return data;
+    };
+    Assert("Test Drawable Sort Key Batches", SortKey(drawable(0, 3, 1)) < SortKey(drawable(0, 3, 2)) &&
+                                               SortKey(drawable(0, 3, 2)) < SortKey(drawable(0, 4, 1)));
+    Assert("Test Drawable Sort Key Opaque Ignores Depth",
+           SortKey(drawable(5.f, 3, 1)) < SortKey(drawable(-5.f, 3, 2)) &&
+             SortKey(drawable(5.f, 3, 2)) < SortKey(drawable(-5.f, 4, 1)));
+    auto blended = [&drawable](float z, GLuint shaderProgram, GLuint texture) {
+      auto data = drawable(z, shaderProgram, texture);
+      data.translucent = true;
+      return data;
+    };
+    Assert("Test Drawable Sort Key Depth", SortKey(blended(-2.f, 9, 9)) < SortKey(blended(-1.f, 1, 1)) &&
+                                             SortKey(blended(-1.f, 9, 9)) < SortKey(blended(0.5f, 1, 1)) &&
+                                             SortKey(blended(0.5f, 9, 9)) < SortKey(blended(2.f, 1, 1)));
+    auto text = drawable(-5.f, 1, 1);
+    text.translucent = true;
+    auto overlay = drawable(-5.f, 1, 1);
+    overlay.disableDepth = true;
+    Assert("Test Drawable Sort Key Blended Last",
+           SortKey(drawable(5.f, 9, 9)) < SortKey(text) && SortKey(drawable(5.f, 9, 9)) < SortKey(overlay));
+  }
+
+  inline void TestDisabled()
+  {
+    ArrayData<int> data{};
+    Init(data);
+    for (int i = 0; i < 8; ++i)
+    {
+      Set(data, i, i * 10);
+    }
+
+    for (Entity::id entity : {1, 3, 5})
+    {
+      SetCache(data, entity);
+      Remove(data, entity);
+    }
+    Assert("Test ArrayData Disabled Pool",
+           data.size == 5 && data.disabled.size == 3 && data.sparseIndices[3] == SIZE_MAX);
+    AssertEqual("Test ArrayData Get Disabled", Get(static_cast<const ArrayData<int>&>(data), 3), 30);
+
+    int component = GetCache(data, 1);
+    Assert("Test ArrayData Enable Moves Last Disabled",
+           component == 10 && data.disabled.size == 2 && data.disabledIndices[1] == SIZE_MAX &&
+             data.disabledEntities[data.disabledIndices[5]] == 5 &&
+             Get(static_cast<const ArrayData<int>&>(data), 5) == 50);
+    Set(data, 1, component);
+
+    EntityDestroyed(data, 3);
+    Assert("Test ArrayData Destroy Drops Disabled",
+           data.disabled.size == 1 && data.disabledIndices[3] == SIZE_MAX);
+
+    Init(data);
+    Assert("Test ArrayData Init Clears Disabled",
+           data.disabled.size == 0 && data.disabledIndices[5] == SIZE_MAX);
   }
 
   inline void Run()
   {
+    TestChanges();
+    TestSort();
+    TestDrawableSortKey();
+    TestDisabled();
+
     // Simple Component Test
     {
       ArrayData<int> intData{};
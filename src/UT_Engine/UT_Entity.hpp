@@ -15,12 +15,14 @@ namespace Temp::Entity::UnitTests
     Entity::Data entityData;
     Entity::Init(entityData);
 
-    AssertEqual("Test Entity Create id 0", Entity::Create(entityData), (unsigned short)0);
-    AssertEqual("Test Entity Create id 1", Entity::Create(entityData), (unsigned short)1);
+    AssertEqual("Test Entity Create id 0", Entity::Create(entityData), (Entity::id)0);
+    AssertEqual("Test Entity Create id 1", Entity::Create(entityData), (Entity::id)1);
     AssertEqual("Test Entity Create id Living Count", Entity::Count(entityData), 2ul);
 
     Entity::Destroy(entityData, 1);
     AssertEqual("Test Entity Destroy Entity", Entity::Count(entityData), 1ul);
+    AssertEqual("Test Entity Create Reuses Destroyed id", Entity::Create(entityData), (Entity::id)1);
+    Entity::Destroy(entityData, 1);
 
     Entity::id entity;
     for (int i = 0; i < 100; ++i)
@@ -37,6 +39,22 @@ namespace Temp::Entity::UnitTests
 
     AssertEqual("Test Entity Reset", Entity::Count(entityData), 0ul);
 
+    // Going past a single sparse page
+    constexpr Entity::id numEntities = Entity::PAGE_SIZE * 3;
+    for (Entity::id i = 0; i < numEntities; ++i)
+    {
+      entity = Entity::Create(entityData);
+      Entity::AddComponent<Component::Type::POSITION2D>(entityData, entity, {(float)i, 0.f});
+    }
+    AssertEqual("Test Entity Create Past Page", entity, numEntities - 1);
+    Assert("Test Entity Get Component Past Page",
+           Entity::Get<Component::Type::POSITION2D>(entityData, entity).x == (float)(numEntities - 1));
+    AssertEqual("Test Entity Component Array Size",
+                Entity::GetComponentArray<Component::Type::POSITION2D>(entityData).size,
+                (size_t)numEntities);
+
+    Entity::Reset(entityData);
+
     Entity::Destruct(entityData);
   }
 }
\ No newline at end of file
@@ -26,6 +26,12 @@ namespace Temp::Event::UnitTests
   inline void HoverLeave(Scene::Data&, Component::Hoverable::Data&) { isHoverLeave = true; }
   inline void ButtonReleased(Scene::Data&, Component::Hoverable::Data&) { isButtonReleased = true; }
 
+  inline float clickedDepth = 0;
+  inline void Clicked(Scene::Data&, Component::Hoverable::Data& hoverable)
+  {
+    clickedDepth = Component::Hoverable::Depth(hoverable);
+  }
+
   inline void Run()
   {
     Camera::SetProjection(Camera::Projection::ORTHOGRAPHIC);
@@ -77,6 +83,8 @@ namespace Temp::Event::UnitTests
     Assert("Test Event Hover Enter when Mouse in Hoverable", isHoverEnter && !isHoverLeave);
 
     hoverable.lastInside = true;
+    // The index caches the bounds on the stored hoverable
+    Component::Hoverable::UpdateCache(hoverable);
     Event::ButtonPressed(scene, EventData, 1, 0, 1);
     Assert("Test Event ButtonPressed when Mouse in Hoverable Draggable is valid",
            EventData.draggable);
@@ -141,6 +149,25 @@ namespace Temp::Event::UnitTests
     Assert("Test Event Hover Enter when Mouse in Hoverable Raycast", isHoverEnter && !isHoverLeave);
     Assert("Test Event ButtonReleased when Mouse is not in Hoverable Raycast", isButtonReleased);
 
+    // Overlapping hoverables, only the one on top gets the click
+    Component::Hoverable::Data top = {
+      .Click = Clicked,
+      .x = -1280,
+      .y = -720,
+      .width = 9999,
+      .height = 9999,
+      .scale = {1.f, 1.f},
+      .model = Math::Mat4{}.translate({0, 0, 2}),
+    };
+    Component::Hoverable::Data bottom = top;
+    bottom.model = Math::Mat4{}.translate({0, 0, 1});
+    Scene::AddComponent<Component::Type::HOVERABLE>(scene, Scene::CreateEntity(scene), top);
+    Scene::AddComponent<Component::Type::HOVERABLE>(scene, Scene::CreateEntity(scene), bottom);
+    Scene::SortGroups(scene);
+
+    Event::ButtonReleased(scene, EventData, 0, 0, 1);
+    AssertEqual("Test Event ButtonReleased Clicks Top Hoverable", clickedDepth, 2.f);
+
     Scene::Destruct(scene);
     Entity::Destruct(scene.entityData);
   }
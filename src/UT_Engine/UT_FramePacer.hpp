@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "FramePacer.hpp"
+#include "UT_Common.hpp"
+
+namespace Temp::FramePacer::UnitTests
+{
+  inline void Run()
+  {
+    Data pacer;
+    pacer.mode = Mode::UNLIMITED;
+    Assert("Test Frame Pacer Unlimited", FrameTime(pacer) == 0.f && SwapInterval(pacer) == 0);
+    pacer.mode = Mode::VSYNC;
+    Assert("Test Frame Pacer Vsync", FrameTime(pacer) == 0.f && SwapInterval(pacer) == 1);
+    pacer.isVsyncSupported = false;
+    Assert("Test Frame Pacer Vsync Unsupported",
+           Math::FloatEqual(FrameTime(pacer), 1.f / pacer.targetFps) && SwapInterval(pacer) == 0);
+    pacer.isVsyncSupported = true;
+    pacer.mode = Mode::TARGET_FPS;
+    pacer.targetFps = 100.f;
+    Assert("Test Frame Pacer Target", Math::FloatEqual(FrameTime(pacer), 0.01f));
+    pacer.isFocused = false;
+    Assert("Test Frame Pacer Unfocused", Math::FloatEqual(FrameTime(pacer), 1.f / pacer.backgroundFps));
+    pacer.isFocused = true;
+    pacer.isMinimized = true;
+    pacer.mode = Mode::VSYNC;
+    Assert("Test Frame Pacer Minimized", Math::FloatEqual(FrameTime(pacer), 1.f / pacer.backgroundFps));
+    pacer.backgroundFps = 0.f;
+    Assert("Test Frame Pacer No Background Limit", FrameTime(pacer) == 0.f);
+
+    Data stats;
+    Assert("Test Frame Pacer No Stats", GetStats(stats).numFrames == 0 && GetStats(stats).average == 0.f);
+    Record(stats, 0.01f);
+    Record(stats, 0.03f);
+    Stats result = GetStats(stats);
+    Assert("Test Frame Pacer Stats Average", Math::FloatEqual(result.average, 0.02f));
+    Assert("Test Frame Pacer Stats Jitter", Math::FloatEqual(result.jitter, 0.01f));
+    Assert("Test Frame Pacer Stats Range", result.min == 0.01f && result.max == 0.03f);
+    for (size_t i = 0; i < NUM_SAMPLES; ++i)
+    {
+      Record(stats, 0.02f);
+    }
+    result = GetStats(stats);
+    AssertEqual("Test Frame Pacer Stats Window", result.numFrames, NUM_SAMPLES);
+    Assert("Test Frame Pacer Stats Oldest Dropped", result.jitter == 0.f && result.min == 0.02f);
+
+    Data timed;
+    timed.mode = Mode::TARGET_FPS;
+    timed.targetFps = 500.f;
+    Reset(timed);
+    {
+      auto timer = Timer("Frame Pacer 20 Frames 500 FPS");
+      for (int i = 0; i < 20; ++i)
+      {
+        Pace(timed);
+      }
+    }
+    result = GetStats(timed);
+    AssertEqual("Test Frame Pacer Paced Frames", result.numFrames, 20ul);
+    // Waking up late is up to the OS, early never happens
+    Assert("Test Frame Pacer Not Early", result.min >= 0.002f);
+
+    timed.mode = Mode::UNLIMITED;
+    Reset(timed);
+    Assert("Test Frame Pacer Unlimited Doesn't Wait", Pace(timed) < 0.002f);
+  }
+}
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Camera.hpp"
+#include "ComponentType.hpp"
 #include "Hoverable.hpp"
 #include "Scene.hpp"
 #include "UT_Common.hpp"
@@ -70,6 +71,14 @@ namespace Temp::Component::Hoverable::UnitTests
                                       (float)Camera::GetWidth() / 2 - 1.f,
                                       (float)Camera::GetHeight() / 2 + 1.f));
 
+    // Moved without refreshing the cache, the public raycast still follows the model
+    hoverable2.model = Math::Mat4{}.translate({1000.f, 1000.f, 0.f});
+    Assert("Test Hoverable Raycast Follows Model",
+           !Hoverable::IsInsideRaycast(hoverable2,
+                                       (float)Camera::GetWidth() / 2 - 1.f,
+                                       (float)Camera::GetHeight() / 2 + 1.f));
+    hoverable2.model = Math::Mat4{};
+
     Component::Hoverable::Data hoverable3 = {
       .Click = nullptr,
       .HoverEnter = HoverEnter,
@@ -94,6 +103,120 @@ namespace Temp::Component::Hoverable::UnitTests
     AssertEqual("Test Hoverable Drag x", hoverable3.x, 35.f);
     AssertEqual("Test Hoverable Drag y", hoverable3.y, -35.f);
 
+    // Cached inverse, translate/scale models skip the full inverse
+    Component::Hoverable::Data hoverable4 = hoverable2;
+    hoverable4.model = Math::Mat4{}.translate({5, -3, 1}).scale({2, 4, 1});
+    UpdateCache(hoverable4);
+    Assert("Test Hoverable Cached Inverse Axis Aligned",
+           hoverable4.inverseModel == hoverable4.model.inverse());
+    AssertEqual("Test Hoverable Cached Bounds", hoverable4.bounds, Math::Vec4f{-9999, -9999, 9, 5});
+    hoverable4.model = hoverable4.model.rotateZ(0.5f);
+    UpdateCache(hoverable4);
+    Assert("Test Hoverable Cached Inverse Rotated",
+           hoverable4.inverseModel == hoverable4.model.inverse());
+
+    constexpr size_t numBounds = 37;
+    float minX[numBounds], minY[numBounds], maxX[numBounds], maxY[numBounds];
+    for (size_t i = 0; i < numBounds; ++i)
+    {
+      minX[i] = (float)i;
+      minY[i] = 0;
+      maxX[i] = (float)i + 1.5f;
+      maxY[i] = i % 2 ? 1.f : -1.f;
+    }
+    uint32_t mask[2] = {UINT32_MAX, UINT32_MAX};
+    AssertEqual("Test Hoverable HitMask Count",
+                HitMask(minX, minY, maxX, maxY, numBounds, {35.25f, 0.5f, 0, 1}, mask),
+                1ul);
+    Assert("Test Hoverable HitMask Bits", mask[0] == 0 && mask[1] == 1u << 3);
+    AssertEqual("Test Hoverable HitMask Edges",
+                HitMask(minX, minY, maxX, maxY, numBounds, {4.5f, 1.f, 0, 1}, mask),
+                1ul);
+    Assert("Test Hoverable HitMask Edges Bits", mask[0] == 1u << 3 && mask[1] == 0);
+
     delete scene;
   }
+
+  inline void RunIndex()
+  {
+    using namespace Component::Type;
+
+    Scene::SceneFns sceneFns;
+    Scene::Data scene;
+    scene.sceneFns = &sceneFns;
+    Scene::Initialize(scene);
+
+    constexpr int numEntities = 10000;
+    for (int i = 0; i < numEntities; ++i)
+    {
+      Entity::id entity = Scene::CreateEntity(scene);
+      Data hoverable{};
+      hoverable.HoverEnter = HoverEnter;
+      hoverable.HoverLeave = HoverLeave;
+      hoverable.x = (float)(i % 100) * 3;
+      hoverable.y = (float)(i / 100) * 3;
+      hoverable.width = 2;
+      hoverable.height = 2;
+      Scene::AddComponent<HOVERABLE>(scene, entity, hoverable);
+    }
+    // Covers everything
+    Entity::id background = Scene::CreateEntity(scene);
+    Scene::AddComponent<HOVERABLE>(scene, background, {.x = -1, .y = -1, .width = 400, .height = 400});
+
+    auto& hoverableArray = Scene::GetComponentArray<HOVERABLE>(scene);
+    IndexData& index = scene.hoverIndex;
+    Math::Vec4f point{31, 61, 0, 1};
+
+    size_t numBruteForce = 0;
+    {
+      auto timer = Timer("Hoverable Brute Force 10k");
+      for (size_t i = 0; i < hoverableArray.size; ++i)
+      {
+        numBruteForce += IsInside(hoverableArray.array[i], point);
+      }
+    }
+    UpdateIndex(scene, index);
+    {
+      auto timer = Timer("Hoverable Index Query 10k");
+      Query(scene, index, point);
+    }
+    index.mask.Reserve((index.minX.size + 31) / 32);
+    {
+      auto timer = Timer("Hoverable HitMask 10k");
+      size_t numHits = HitMask(index.minX.buffer,
+                               index.minY.buffer,
+                               index.maxX.buffer,
+                               index.maxY.buffer,
+                               index.minX.size,
+                               point,
+                               index.mask.buffer);
+      AssertEqual("Test Hoverable HitMask Matches Brute Force", numHits, numBruteForce);
+    }
+    AssertEqual("Test Hoverable Index Matches Brute Force", index.candidates.size, numBruteForce);
+    AssertEqual("Test Hoverable Index Query Count", index.candidates.size, 2ul);
+    Assert("Test Hoverable Index Query Entity",
+           hoverableArray.sparseEntities[index.candidates[0]] == 2010 &&
+             hoverableArray.sparseEntities[index.candidates[1]] == background);
+
+    ResetBools();
+    Hover(scene, index, point);
+    Assert("Test Hoverable Index Hover Enter", isHoverEnter && index.hovered.size == 2);
+
+    // Moving the hoverable away makes the mouse leave it
+    ResetBools();
+    Component::AdvanceTick();
+    Scene::Get<HOVERABLE>(scene, 2010).x = 200;
+    Hover(scene, index, point);
+    Assert("Test Hoverable Index Hover Leave Moved", isHoverLeave && index.hovered.size == 1);
+
+    ResetBools();
+    Component::AdvanceTick();
+    Scene::DestroyEntity(scene, background);
+    Hover(scene, index, point);
+    AssertEqual("Test Hoverable Index Removed", index.grid.size, (size_t)numEntities);
+    Assert("Test Hoverable Index Hover Nothing", index.hovered.size == 0 && !isHoverEnter);
+
+    Entity::Reset(scene.entityData);
+    Scene::Destroy(scene);
+  }
 }
@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "EngineUtils.hpp"
+#include "LevelBinary.hpp"
+#include "LevelSerializer.hpp"
+#include "Scene.hpp"
+#include "UT_Common.hpp"
+#include "UT_LevelSerializer.hpp"
+
+namespace Temp::LevelSerializer::Binary::UnitTests
+{
+  using LevelSerializer::UnitTests::IsEqual;
+  using LevelSerializer::UnitTests::WriteLevel;
+
+  inline void Run()
+  {
+    SceneObject::Init();
+    Scene::SceneFns sceneFns;
+    Scene::Data scene;
+    scene.sceneFns = &sceneFns;
+    Entity::Init(scene.entityData);
+
+    Assert("Test Binary Deserialize Text", LevelSerializer::Deserialize(scene, "Test.level"));
+    Assert("Test Binary Write", Write(scene, "Test.blevel"));
+    Assert("Test Binary Up To Date", IsUpToDate("Test.blevel", "Test.level"));
+    Assert("Test Binary Missing Not Up To Date", !IsUpToDate("Missing.blevel", "Test.level"));
+    auto textObjects = scene.objects;
+    Assert("Test Binary Load", Load(scene, "Test.blevel"));
+    AssertEqual("Test Binary Load Size", scene.objects.size, textObjects.size);
+    for (size_t i = 0; i < textObjects.size; ++i)
+    {
+      Assert("Test Binary Load Object", IsEqual(scene.objects[i], textObjects[i]));
+    }
+    AssertEqual("Test Binary Load Name Table", scene.objectsNameIdxTable["NumberGameTextButton"], 1);
+    CleanupScene(scene);
+
+    // Truncated files are rejected
+    auto path = AssetsDirectory() / "Levels" / "Test.blevel";
+    FILE* fp = fopen(path.c_str(), "r+b");
+    fseek(fp, 0, SEEK_END);
+    long length = ftell(fp);
+    fclose(fp);
+    Assert("Test Binary Truncate", truncate(path.c_str(), length - 4) == 0);
+    Assert("Test Binary Load Truncated", !Load(scene, "Test.blevel"));
+    Path::Remove(path);
+
+    // Same level in both formats
+    constexpr int numObjects = 50000;
+    WriteLevel("Bench.level", numObjects);
+    {
+      auto timer = Timer("Level Load Text 50k");
+      Assert("Test Binary Bench Deserialize Text", LevelSerializer::Deserialize(scene, "Bench.level"));
+    }
+    {
+      auto timer = Timer("Level Compile 50k");
+      Assert("Test Binary Bench Write", Write(scene, "Bench.blevel"));
+    }
+    textObjects = scene.objects;
+    {
+      auto timer = Timer("Level Load Binary 50k");
+      Assert("Test Binary Bench Load", Load(scene, "Bench.blevel"));
+    }
+    AssertEqual("Test Binary Bench Size", scene.objects.size, (size_t)numObjects);
+    bool isMatching = textObjects.size == scene.objects.size;
+    for (size_t i = 0; isMatching && i < textObjects.size; ++i)
+    {
+      isMatching &= IsEqual(scene.objects[i], textObjects[i]);
+    }
+    Assert("Test Binary Bench Matches Text", isMatching);
+    AssertEqual("Test Binary Bench Name Table", scene.objectsNameIdxTable[""], numObjects - 1);
+    Path::Remove(AssetsDirectory() / "Levels" / "Bench.level");
+    Path::Remove(AssetsDirectory() / "Levels" / "Bench.blevel");
+
+    CleanupScene(scene);
+    Entity::Destruct(scene.entityData);
+    // Both 50k levels take up a good part of the scene arena
+    MemoryManager::data.FreeAll();
+  }
+}
@@ -8,10 +8,89 @@
 #include "UT_Common.hpp"
 #include "LevelSerializer.hpp"
 #include "TextBox.hpp"
+#include "Sprite.hpp"
 #include "TextButton.hpp"
 
 namespace Temp::LevelSerializer::UnitTests
 {
+  inline bool IsEqual(const TextBox::Data& a, const TextBox::Data& b)
+  {
+    return a.text == b.text && a.fontType == b.fontType && a.maxCharactersPerLine == b.maxCharactersPerLine;
+  }
+
+  inline bool IsEqual(const TextBox::ConstructData& a, const TextBox::ConstructData& b)
+  {
+    return a.x == b.x && a.y == b.y && a.scale == b.scale;
+  }
+
+  inline bool IsEqual(const SceneObject::Data& a, const SceneObject::Data& b)
+  {
+    if (a.name != b.name || a.type != b.type || a.shaderType != b.shaderType)
+    {
+      return false;
+    }
+    switch (a.type)
+    {
+      case EntityType::TEXTBOX:
+        return IsEqual(*static_cast<TextBox::Data*>(a.data), *static_cast<TextBox::Data*>(b.data)) &&
+               IsEqual(*static_cast<TextBox::ConstructData*>(a.constructData),
+                       *static_cast<TextBox::ConstructData*>(b.constructData));
+      case EntityType::TEXTBUTTON:
+      {
+        const auto& ctorA = *static_cast<TextButton::ConstructData*>(a.constructData);
+        const auto& ctorB = *static_cast<TextButton::ConstructData*>(b.constructData);
+        return IsEqual(static_cast<TextButton::Data*>(a.data)->textBox,
+                       static_cast<TextButton::Data*>(b.data)->textBox) &&
+               IsEqual(ctorA.textBoxCtorData, ctorB.textBoxCtorData) && ctorA.hoverable.x == ctorB.hoverable.x &&
+               ctorA.hoverable.y == ctorB.hoverable.y && ctorA.hoverable.width == ctorB.hoverable.width &&
+               ctorA.hoverable.height == ctorB.hoverable.height && ctorA.hoverable.scale == ctorB.hoverable.scale;
+      }
+      case EntityType::SPRITE:
+      {
+        const auto& ctorA = *static_cast<Sprite::ConstructData*>(a.constructData);
+        const auto& ctorB = *static_cast<Sprite::ConstructData*>(b.constructData);
+        return static_cast<Sprite::Data*>(a.data)->fileName == static_cast<Sprite::Data*>(b.data)->fileName &&
+               ctorA.pos == ctorB.pos && ctorA.scale == ctorB.scale;
+      }
+      default:
+        return false;
+    }
+  }
+
+  // Unnamed like a generated tile layer, the name table only fits OBJECT_NAME_TABLE_SIZE / 2 names
+  inline void WriteLevel(const char* file, int numObjects)
+  {
+    FILE* fp = fopen((AssetsDirectory() / "Levels" / file).c_str(), "wb");
+    for (int i = 0; i < numObjects; ++i)
+    {
+      float x = (float)(i % 1000) * 0.5f;
+      float y = (float)(i / 1000) * 0.25f;
+      switch (i % 3)
+      {
+        case 0:
+          fprintf(fp,
+                  "TextBox\n{\n  Shader: 1\n  Position: %g %g\n  Scale: 0.04\n"
+                  "  Text: Text %d\n  Font: 1\n  CharacterLimit: 32\n}\n\n",
+                  x, y, i);
+          break;
+        case 1:
+          fprintf(fp,
+                  "TextButton\n{\n  Shader: 1\n  TextBox\n  {\n    Position: %g %g\n"
+                  "    Scale: 0.0345\n    Text: Button %d\n  }\n\n  Hoverable\n  {\n    Position: %g %g\n"
+                  "    Size: 9 4\n    Scale: 1 1.5\n  }\n}\n\n",
+                  x, y, i, x, y);
+          break;
+        default:
+          fprintf(fp,
+                  "Sprite\n{\n  Shader: 2\n  Position: %g %g\n  Scale: 2 3\n"
+                  "  File: Sprite%d.tga\n}\n\n",
+                  x, y, i % 10);
+          break;
+      }
+    }
+    fclose(fp);
+  }
+
   inline void TestDeserialize(Scene::Data &scene, const String &testName, const char* file)
   {
     Assert(testName + " Test Level Parsing", Deserialize(scene, file));
@@ -68,4 +147,49 @@ namespace Temp::LevelSerializer::UnitTests
     CleanupScene(scene);
     Entity::Destruct(scene.entityData);
   }
+
+  inline void RunParallel()
+  {
+    SceneObject::Init();
+    Scene::SceneFns sceneFns;
+    Scene::Data scene;
+    scene.sceneFns = &sceneFns;
+    Entity::Init(scene.entityData);
+
+    constexpr int numObjects = 20000;
+    WriteLevel("Parallel.level", numObjects);
+    // No workers yet, so this is the sequential path
+    {
+      auto timer = Timer("Level Load Sequential 20k");
+      Assert("Test Parallel Deserialize Sequential", Deserialize(scene, "Parallel.level"));
+    }
+    auto sequentialObjects = scene.objects;
+
+    Entity::Destruct(scene.entityData);
+    Scene::Initialize(scene);
+    {
+      auto timer = Timer("Level Load Parallel 20k");
+      Assert("Test Parallel Deserialize", Deserialize(scene, "Parallel.level"));
+    }
+    AssertEqual("Test Parallel Size", scene.objects.size, sequentialObjects.size);
+    bool isMatching = scene.objects.size == sequentialObjects.size;
+    for (size_t i = 0; isMatching && i < scene.objects.size; ++i)
+    {
+      isMatching &= IsEqual(scene.objects[i], sequentialObjects[i]);
+    }
+    Assert("Test Parallel Matches Sequential In File Order", isMatching);
+    AssertEqual("Test Parallel Name Table", scene.objectsNameIdxTable[""], numObjects - 1);
+
+    // A broken last block falls back to the sequential path, which reports it
+    FILE* fp = fopen((AssetsDirectory() / "Levels" / "Parallel.level").c_str(), "ab");
+    fprintf(fp, "Sprite\n{\n  Position: 1\n}\n");
+    fclose(fp);
+    Assert("Test Parallel Invalid Block", !Deserialize(scene, "Parallel.level"));
+    AssertEqual("Test Parallel Invalid Block Objects", scene.objects.size, (size_t)numObjects);
+    Path::Remove(AssetsDirectory() / "Levels" / "Parallel.level");
+
+    CleanupScene(scene);
+    Scene::Destroy(scene);
+    MemoryManager::data.FreeAll();
+  }
 }
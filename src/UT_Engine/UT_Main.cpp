@@ -1,15 +1,32 @@
 // SPDX-FileCopyrightText: 2023 Ujwal Vujjini
 // SPDX-License-Identifier: MIT
 
+#include "UT_Archetype.hpp"
+#include "UT_Collision.hpp"
 #include "UT_ComponentContainer.hpp"
 #include "UT_ComponentData.hpp"
 #include "UT_Entity.hpp"
 #include "UT_Event.hpp"
+#include "UT_FramePacer.hpp"
 #include "UT_Hoverable.hpp"
+#include "UT_LevelBinary.hpp"
 #include "UT_LevelSerializer.hpp"
 #include "UT_Math.hpp"
+#ifndef __APPLE__
+#include "UT_NullRender.hpp"
+#endif
+#include "UT_Prefab.hpp"
 #include "UT_Scene.hpp"
+#include "UT_SceneCommands.hpp"
+#include "UT_SceneLoader.hpp"
+#include "UT_SceneSnapshot.hpp"
+#include "UT_SceneSystems.hpp"
+#include "UT_SceneView.hpp"
+#include "UT_SpatialGrid.hpp"
 #include "UT_ThreadPool.hpp"
+#include "UT_Tokenizer.hpp"
+#include "UT_Transform.hpp"
+#include "UT_Tween.hpp"
 
 #ifdef WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -29,12 +46,34 @@ int main()
   Component::UnitTests::Run();
   Component::Container::UnitTests::Run();
   Component::Hoverable::UnitTests::Run();
+  Component::Hoverable::UnitTests::RunIndex();
   Event::UnitTests::Run();
+  Tokenizer::UnitTests::Run();
   LevelSerializer::UnitTests::Run();
+  LevelSerializer::UnitTests::RunParallel();
+  LevelSerializer::Binary::UnitTests::Run();
+  Scene::Loader::UnitTests::Run();
   Logger::logType = Logger::LogType::NOOP;
   ThreadPool::UnitTests::Run();
   Scene::UnitTests::Run();
+  Scene::UnitTests::RunView();
+  Scene::UnitTests::RunPrepare();
+  Scene::Commands::UnitTests::Run();
+  Scene::Systems::UnitTests::Run();
+  Scene::Snapshots::UnitTests::Run();
+  SpatialGrid::UnitTests::Run();
+  Prefab::UnitTests::Run();
+  Component::Transform::UnitTests::Run();
+  Component::Transform::UnitTests::RunHierarchy();
+  Component::Transform::UnitTests::RunInterpolate();
+  Component::Collision::UnitTests::Run();
+  Component::Tween::UnitTests::Run();
   Entity::UnitTests::Run();
+  Archetype::UnitTests::Run();
+  FramePacer::UnitTests::Run();
+#ifndef __APPLE__
+  Render::Null::UnitTests::Run();
+#endif
 
   Logger::logType = Logger::LogType::COUT;
   std::cout << "Unit Tests Passed!" << std::endl;
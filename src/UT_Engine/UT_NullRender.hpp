@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Drawable.hpp"
+#include "NullRender.hpp"
+#include "Scene.hpp"
+#include "Shader.hpp"
+#include "UT_Common.hpp"
+
+namespace Temp::Render::Null::UnitTests
+{
+  inline void Count(Scene::Data&, void* data) { ++*static_cast<int*>(data); }
+
+  inline void Run()
+  {
+    Scene::SceneFns sceneFns;
+    Scene::Data scene;
+    scene.sceneFns = &sceneFns;
+    Scene::Initialize(scene);
+    Initialize(scene, 1280, 720);
+
+    Component::Drawable::Data drawable;
+    drawable.entity = Scene::CreateEntity(scene);
+    drawable.vertices = {0, 0, 0, 1, 0, 0, 1, 1, 0};
+    drawable.indices = {0, 1, 2};
+    Component::Drawable::Construct(drawable, ShaderIdx::TEXT);
+    Assert("Test Null Render Shader Program", drawable.shaderProgram != UINT_MAX && drawable.shaderProgram > 0);
+    Assert("Test Null Render GL Objects",
+           drawable.VAO > 0 && drawable.VBO > 0 && drawable.EBO > 0 && drawable.VBO != drawable.EBO);
+    AssertEqual("Test Null Render Indices Size", drawable.indicesSize, 3);
+
+    int numRuns = 0;
+    Scene::EnqueueRender(scene, Count, &numRuns);
+    Scene::EnqueueRender(scene, Count, &numRuns);
+    Null::Run(scene);
+    AssertEqual("Test Null Render Dequeue", numRuns, 2);
+    Null::Run(scene);
+    AssertEqual("Test Null Render Dequeue Once", numRuns, 2);
+
+    Component::Drawable::Destruct(drawable);
+    Entity::Reset(scene.entityData);
+    Scene::Destroy(scene);
+  }
+}
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "ComponentType.hpp"
+#include "Drawable.hpp"
+#include "Math.hpp"
+#include "Prefab.hpp"
+#include "Scene.hpp"
+#include "UT_Common.hpp"
+
+namespace Temp::Prefab::UnitTests
+{
+  inline void Run()
+  {
+    using namespace Component::Type;
+
+    Scene::SceneFns sceneFns;
+    Scene::Data scene;
+    scene.sceneFns = &sceneFns;
+    Scene::Initialize(scene);
+
+    Entity::id sprite = Scene::CreateEntity(scene);
+    Component::Drawable::Data drawable{};
+    drawable.vertices = {0, 0, 0, 1, 0, 0, 1, 1, 0};
+    drawable.indices = {0, 1, 2};
+    drawable.entity = sprite;
+    drawable.VAO = 7;
+    drawable.texture = 3;
+    Scene::AddComponent<POSITION2D>(scene, sprite, {4, 2});
+    Scene::AddComponent<SCALE>(scene, sprite, {2, 2});
+    Scene::AddComponent<TEXT>(scene, sprite, "Sprite");
+    Scene::AddComponent<DRAWABLE>(scene, sprite, drawable);
+
+    Prefab::Data prefab = Prefab::Capture(scene, sprite);
+    Assert("Test Prefab Capture Bits", prefab.bits == Scene::ComponentBits(scene, sprite));
+
+    constexpr size_t numInstances = 10000;
+    DynamicArray<Entity::id> instances(true, numInstances);
+    instances.size = numInstances;
+    {
+      auto timer = Timer("Prefab Instantiate 10000");
+      Prefab::Instantiate(scene, prefab, instances.buffer, numInstances);
+    }
+
+    const auto& templateDrawable = Scene::Get<DRAWABLE>(scene, sprite);
+    bool isMatching = true;
+    for (auto entity : instances)
+    {
+      const auto& instanceDrawable = Scene::Get<DRAWABLE>(scene, entity);
+      isMatching &= Scene::Get<POSITION2D>(scene, entity) == Math::Vec2f{4, 2} &&
+                    Scene::Get<SCALE>(scene, entity) == Math::Vec2f{2, 2} &&
+                    Scene::Get<TEXT>(scene, entity) == "Sprite" &&
+                    Scene::ComponentBits(scene, entity) == prefab.bits &&
+                    instanceDrawable.entity == entity && instanceDrawable.VAO == 7 &&
+                    instanceDrawable.texture == 3 && instanceDrawable.shared &&
+                    instanceDrawable.vertices.buffer == templateDrawable.vertices.buffer &&
+                    instanceDrawable.indices.size == 3;
+    }
+    Assert("Test Prefab Instances Match", isMatching);
+    AssertEqual("Test Prefab Component Array Size",
+                Scene::GetComponentArray<POSITION2D>(scene).size,
+                numInstances + 1);
+
+    // Removing an instance keeps the sparse sets consistent
+    Scene::DestroyEntity(scene, instances[0]);
+    AssertEqual("Test Prefab Destroy Instance",
+                Scene::GetComponentArray<DRAWABLE>(scene).size,
+                numInstances);
+    Assert("Test Prefab Destroy Instance Keeps Others",
+           Scene::Get<DRAWABLE>(scene, instances[numInstances - 1]).entity ==
+             instances[numInstances - 1]);
+
+    // Shared drawables release nothing
+    Component::Drawable::Destruct(Scene::Get<DRAWABLE>(scene, instances[1]));
+
+    {
+      auto timer = Timer("AddComponent 10000");
+      for (size_t i = 0; i < numInstances; ++i)
+      {
+        Entity::id entity = Scene::CreateEntity(scene);
+        Scene::AddComponent<POSITION2D>(scene, entity, {4, 2});
+        Scene::AddComponent<SCALE>(scene, entity, {2, 2});
+        Scene::AddComponent<TEXT>(scene, entity, "Sprite");
+        Scene::AddComponent<DRAWABLE>(scene, entity, drawable);
+      }
+    }
+
+    Entity::Reset(scene.entityData);
+    Scene::Destroy(scene);
+  }
+}
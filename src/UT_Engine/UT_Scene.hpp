@@ -5,11 +5,14 @@
 
 #include "ComponentType.hpp"
 #include "EntityType.hpp"
+#include "LevelSerializer.hpp"
 #include "Math.hpp"
 #include "Scene.hpp"
 #include "SceneObject.hpp"
 #include "TextBox.hpp"
+#include "ThreadPool.hpp"
 #include "UT_Common.hpp"
+#include <vector>
 
 namespace Temp::Scene::UnitTests
 {
@@ -118,6 +121,176 @@ namespace Temp::Scene::UnitTests
     AssertEqual("Test Scene Remove Object Get Entity", Scene::GetObject(scene, object.entity), {});
 
     Scene::RemoveObject(scene, object1.entity);
+    // Removed objects give their names back
+    AssertEqual("Test Scene Remove Object Frees Names", scene.objectsNameIdxTable.size, (size_t)0);
+    Assert("Test Scene Remove Object Name Reusable", Scene::ValidateObjectName(scene, "Mock0"));
+
+    // Batched spawning
+    {
+      constexpr size_t numSpawns = 500;
+      Mock::Data mock{};
+      DynamicArray<SceneObject::Data> spawns(true, numSpawns);
+      for (size_t i = 0; i < numSpawns; ++i)
+      {
+        spawns.PushBack({.data = &mock, .name = "Enemy", .type = EntityType::MOCK});
+      }
+
+      int64_t singleTime;
+      {
+        auto timer = Timer("Spawn Objects One By One");
+        for (auto& spawn : spawns)
+        {
+          Scene::SpawnObject(scene, spawn);
+        }
+        singleTime = timer.getTime();
+      }
+      DynamicArray<Entity::id> entities(true, numSpawns);
+      for (auto& spawned : scene.objects)
+      {
+        entities.PushBack(spawned.entity);
+      }
+      Scene::RemoveObjects(scene, entities.buffer, entities.size);
+      AssertEqual("Test Scene Remove Objects", scene.objects.size, (size_t)0);
+
+      for (auto& spawn : spawns)
+      {
+        spawn.name = "Wave";
+      }
+      int64_t batchTime;
+      {
+        auto timer = Timer("Spawn Objects Batched");
+        Scene::SpawnObjects(scene, spawns.buffer, spawns.size);
+        batchTime = timer.getTime();
+      }
+      Logger::Log(String("Spawns/ms one by one: ") +
+                  String::ToString((float)(numSpawns * 1000000.0 / Math::Max(singleTime, (int64_t)1))));
+      Logger::Log(String("Spawns/ms batched: ") +
+                  String::ToString((float)(numSpawns * 1000000.0 / Math::Max(batchTime, (int64_t)1))));
+
+      AssertEqual("Test Scene Spawn Objects Count", scene.objects.size, numSpawns);
+      {
+        Temp::ComponentBits bits{0};
+        SetBit(bits, Component::Type::POSITION2D);
+        auto& positions = Scene::GetComponentArray<Component::Type::POSITION2D>(scene);
+        auto& scales = Scene::GetComponentArray<Component::Type::SCALE>(scene);
+        size_t scaleCapacity = scales.array.capacity;
+        Component::Container::Reserve(scene.entityData.componentContainer, bits, numSpawns);
+        Assert("Test Scene Spawn Objects Reserve",
+               positions.array.capacity >= positions.size + numSpawns &&
+                 positions.sparseEntities.capacity >= positions.size + numSpawns &&
+                 positions.added.capacity >= positions.size + numSpawns &&
+                 scales.array.capacity == scaleCapacity);
+      }
+      Assert("Test Scene Spawn Objects Unique Names",
+             Scene::GetObject(scene, "Wave").entity != Entity::MAX &&
+               Scene::GetObject(scene, "Wave498").entity != Entity::MAX &&
+               ValidateObjectName(scene, "Wave499"));
+      bool isMapped = true;
+      for (size_t i = 0; i < scene.objects.size; ++i)
+      {
+        isMapped &= scene.entityObjectIdxTable[scene.objects[i].entity] == (int)i;
+      }
+      Assert("Test Scene Spawn Objects Entity Table", isMapped);
+
+      // Removing from the middle keeps the tables pointing at the swapped object
+      Entity::id removed[] = {scene.objects[0].entity, scene.objects[10].entity};
+      Scene::RemoveObjects(scene, removed, 2);
+      isMapped = true;
+      for (size_t i = 0; i < scene.objects.size; ++i)
+      {
+        isMapped &= scene.entityObjectIdxTable[scene.objects[i].entity] == (int)i &&
+                    Scene::GetObject(scene, scene.objects[i].name.c_str()).entity ==
+                      scene.objects[i].entity;
+      }
+      Assert("Test Scene Remove Objects Keeps Tables", isMapped && scene.objects.size == numSpawns - 2);
+      CleanupScene(scene);
+    }
+
     Entity::Destruct(scene.entityData);
   }
-}
\ No newline at end of file
+
+  // Prepare spread over the thread pool lays texts out the same as running it in order, into
+  // the memory Construct reserved
+  inline void RunPrepare()
+  {
+    using namespace Component::Type;
+
+    SceneObject::Init();
+    Scene::SceneFns sceneFns;
+    Scene::Data scene;
+    scene.sceneFns = &sceneFns;
+    Scene::Initialize(scene);
+
+    constexpr int numObjects = 6000;
+    FILE* fp = fopen((AssetsDirectory() / "Levels" / "Prepare.level").c_str(), "wb");
+    for (int i = 0; i < numObjects; ++i)
+    {
+      if (i % 2 == 0)
+      {
+        fprintf(fp,
+                "TextBox\n{\n  Shader: 1\n  Position: 0 0\n  Scale: 0.04\n"
+                "  Text: Some  words %d to lay out over lines\n  Font: 1\n  CharacterLimit: 8\n}\n\n",
+                i);
+      }
+      else
+      {
+        fprintf(fp,
+                "TextButton\n{\n  Shader: 1\n  TextBox\n  {\n    Position: 0 0\n"
+                "    Scale: 0.0345\n    Text: Button %d\n  }\n\n  Hoverable\n  {\n    Position: 0 0\n"
+                "    Size: 9 4\n    Scale: 1 1.5\n  }\n}\n\n",
+                i);
+      }
+    }
+    fclose(fp);
+    Assert("Test Scene Prepare Deserialize", LevelSerializer::Deserialize(scene, "Prepare.level"));
+    Path::Remove(AssetsDirectory() / "Levels" / "Prepare.level");
+
+    for (auto& object : scene.objects)
+    {
+      object.entity = Scene::CreateEntity(scene);
+      SceneObject::BeginConstruct(scene, object);
+    }
+    {
+      auto timer = Timer("Scene Prepare Serial 6000");
+      for (auto& object : scene.objects)
+      {
+        SceneObject::Prepare(scene, object);
+      }
+    }
+    std::vector<std::vector<float>> serialVertices;
+    std::vector<const float*> buffers;
+    for (auto& object : scene.objects)
+    {
+      auto& drawable = Scene::Get<DRAWABLE>(scene, object.entity);
+      serialVertices.emplace_back(drawable.vertices.begin(), drawable.vertices.end());
+      buffers.push_back(drawable.vertices.buffer);
+      drawable.vertices.Clear();
+      drawable.indices.Clear();
+    }
+
+    Assert("Test Scene Prepare Has Workers", GetThreadPool().threads.size > 0);
+    {
+      auto timer = Timer("Scene Prepare Parallel 6000");
+      Scene::PrepareObjects(scene, 0, scene.objects.size);
+    }
+    bool isMatching = true;
+    bool isInPlace = true;
+    for (size_t i = 0; i < scene.objects.size; ++i)
+    {
+      auto& drawable = Scene::Get<DRAWABLE>(scene, scene.objects[i].entity);
+      isMatching &= drawable.vertices.size == serialVertices[i].size() &&
+                    std::equal(serialVertices[i].begin(), serialVertices[i].end(), drawable.vertices.begin()) &&
+                    drawable.indices.size == drawable.vertices.size / 16 * 6;
+      isInPlace &= drawable.vertices.buffer == buffers[i];
+    }
+    Assert("Test Scene Prepare Parallel Matches Serial", isMatching);
+    Assert("Test Scene Prepare Doesn't Allocate", isInPlace);
+    Assert("Test Scene Prepare Lays Out Text", serialVertices[0].size() == 35 * 16);
+    auto* textBox = static_cast<TextBox::Data*>(scene.objects[0].data);
+    Assert("Test Scene Prepare Wraps Lines", textBox->size.y >= 150 * 4);
+
+    CleanupScene(scene);
+    Scene::Destroy(scene);
+    MemoryManager::data.FreeAll();
+  }
+}
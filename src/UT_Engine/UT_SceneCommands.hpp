@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "ComponentType.hpp"
+#include "Math.hpp"
+#include "Scene.hpp"
+#include "SceneCommands.hpp"
+#include "UT_Common.hpp"
+
+namespace Temp::Scene::Commands::UnitTests
+{
+  inline void Run()
+  {
+    using namespace Component::Type;
+
+    Scene::SceneFns sceneFns;
+    Scene::Data scene;
+    scene.sceneFns = &sceneFns;
+    Scene::Initialize(scene);
+    auto& commands = Scene::GetCommands();
+
+    constexpr int numExisting = 64;
+    for (int i = 0; i < numExisting; ++i)
+    {
+      Entity::id entity = Scene::CreateEntity(scene);
+      Scene::AddComponent<POSITION2D>(scene, entity, {(float)i, 0});
+      Scene::AddComponent<SCALE>(scene, entity, {1, 1});
+    }
+
+    Entity::id pending = Commands::CreateEntity(commands);
+    Assert("Test Commands Create Is Pending", Commands::IsPending(pending));
+    Commands::AddComponent<TEXT>(commands, pending, "Pending");
+    Commands::AddComponent<POSITION2D>(commands, 3, {-1, -1});
+    Commands::RemoveComponent<SCALE>(commands, 3);
+    Assert("Test Commands Not Applied Before Flush",
+           Scene::Get<POSITION2D>(scene, 3) == Math::Vec2f{3, 0} &&
+             Test(Scene::ComponentBits(scene, 3), SCALE));
+
+    Commands::Flush(scene, commands);
+    Entity::id created = numExisting;
+    Assert("Test Commands Flush Creates Entity",
+           Entity::IsAlive(scene.entityData, created) &&
+             Scene::Get<TEXT>(scene, created) == "Pending");
+    AssertEqual("Test Commands Flush Add Component",
+                Scene::Get<POSITION2D>(scene, 3),
+                Math::Vec2f{-1, -1});
+    Assert("Test Commands Flush Remove Component", !Test(Scene::ComponentBits(scene, 3), SCALE));
+    Assert("Test Commands Flush Clears Buffers", Commands::IsEmpty(commands));
+
+    // Recording from several threads at once, each one as its own job. Started in reverse so the
+    // last job is likely to record first.
+    constexpr int numThreads = 4;
+    constexpr int numPerThread = 500;
+    std::thread threads[numThreads];
+    for (int t = numThreads - 1; t >= 0; --t)
+    {
+      threads[t] = std::thread([&commands, t]() {
+        Commands::JobScope scope(t);
+        for (int i = 0; i < numPerThread; ++i)
+        {
+          Entity::id entity = Commands::CreateEntity(commands);
+          Commands::AddComponent<POSITION2D>(commands, entity, {(float)t, (float)i});
+        }
+        // Every thread destroys its own existing entities
+        for (int i = t; i < numExisting; i += numThreads)
+        {
+          Commands::DestroyEntity(commands, i);
+        }
+      });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+    Assert("Test Commands Buffer Per Job", commands.buffers[numThreads - 1].created.size == numPerThread);
+
+    Commands::Flush(scene, commands);
+    AssertEqual("Test Commands Threaded Flush Count",
+                Entity::Count(scene.entityData),
+                (size_t)(numThreads * numPerThread + 1));
+    AssertEqual("Test Commands Threaded Flush Components",
+                Scene::GetComponentArray<POSITION2D>(scene).size,
+                (size_t)(numThreads * numPerThread));
+    Assert("Test Commands Threaded Flush Destroyed",
+           !Entity::IsAlive(scene.entityData, 0) && !Entity::IsAlive(scene.entityData, 3));
+    // Pending entities get their ids in job order, whichever thread recorded first
+    bool isJobOrder = true;
+    for (int t = 0; t < numThreads; ++t)
+    {
+      for (int i = 0; i < numPerThread; ++i)
+      {
+        Entity::id entity = created + 1 + t * numPerThread + i;
+        isJobOrder &= Scene::Get<POSITION2D>(scene, entity) == Math::Vec2f{(float)t, (float)i};
+      }
+    }
+    Assert("Test Commands Threaded Flush Job Order", isJobOrder);
+
+    // Commands for an entity destroyed earlier in the same flush are dropped
+    Commands::DestroyEntity(commands, created);
+    Commands::AddComponent<SCALE>(commands, created, {2, 2});
+    Commands::Flush(scene, commands);
+    Assert("Test Commands Add After Destroy Dropped", !Entity::IsAlive(scene.entityData, created));
+
+    Commands::AddComponent<TEXT>(commands, created, "Dropped");
+    Commands::Clear(commands);
+    Assert("Test Commands Clear", Commands::IsEmpty(commands));
+
+    Entity::Reset(scene.entityData);
+    Scene::Destroy(scene);
+  }
+}
@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "EngineUtils.hpp"
+#include "LevelSerializer.hpp"
+#include "Scene.hpp"
+#include "SceneLoader.hpp"
+#include "UT_Common.hpp"
+
+namespace Temp::Scene::Loader::UnitTests
+{
+  inline void Run()
+  {
+    SceneObject::Init();
+    Scene::SceneFns sceneFns;
+    Scene::Data scene;
+    scene.sceneFns = &sceneFns;
+    Entity::Init(scene.entityData);
+    Data loader;
+
+    Prefetch(loader, "Test.level");
+    Assert("Test Loader Prefetch Progress", Progress(loader) <= READ_SHARE);
+    Assert("Test Loader Wait Other File", Wait(loader, "Other.level") == nullptr);
+    char* contents = Wait(loader, "Test.level");
+    Assert("Test Loader Wait", contents != nullptr);
+    Assert("Test Loader Ready", loader.status == Status::READY);
+
+    String expected;
+    String output;
+    Assert("Test Loader Read File",
+           ReadFile(expected, (AssetsDirectory() / "Levels" / "Test.level").c_str(), output));
+    Assert("Test Loader Contents Match", strcmp(contents, expected.c_str()) == 0);
+    AssertEqual("Test Loader Read Progress", Progress(loader), READ_SHARE);
+
+    Assert("Test Loader Deserialize", LevelSerializer::Deserialize(scene, "Test.level", contents));
+    AssertEqual("Test Loader Deserialize Objects", scene.objects.size, 2ul);
+    AssertEqual("Test Loader Deserialize Name", scene.objects[0].name, {"NumberGameTextBox"});
+    CleanupScene(scene);
+
+    AssertEqual("Test Loader Parsed Blocks", loader.numBlocks, 2ul);
+    Assert("Test Loader Deserialize Blocks", Deserialize(scene, loader));
+    AssertEqual("Test Loader Deserialize Blocks Objects", scene.objects.size, 2ul);
+    AssertEqual("Test Loader Deserialize Blocks Name", scene.objects[0].name, {"NumberGameTextBox"});
+    CleanupScene(scene);
+    TGA::Header header;
+    Assert("Test Loader No Texture", FindTexture(loader, "Missing.tga", header) == nullptr);
+
+    loader.numObjects = 4;
+    loader.nextObject = 1;
+    AssertEqual("Test Loader DrawConstruct Progress", Progress(loader), READ_SHARE + (1.f - READ_SHARE) * 0.25f);
+    loader.isDrawConstructed = true;
+    AssertEqual("Test Loader Done Progress", Progress(loader), 1.f);
+
+    Prefetch(loader, "Missing.level");
+    Assert("Test Loader Missing File", Wait(loader, "Missing.level") == nullptr);
+
+    Prefetch(loader, "Test.level");
+    Assert("Test Loader Wait Again", Wait(loader, "Test.level") != nullptr);
+    Destroy(loader);
+    Assert("Test Loader Destroy Releases",
+           !loader.contents && !loader.blocks && !loader.textures && loader.status == Status::IDLE);
+    Entity::Destruct(scene.entityData);
+  }
+}
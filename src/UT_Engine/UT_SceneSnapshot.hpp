@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Scene.hpp"
+#include "SceneSnapshot.hpp"
+#include "UT_Common.hpp"
+#include "UT_Transform.hpp"
+
+namespace Temp::Scene::Snapshots::UnitTests
+{
+  using Component::Transform::UnitTests::Read;
+
+  constexpr int NUM_ENTITIES = 5000;
+
+  // Moves 1% of the entities, spawns and destroys now and then
+  inline void Simulate(Scene::Data& scene, int step)
+  {
+    using namespace Component::Type;
+    Component::AdvanceTick();
+    for (Entity::id entity = step % 100; entity < NUM_ENTITIES; entity += 100)
+    {
+      Scene::Get<POSITION2D>(scene, entity).y += (float)step;
+    }
+    if (step % 4 == 0)
+    {
+      Entity::id entity = Scene::CreateEntity(scene);
+      Scene::AddComponent<POSITION2D>(scene, entity, {0, (float)step});
+    }
+    if (step % 8 == 0)
+    {
+      Scene::DestroyEntity(scene, (Entity::id)step);
+    }
+  }
+
+  inline double Checksum(Scene::Data& scene)
+  {
+    double sum = (double)Entity::Count(scene.entityData);
+    for (Entity::id entity = 0; entity < scene.entityData.used.size; ++entity)
+    {
+      if (Entity::IsAlive(scene.entityData, entity))
+      {
+        const auto& position = Read<Component::Type::POSITION2D>(scene, entity);
+        sum += position.x * 3 + position.y * (entity + 1);
+      }
+    }
+    return sum + Component::Tick();
+  }
+
+  inline void Run()
+  {
+    using namespace Component::Type;
+
+    Scene::SceneFns sceneFns;
+    Scene::Data scene;
+    scene.sceneFns = &sceneFns;
+    Scene::Initialize(scene);
+    for (int i = 0; i < NUM_ENTITIES; ++i)
+    {
+      Entity::id entity = Scene::CreateEntity(scene);
+      Scene::AddComponent<POSITION2D>(scene, entity, {(float)i, 0});
+      Scene::AddComponent<SCALE>(scene, entity, {1, 1});
+    }
+
+    constexpr int numFrames = 40;
+    Data snapshots;
+    Init(snapshots, 64);
+    double checksums[numFrames + 1];
+    AssertEqual("Test Snapshot First Frame", Scene::Snapshot(scene, snapshots), 0ul);
+    checksums[0] = Checksum(scene);
+    for (int step = 1; step <= numFrames; ++step)
+    {
+      Simulate(scene, step);
+      Scene::Snapshot(scene, snapshots);
+      checksums[step] = Checksum(scene);
+    }
+    Assert("Test Snapshot Delta Smaller", Size(snapshots, 1) * 8 < Size(snapshots, 0));
+    Assert("Test Snapshot Keyframe", Size(snapshots, 16) * 8 > Size(snapshots, 0));
+
+    // Roll back and simulate the same steps again
+    Assert("Test Snapshot Restore", Scene::Restore(scene, snapshots, 20));
+    Assert("Test Snapshot Restore State", Checksum(scene) == checksums[20]);
+    Assert("Test Snapshot Restore Drops Newer", !IsRestorable(snapshots, 21));
+    bool isMatching = true;
+    for (int step = 21; step <= numFrames; ++step)
+    {
+      Simulate(scene, step);
+      isMatching &= Scene::Snapshot(scene, snapshots) == (uint64_t)step;
+      isMatching &= Checksum(scene) == checksums[step];
+    }
+    Assert("Test Snapshot Resimulate", isMatching);
+    Assert("Test Snapshot Restore Oldest", Scene::Restore(scene, snapshots, 0));
+    Assert("Test Snapshot Restore Oldest State", Checksum(scene) == checksums[0]);
+
+    // Old frames fall out of a small ring
+    Data ring;
+    Init(ring, 16);
+    for (int step = 1; step <= numFrames; ++step)
+    {
+      Simulate(scene, step);
+      Scene::Snapshot(scene, ring);
+    }
+    Assert("Test Snapshot Evicted", !IsRestorable(ring, 0) && !IsRestorable(ring, 31));
+    Assert("Test Snapshot Restore Newest", Scene::Restore(scene, ring, numFrames - 1));
+    Assert("Test Snapshot Restore Newest State", Checksum(scene) == checksums[numFrames]);
+
+    // Reset level
+    Data levelStart;
+    Init(levelStart, 1);
+    uint64_t frame = Scene::Snapshot(scene, levelStart);
+    for (int step = 1; step <= numFrames; ++step)
+    {
+      Simulate(scene, step);
+    }
+    Assert("Test Snapshot Reset Level", Scene::Restore(scene, levelStart, frame));
+    Assert("Test Snapshot Reset Level State", Checksum(scene) == checksums[numFrames]);
+
+    Clear(snapshots);
+    {
+      auto timer = Timer("Scene Snapshot 100 Frames 5000 Entities");
+      for (int step = 1; step <= 100; ++step)
+      {
+        Simulate(scene, step);
+        Scene::Snapshot(scene, snapshots);
+      }
+    }
+    {
+      auto timer = Timer("Scene Restore 5000 Entities");
+      Assert("Test Snapshot Restore Bench", Scene::Restore(scene, snapshots, 95));
+    }
+
+    Destroy(snapshots);
+    Destroy(ring);
+    Destroy(levelStart);
+    Entity::Reset(scene.entityData);
+    Scene::Destroy(scene);
+  }
+}
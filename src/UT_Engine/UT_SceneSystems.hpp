@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "ComponentType.hpp"
+#include "Math.hpp"
+#include "Scene.hpp"
+#include "SceneCommands.hpp"
+#include "SceneSystems.hpp"
+#include "SceneView.hpp"
+#include "UT_Common.hpp"
+
+namespace Temp::Scene::Systems::UnitTests
+{
+  inline std::atomic<int> numRuns{0};
+  inline float positionSum{0};
+
+  inline void Move(Scene::Data& scene, float deltaTime)
+  {
+    for (auto [entity, position] : Scene::View<Component::Type::POSITION2D>(scene))
+    {
+      position.x += deltaTime;
+    }
+    ++numRuns;
+  }
+
+  // Shares a batch with Move and runs on a worker, where ParallelEach has to stay serial
+  inline void Grow(Scene::Data& scene, float)
+  {
+    Scene::ParallelEach(
+      Scene::View<Component::Type::SCALE>(scene),
+      [](Entity::id, Math::Vec2f& scale) { scale = scale * 2.f; },
+      1);
+    ++numRuns;
+  }
+
+  inline void SumPositions(Scene::Data& scene, float)
+  {
+    positionSum = 0;
+    for (auto [entity, position] : Scene::View<Component::Type::POSITION2D>(scene))
+    {
+      positionSum += position.x;
+    }
+    ++numRuns;
+  }
+
+  inline void SpawnText(Scene::Data&, float)
+  {
+    auto& commands = Scene::GetCommands();
+    Entity::id entity = Commands::CreateEntity(commands);
+    Commands::AddComponent<Component::Type::TEXT>(commands, entity, "Spawned");
+    ++numRuns;
+  }
+
+  // Registered first, so it's the one that used to run on the calling thread next to SpawnText
+  inline void RotateAll(Scene::Data& scene, float)
+  {
+    Scene::ParallelEach(
+      Scene::View<Component::Type::POSITION2D>(scene),
+      [](Entity::id entity, Math::Vec2f&) {
+        Commands::AddComponent<Component::Type::ROTATION>(Scene::GetCommands(), entity, 1.f);
+      },
+      1);
+    ++numRuns;
+  }
+
+  inline void Run()
+  {
+    using namespace Component::Type;
+
+    Scene::SceneFns sceneFns;
+    Scene::Data scene;
+    scene.sceneFns = &sceneFns;
+    Scene::Initialize(scene);
+
+    constexpr int numEntities = 1000;
+    for (int i = 0; i < numEntities; ++i)
+    {
+      Entity::id entity = Scene::CreateEntity(scene);
+      Scene::AddComponent<POSITION2D>(scene, entity, {0, 0});
+      Scene::AddComponent<SCALE>(scene, entity, {1, 1});
+    }
+
+    Systems::Add(scene.systems, "Move", Move, 0, Access<POSITION2D>());
+    Systems::Add(scene.systems, "Grow", Grow, 0, Access<SCALE>());
+    Systems::Add(scene.systems, "SpawnText", SpawnText, 0, 0);
+    Systems::Add(scene.systems, "SumPositions", SumPositions, Access<POSITION2D>(), 0);
+
+    AssertEqual("Test Systems Batches", Systems::Build(scene.systems), 2ul);
+    Assert("Test Systems Independent Share Batch",
+           Systems::Find(scene.systems, "Move")->batch == 0 &&
+             Systems::Find(scene.systems, "Grow")->batch == 0 &&
+             Systems::Find(scene.systems, "SpawnText")->batch == 0);
+    AssertEqual("Test Systems Reader After Writer",
+                (int)Systems::Find(scene.systems, "SumPositions")->batch,
+                1);
+
+    numRuns = 0;
+    Scene::Update(scene, 1.f);
+    AssertEqual("Test Systems All Ran", numRuns.load(), 4);
+    AssertEqual("Test Systems Order Kept", positionSum, (float)numEntities);
+    AssertEqual("Test Systems Writes Applied", Scene::Get<SCALE>(scene, 0), Math::Vec2f{2, 2});
+    AssertEqual("Test Systems Commands Flushed",
+                Scene::GetComponentArray<TEXT>(scene).size,
+                1ul);
+    Assert("Test Systems Timed", Systems::Find(scene.systems, "Move")->time >= 0.f);
+
+    Systems::SetEnabled(scene.systems, "Move", false);
+    AssertEqual("Test Systems Disabled Frees Batch", Systems::Build(scene.systems), 1ul);
+    numRuns = 0;
+    Scene::Update(scene, 1.f);
+    AssertEqual("Test Systems Disabled Not Run", numRuns.load(), 3);
+
+    Systems::Remove(scene.systems, "Grow");
+    Assert("Test Systems Remove",
+           scene.systems.size == 3 && Systems::Find(scene.systems, "Grow") == nullptr &&
+             strcmp(scene.systems.systems[1].name, "SpawnText") == 0);
+
+    // A batch of two where one of them fans out with ParallelEach and records commands
+    Systems::Clear(scene.systems);
+    Systems::Add(scene.systems, "RotateAll", RotateAll, Access<POSITION2D>(), 0);
+    Systems::Add(scene.systems, "SpawnText", SpawnText, 0, 0);
+    AssertEqual("Test Systems Parallel Batch", Systems::Build(scene.systems), 1ul);
+    size_t numTexts = Scene::GetComponentArray<TEXT>(scene).size;
+    numRuns = 0;
+    Scene::Update(scene, 1.f);
+    AssertEqual("Test Systems Parallel Batch Ran", numRuns.load(), 2);
+    AssertEqual("Test Systems Parallel Batch Commands",
+                Scene::GetComponentArray<ROTATION>(scene).size,
+                (size_t)numEntities);
+    AssertEqual("Test Systems Parallel Batch Other Commands",
+                Scene::GetComponentArray<TEXT>(scene).size,
+                numTexts + 1);
+
+    Systems::Clear(scene.systems);
+    Entity::Reset(scene.entityData);
+    Scene::Destroy(scene);
+  }
+}
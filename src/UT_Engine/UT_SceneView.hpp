@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "ComponentType.hpp"
+#include "Math.hpp"
+#include "Scene.hpp"
+#include "SceneView.hpp"
+#include "ThreadPool.hpp"
+#include "UT_Common.hpp"
+
+namespace Temp::Scene::UnitTests
+{
+  inline void RunView()
+  {
+    Scene::SceneFns sceneFns;
+    Scene::Data scene;
+    scene.sceneFns = &sceneFns;
+    Scene::Initialize(scene);
+
+    constexpr int numEntities = 100000;
+    for (int i = 0; i < numEntities; ++i)
+    {
+      Entity::id entity = Scene::CreateEntity(scene);
+      Scene::AddComponent<Component::Type::POSITION2D>(scene, entity, {(float)i, 0});
+      if (i % 2 == 0)
+      {
+        Scene::AddComponent<Component::Type::SCALE>(scene, entity, {1, 1});
+      }
+    }
+    // A disabled component shouldn't show up in views
+    Scene::AddCacheComponent<Component::Type::SCALE>(scene, 0);
+
+    using namespace Component::Type;
+    {
+      Scene::View<POSITION2D, SCALE> view(scene);
+      AssertEqual("Test Scene View Driven By Smallest Array",
+                  view.size,
+                  Scene::GetComponentArray<SCALE>(scene).size);
+
+      int count = 0;
+      bool isMatching = true;
+      for (auto [entity, position, scale] : view)
+      {
+        isMatching &= position.x == (float)entity && entity % 2 == 0 && entity != 0;
+        ++count;
+      }
+      Assert("Test Scene View Components Match Entity", isMatching);
+      AssertEqual("Test Scene View Count", count, numEntities / 2 - 1);
+    }
+
+    {
+      int count = 0;
+      Scene::Each(Scene::View<POSITION2D>(scene), [&count](Entity::id, Math::Vec2f&) { ++count; });
+      AssertEqual("Test Scene View Single Component", count, numEntities);
+    }
+
+    {
+      std::atomic<int> count = 0;
+      Scene::ParallelEach(Scene::View<POSITION2D, SCALE>(scene),
+                          [&count](Entity::id, Math::Vec2f& position, Math::Vec2f& scale) {
+                            position = position + scale;
+                            ++count;
+                          });
+      AssertEqual("Test Scene View ParallelEach Count", count.load(), numEntities / 2 - 1);
+      AssertEqual("Test Scene View ParallelEach Writes",
+                  Scene::Get<POSITION2D>(scene, 2),
+                  Math::Vec2f{3, 1});
+    }
+
+    // Benchmarks against the hand written loops systems use today
+    {
+      auto timer = Timer("Hand Loop (SCALE -> Get POSITION2D)");
+      auto& scaleArray = Scene::GetComponentArray<SCALE>(scene);
+      for (size_t i = 0; i < scaleArray.size; ++i)
+      {
+        Entity::id entity = scaleArray.sparseEntities[i];
+        if (Test(Scene::ComponentBits(scene, entity), POSITION2D))
+        {
+          auto& position = Scene::Get<POSITION2D>(scene, entity);
+          position = position + scaleArray.array[i];
+        }
+      }
+    }
+
+    {
+      auto timer = Timer("View<POSITION2D, SCALE>");
+      for (auto [entity, position, scale] : Scene::View<POSITION2D, SCALE>(scene))
+      {
+        position = position + scale;
+      }
+    }
+
+    {
+      auto timer = Timer("ParallelEach<POSITION2D, SCALE>");
+      Scene::ParallelEach(Scene::View<POSITION2D, SCALE>(scene),
+                          [](Entity::id, Math::Vec2f& position, Math::Vec2f& scale) {
+                            position = position + scale;
+                          });
+    }
+
+    AssertEqual("Test Scene View Benchmarks Applied",
+                Scene::Get<POSITION2D>(scene, 2),
+                Math::Vec2f{6, 4});
+
+    Entity::Reset(scene.entityData);
+    Scene::Destroy(scene);
+  }
+}
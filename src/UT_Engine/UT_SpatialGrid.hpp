@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Math.hpp"
+#include "SpatialGrid.hpp"
+#include "UT_Common.hpp"
+
+namespace Temp::SpatialGrid::UnitTests
+{
+  inline size_t Count(const Data& grid, float x, float y, Entity::id& last)
+  {
+    size_t count = 0;
+    Query(grid, x, y, [&count, &last](Entity::id entity) {
+      ++count;
+      last = entity;
+    });
+    return count;
+  }
+
+  inline void Run()
+  {
+    Data grid;
+    Init(grid, 4.f);
+
+    Entity::id last = Entity::MAX;
+    AssertEqual("Test SpatialGrid Empty Query", Count(grid, 0, 0, last), 0ul);
+
+    Update(grid, 1, {0, 0, 2, 2});
+    Update(grid, 2, {10, 10, 30, 30});
+    Update(grid, 3, {-1000, -1000, 1000, 1000});
+    AssertEqual("Test SpatialGrid Size", grid.size, 3ul);
+    Assert("Test SpatialGrid Oversized", grid.entries[3].oversized && grid.oversized.size == 1);
+
+    AssertEqual("Test SpatialGrid Query Small", Count(grid, 1, 1, last), 2ul);
+    AssertEqual("Test SpatialGrid Query Spanning Cells", Count(grid, 29, 11, last), 2ul);
+    AssertEqual("Test SpatialGrid Query Outside", Count(grid, 3, 3, last), 1ul);
+    Assert("Test SpatialGrid Query Oversized Only", last == 3);
+
+    // Every cell of the entity links into the bucket once
+    Update(grid, 4, {-20, -20, 12, 12});
+    AssertEqual("Test SpatialGrid No Duplicates", Count(grid, 5, 5, last), 2ul);
+
+    Update(grid, 1, {100, 100, 102, 102});
+    AssertEqual("Test SpatialGrid Move Old", Count(grid, 1, 1, last), 2ul);
+    AssertEqual("Test SpatialGrid Move New", Count(grid, 101, 101, last), 2ul);
+
+    Update(grid, 1, {100.5f, 100.5f, 101, 101});
+    AssertEqual("Test SpatialGrid Same Cells Bounds", Count(grid, 100.2f, 100.2f, last), 1ul);
+
+    Remove(grid, 3);
+    Remove(grid, 2);
+    Remove(grid, 2);
+    AssertEqual("Test SpatialGrid Remove", Count(grid, 11, 11, last), 1ul);
+    AssertEqual("Test SpatialGrid Remove Size", grid.size, 2ul);
+    Assert("Test SpatialGrid Remove Frees Nodes", grid.freeNodes != INVALID);
+
+    Update(grid, 5, {11, 11, 13, 13});
+    Assert("Test SpatialGrid Reuses Nodes", Count(grid, 12, 12, last) == 2);
+
+    // Hashed cells far apart can share a bucket
+    Data collisions;
+    Init(collisions, 1.f);
+    for (Entity::id entity = 0; entity < 10000; ++entity)
+    {
+      float x = (float)(entity % 100) * 3;
+      float y = (float)(entity / 100) * 3;
+      Update(collisions, entity, {x, y, x + 1, y + 1});
+    }
+    bool isMatching = true;
+    for (Entity::id entity = 0; entity < 10000; entity += 37)
+    {
+      float x = (float)(entity % 100) * 3 + 0.5f;
+      float y = (float)(entity / 100) * 3 + 0.5f;
+      isMatching &= Count(collisions, x, y, last) == 1 && last == entity;
+    }
+    Assert("Test SpatialGrid Many Entities", isMatching);
+  }
+}
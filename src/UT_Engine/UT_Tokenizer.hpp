@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Tokenizer.hpp"
+#include "UT_Common.hpp"
+
+namespace Temp::Tokenizer::UnitTests
+{
+  inline void Run()
+  {
+    const char* text = "// Comment\n\n  Name: A name: with colon  \r\n\tPosition: 1.5 -2\nScale: +3\nLast";
+    Data tokenizer;
+    Init(tokenizer, text, strlen(text));
+
+    Assert("Test Tokenizer Content Line", NextContentLine(tokenizer));
+    AssertEqual("Test Tokenizer Line Number", tokenizer.lineNumber, 3);
+    Assert("Test Tokenizer Trimmed", tokenizer.line == "Name: A name: with colon");
+    std::string_view key;
+    std::string_view value;
+    Assert("Test Tokenizer Split", Split(tokenizer.line, ": ", key, value));
+    Assert("Test Tokenizer Split Key", key == "Name");
+    Assert("Test Tokenizer Split Value", value == "A name: with colon");
+    Assert("Test Tokenizer Split Missing", !Split("TextBox", ": ", key, value));
+
+    Assert("Test Tokenizer Next Line", NextLine(tokenizer));
+    Assert("Test Tokenizer Split Position", Split(tokenizer.line, ": ", key, value));
+    float position[2];
+    Assert("Test Tokenizer Parse All", ParseAll(value, position, 2));
+    AssertEqual("Test Tokenizer Parse All x", position[0], 1.5f);
+    AssertEqual("Test Tokenizer Parse All y", position[1], -2.f);
+    Assert("Test Tokenizer Parse All Too Few", !ParseAll(value, position, 3));
+    Assert("Test Tokenizer Parse All Too Many", !ParseAll("1 2 3", position, 2));
+
+    Assert("Test Tokenizer Scale", NextLine(tokenizer) && Split(tokenizer.line, ": ", key, value));
+    int scale = 0;
+    Assert("Test Tokenizer Parse Plus", Parse(value, scale));
+    AssertEqual("Test Tokenizer Parse Plus Value", scale, 3);
+    float trailing = 0.f;
+    Assert("Test Tokenizer Parse Trailing", Parse("0.25f", trailing));
+    AssertEqual("Test Tokenizer Parse Trailing Value", trailing, 0.25f);
+    Assert("Test Tokenizer Parse Invalid", !Parse("abc", scale));
+    Assert("Test Tokenizer Parse Empty", !Parse("", scale));
+
+    // No trailing newline on the last line
+    Assert("Test Tokenizer Last Line", NextLine(tokenizer));
+    Assert("Test Tokenizer Last Line Value", tokenizer.line == "Last");
+    AssertEqual("Test Tokenizer Last Line Number", tokenizer.lineNumber, 6);
+    Assert("Test Tokenizer End", !NextLine(tokenizer));
+
+    std::string_view rest = "  a bb\tccc ";
+    Assert("Test Tokenizer Token 1", NextToken(rest) == "a");
+    Assert("Test Tokenizer Token 2", NextToken(rest) == "bb");
+    Assert("Test Tokenizer Token 3", NextToken(rest) == "ccc");
+    Assert("Test Tokenizer Token End", NextToken(rest).empty());
+  }
+}
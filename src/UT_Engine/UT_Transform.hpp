@@ -0,0 +1,367 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "ComponentType.hpp"
+#include "Drawable.hpp"
+#include "Math.hpp"
+#include "Scene.hpp"
+#include "SceneView.hpp"
+#include "Transform.hpp"
+#include "UT_Common.hpp"
+
+namespace Temp::Component::Transform::UnitTests
+{
+  inline bool IsNear(const Math::Vec4f& a, const Math::Vec4f& b)
+  {
+    return fabsf(a.x - b.x) < 0.0001f && fabsf(a.y - b.y) < 0.0001f &&
+           fabsf(a.z - b.z) < 0.0001f && fabsf(a.w - b.w) < 0.0001f;
+  }
+
+  inline bool IsNear(const Math::Mat4& a, const Math::Mat4& b)
+  {
+    return IsNear(a.rows[0], b.rows[0]) && IsNear(a.rows[1], b.rows[1]) &&
+           IsNear(a.rows[2], b.rows[2]) && IsNear(a.rows[3], b.rows[3]);
+  }
+
+  // Reads without stamping the component as changed
+  template <uint8_t T>
+  inline const MapToComponentDataType<T>& Read(Scene::Data& scene, Entity::id entity)
+  {
+    return Component::Get(std::as_const(Scene::GetComponentArray<T>(scene)), entity);
+  }
+
+  inline void Run()
+  {
+    using namespace Component::Type;
+
+    Scene::SceneFns sceneFns;
+    Scene::Data scene;
+    scene.sceneFns = &sceneFns;
+    Scene::Initialize(scene);
+
+    constexpr int numEntities = 10003;
+    DynamicArray<Entity::id> entities(true, numEntities);
+    for (int i = 0; i < numEntities; ++i)
+    {
+      Entity::id entity = Scene::CreateEntity(scene);
+      Drawable::Data drawable{};
+      drawable.entity = entity;
+      drawable.offset = {0, 1, 0};
+      Drawable::SetScale(drawable, {1, 1, 0});
+      Scene::AddComponent<DRAWABLE>(scene, entity, drawable);
+      Scene::AddComponent<POSITION2D>(scene, entity, {(float)i, (float)-i});
+      Scene::AddComponent<SCALE>(scene, entity, {2, 3});
+      if (i % 2)
+      {
+        Scene::AddComponent<ROTATION>(scene, entity, (float)i * 0.01f);
+      }
+      entities.PushBack(entity);
+    }
+
+    // Model matrices built one by one through Drawable
+    auto expected = [&scene](Entity::id entity) {
+      Drawable::Data drawable{};
+      drawable.offset = {0, 1, 0};
+      const auto& position = Read<POSITION2D>(scene, entity);
+      const auto& scale = Read<SCALE>(scene, entity);
+      float rotation = Test(Scene::ComponentBits(scene, entity), ROTATION)
+                         ? Read<ROTATION>(scene, entity)
+                         : 0.f;
+      drawable.model = drawable.model.rotateZ(rotation);
+      drawable.model = drawable.model.scale({scale.x, scale.y, 1});
+      drawable.model[2].z = 0;
+      Drawable::SetTranslate(drawable, {position.x, position.y, 0});
+      return drawable.model;
+    };
+
+    size_t count = 0;
+    {
+      auto timer = Timer("Transform Update 10003");
+      count = Transform::Update(scene, scene.transforms);
+    }
+    AssertEqual("Test Transform First Update Builds All", count, (size_t)numEntities);
+
+    const auto& drawableArray = Scene::GetComponentArray<DRAWABLE>(scene);
+    bool isMatching = true;
+    for (auto entity : entities)
+    {
+      isMatching &= IsNear(Read<DRAWABLE>(scene, entity).model, expected(entity));
+    }
+    Assert("Test Transform Matches Scalar Model", isMatching);
+
+    isMatching = scene.transforms.models.size == drawableArray.size;
+    for (size_t i = 0; i < drawableArray.size; ++i)
+    {
+      isMatching &= scene.transforms.models[i] == drawableArray.array[i].model;
+    }
+    Assert("Test Transform Contiguous Models", isMatching);
+
+    // Changes stamped with the tick of the last Update are picked up once more
+    Component::AdvanceTick();
+    AssertEqual("Test Transform Same Tick Rebuilt Again",
+                Transform::Update(scene, scene.transforms),
+                (size_t)numEntities);
+    Component::AdvanceTick();
+    AssertEqual("Test Transform Nothing Dirty", Transform::Update(scene, scene.transforms), 0ul);
+
+    Component::AdvanceTick();
+    Component::AdvanceTick();
+    Scene::Get<POSITION2D>(scene, entities[5]) = {-7, 7};
+    Scene::Get<ROTATION>(scene, entities[7]) = 1.f;
+    AssertEqual("Test Transform Only Dirty Rebuilt", Transform::Update(scene, scene.transforms), 2ul);
+    Assert("Test Transform Dirty Position",
+           IsNear(Read<DRAWABLE>(scene, entities[5]).model, expected(entities[5])) &&
+             IsNear(Read<DRAWABLE>(scene, entities[7]).model, expected(entities[7])));
+
+    // Writes through a view count as changes too
+    Component::AdvanceTick();
+    Component::AdvanceTick();
+    Scene::Each(Scene::View<POSITION2D, ROTATION>(scene),
+                [&entities](Entity::id entity, Math::Vec2f& position, float&) {
+                  if (entity == entities[9])
+                  {
+                    position = {11, -11};
+                  }
+                });
+    AssertEqual("Test Transform View Writes Rebuilt",
+                Transform::Update(scene, scene.transforms),
+                (size_t)numEntities / 2);
+    Assert("Test Transform View Moved",
+           IsNear(Read<DRAWABLE>(scene, entities[9]).model, expected(entities[9])) &&
+             Read<DRAWABLE>(scene, entities[9]).model.rows[0].w == 11.f);
+
+    // Removing a drawable reorders the dense array
+    Component::AdvanceTick();
+    Scene::DestroyEntity(scene, entities[0]);
+    Transform::Update(scene, scene.transforms);
+    isMatching = scene.transforms.models.size == drawableArray.size;
+    for (size_t i = 0; i < drawableArray.size; ++i)
+    {
+      isMatching &= scene.transforms.models[i] == drawableArray.array[i].model;
+    }
+    Assert("Test Transform Models Follow Removal", isMatching);
+
+    Entity::Reset(scene.entityData);
+    Scene::Destroy(scene);
+  }
+
+  inline void RunHierarchy()
+  {
+    using namespace Component::Type;
+
+    Scene::SceneFns sceneFns;
+    Scene::Data scene;
+    scene.sceneFns = &sceneFns;
+    Scene::Initialize(scene);
+
+    auto add = [&scene](Math::Vec2f position, Entity::id parent, bool isDrawn) {
+      Entity::id entity = Scene::CreateEntity(scene);
+      Scene::AddComponent<POSITION2D>(scene, entity, position);
+      Scene::AddComponent<SCALE>(scene, entity, {1, 1});
+      if (parent != Entity::MAX)
+      {
+        Scene::AddComponent<PARENT>(scene, entity, parent);
+      }
+      if (isDrawn)
+      {
+        Drawable::Data drawable{};
+        drawable.entity = entity;
+        Scene::AddComponent<DRAWABLE>(scene, entity, drawable);
+      }
+      return entity;
+    };
+
+    // Panel turned a quarter and scaled by 2, a button on it and a label on the button
+    Entity::id panel = add({10, 0}, Entity::MAX, false);
+    Scene::Get<SCALE>(scene, panel) = {2, 2};
+    Scene::AddComponent<ROTATION>(scene, panel, Math::PI / 2);
+    Entity::id button = add({1, 0}, panel, true);
+    Scene::Get<DRAWABLE>(scene, button).offset = {0, 1, 0};
+    Entity::id label = add({0, 1}, button, true);
+
+    // Lots of small composite sprites next to it
+    constexpr int numRoots = 2000;
+    DynamicArray<Entity::id> roots(true, numRoots);
+    DynamicArray<Entity::id> leaves(true, numRoots);
+    for (int i = 0; i < numRoots; ++i)
+    {
+      Entity::id root = add({(float)i, 0}, Entity::MAX, true);
+      Entity::id part = add({0, 1}, root, true);
+      leaves.PushBack(add({1, 0}, part, true));
+      add({-1, 0}, root, true);
+      roots.PushBack(root);
+    }
+
+    Transform::Update(scene, scene.transforms);
+    const auto& nodes = scene.transforms.nodes;
+    bool isSorted = nodes.size == 3 + numRoots * 4 && scene.transforms.roots.size == numRoots + 2;
+    for (size_t i = 0; i < nodes.size; ++i)
+    {
+      isSorted &= nodes[i].parent == Transform::NONE || nodes[i].parent < i;
+      isSorted &= Transform::NodeIndex(scene.transforms, nodes[i].entity) == i;
+    }
+    Assert("Test Transform Hierarchy Parents First", isSorted);
+
+    // Button: panel * (position + offset) | Label: panel * button * position
+    Math::Mat4 expected{};
+    expected.rows[0] = {0, -2, 0, 8};
+    expected.rows[1] = {2, 0, 0, 2};
+    Assert("Test Transform Hierarchy Child", IsNear(Read<DRAWABLE>(scene, button).model, expected));
+    expected.rows[0] = {0, -2, 0, 8};
+    expected.rows[1] = {2, 0, 0, 2};
+    Assert("Test Transform Hierarchy Grandchild", IsNear(Read<DRAWABLE>(scene, label).model, expected));
+    expected = {};
+    expected.rows[0] = {1, 0, 0, 4};
+    expected.rows[1] = {0, 1, 0, 1};
+    Assert("Test Transform Hierarchy Composite", IsNear(Read<DRAWABLE>(scene, leaves[3]).model, expected));
+
+    Component::AdvanceTick();
+    Transform::Update(scene, scene.transforms);
+    Component::AdvanceTick();
+    AssertEqual("Test Transform Hierarchy Nothing Dirty", Transform::Update(scene, scene.transforms), 0ul);
+
+    // Only the moved subtree gets recomputed
+    Component::AdvanceTick();
+    Scene::Get<POSITION2D>(scene, panel) = {0, 0};
+    {
+      auto timer = Timer("Transform Hierarchy Move One Root");
+      AssertEqual("Test Transform Hierarchy Dirty Subtree", Transform::Update(scene, scene.transforms), 2ul);
+    }
+    expected.rows[0] = {0, -2, 0, -2};
+    expected.rows[1] = {2, 0, 0, 2};
+    Assert("Test Transform Hierarchy Moved Grandchild", IsNear(Read<DRAWABLE>(scene, label).model, expected));
+
+    // The move was stamped with the tick of the last Update, so it's picked up once more
+    Component::AdvanceTick();
+    AssertEqual("Test Transform Hierarchy Same Tick Subtree", Transform::Update(scene, scene.transforms), 2ul);
+    Component::AdvanceTick();
+    for (auto root : roots)
+    {
+      Scene::Get<POSITION2D>(scene, root).y += 1;
+    }
+    size_t count = 0;
+    {
+      auto timer = Timer("Transform Hierarchy Move All 8000");
+      count = Transform::Update(scene, scene.transforms);
+    }
+    AssertEqual("Test Transform Hierarchy All Dirty", count, (size_t)numRoots * 4);
+
+    // Reparenting moves the label over to a sprite
+    Component::AdvanceTick();
+    Scene::Get<PARENT>(scene, label) = roots[0];
+    Transform::Update(scene, scene.transforms);
+    expected = {};
+    expected.rows[0] = {1, 0, 0, 0};
+    expected.rows[1] = {0, 1, 0, 2};
+    Assert("Test Transform Hierarchy Reparent", IsNear(Read<DRAWABLE>(scene, label).model, expected));
+
+    // Destroying a parent without a position turns its children into roots
+    Component::AdvanceTick();
+    Entity::id bare = Scene::CreateEntity(scene);
+    Entity::id orphan = add({3, 0}, bare, true);
+    Transform::Update(scene, scene.transforms);
+    Assert("Test Transform Hierarchy Bare Parent", Transform::NodeIndex(scene.transforms, bare) != Transform::NONE);
+    Component::AdvanceTick();
+    Scene::DestroyEntity(scene, bare);
+    Transform::Update(scene, scene.transforms);
+    Assert("Test Transform Hierarchy Destroyed Parent",
+           Transform::NodeIndex(scene.transforms, orphan) == Transform::NONE &&
+             Scene::GetComponentArray<PARENT>(scene).sparseIndices[orphan] == SIZE_MAX);
+    AssertEqual("Test Transform Hierarchy Orphan", Read<DRAWABLE>(scene, orphan).model.rows[0].w, 3.f);
+
+    // Parented and destroyed before the hierarchy saw the link
+    Component::AdvanceTick();
+    Entity::id unlinked = Scene::CreateEntity(scene);
+    Entity::id stray = add({4, 0}, unlinked, true);
+    Scene::DestroyEntity(scene, unlinked);
+    Transform::Update(scene, scene.transforms);
+    Assert("Test Transform Hierarchy Destroyed Unlinked Parent",
+           Transform::NodeIndex(scene.transforms, stray) == Transform::NONE &&
+             Scene::GetComponentArray<PARENT>(scene).sparseIndices[stray] == SIZE_MAX);
+
+    // Cycles are left out
+    Component::AdvanceTick();
+    Entity::id a = add({0, 0}, Entity::MAX, true);
+    Entity::id b = add({0, 0}, a, true);
+    Scene::AddComponent<PARENT>(scene, a, b);
+    Transform::Update(scene, scene.transforms);
+    Assert("Test Transform Hierarchy Cycle",
+           Transform::NodeIndex(scene.transforms, a) == Transform::NONE &&
+             Transform::NodeIndex(scene.transforms, b) == Transform::NONE);
+
+    Entity::Reset(scene.entityData);
+    Scene::Destroy(scene);
+  }
+
+  inline void RunInterpolate()
+  {
+    using namespace Component::Type;
+
+    Scene::SceneFns sceneFns;
+    Scene::Data scene;
+    scene.sceneFns = &sceneFns;
+    Scene::Initialize(scene);
+    scene.transforms.isInterpolated = true;
+
+    DynamicArray<Entity::id> entities(true, 64);
+    for (int i = 0; i < 64; ++i)
+    {
+      Entity::id entity = Scene::CreateEntity(scene);
+      Scene::AddComponent<POSITION2D>(scene, entity, {(float)i, 0});
+      Scene::AddComponent<SCALE>(scene, entity, {1, 1});
+      Drawable::Data drawable{};
+      drawable.entity = entity;
+      Scene::AddComponent<DRAWABLE>(scene, entity, drawable);
+      entities.PushBack(entity);
+    }
+    Transform::Update(scene, scene.transforms);
+    Component::AdvanceTick();
+    Transform::Update(scene, scene.transforms);
+
+    // One tick moves the first entity from x 0 to 10
+    Component::AdvanceTick();
+    Scene::Get<POSITION2D>(scene, entities[0]).x = 10;
+    Transform::Update(scene, scene.transforms);
+    Transform::Interpolate(scene, scene.transforms, 0.25f);
+    AssertEqual("Test Transform Interpolate Moved", Read<DRAWABLE>(scene, entities[0]).model.rows[0].w, 2.5f);
+    AssertEqual("Test Transform Interpolate Still", Read<DRAWABLE>(scene, entities[5]).model.rows[0].w, 5.f);
+    Transform::Interpolate(scene, scene.transforms, 1.f);
+    AssertEqual("Test Transform Interpolate Latest", Read<DRAWABLE>(scene, entities[0]).model.rows[0].w, 10.f);
+
+    // Nothing moved in the tick after
+    Component::AdvanceTick();
+    Transform::Update(scene, scene.transforms);
+    Component::AdvanceTick();
+    Transform::Update(scene, scene.transforms);
+    Transform::Interpolate(scene, scene.transforms, 0.25f);
+    AssertEqual("Test Transform Interpolate Settled", Read<DRAWABLE>(scene, entities[0]).model.rows[0].w, 10.f);
+
+    // A quarter turn is halfway at 45 degrees without shrinking
+    Component::AdvanceTick();
+    Scene::AddComponent<ROTATION>(scene, entities[2], 0.f);
+    Transform::Update(scene, scene.transforms);
+    Component::AdvanceTick();
+    Transform::Update(scene, scene.transforms);
+    Component::AdvanceTick();
+    Scene::Get<ROTATION>(scene, entities[2]) = Math::PI / 2;
+    Transform::Update(scene, scene.transforms);
+    Transform::Interpolate(scene, scene.transforms, 0.5f);
+    float half = sqrtf(0.5f);
+    Assert("Test Transform Interpolate Turn",
+           IsNear(Read<DRAWABLE>(scene, entities[2]).model.rows[0], {half, -half, 0, 2}) &&
+             IsNear(Read<DRAWABLE>(scene, entities[2]).model.rows[1], {half, half, 0, 0}));
+
+    // Removing a drawable moves rows, the models snap instead of blending
+    Component::AdvanceTick();
+    Scene::Get<POSITION2D>(scene, entities[5]).x = 100;
+    Scene::DestroyEntity(scene, entities[1]);
+    Transform::Update(scene, scene.transforms);
+    Transform::Interpolate(scene, scene.transforms, 0.25f);
+    AssertEqual("Test Transform Interpolate Rebuild", Read<DRAWABLE>(scene, entities[5]).model.rows[0].w, 100.f);
+
+    Entity::Reset(scene.entityData);
+    Scene::Destroy(scene);
+  }
+}
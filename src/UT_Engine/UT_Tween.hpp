@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2024 Ujwal Vujjini
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "ComponentType.hpp"
+#include "Scene.hpp"
+#include "Tween.hpp"
+#include "UT_Common.hpp"
+
+namespace Temp::Component::Tween::UnitTests
+{
+  inline void Run()
+  {
+    using namespace Component::Type;
+
+    Scene::SceneFns sceneFns;
+    Scene::Data scene;
+    scene.sceneFns = &sceneFns;
+    Scene::Initialize(scene);
+    auto& tweens = scene.tweens;
+
+    Entity::id entity = Scene::CreateEntity(scene);
+    Scene::AddComponent<POSITION2D>(scene, entity, {0, 0});
+    Scene::AddComponent<SCALE>(scene, entity, {1, 1});
+
+    Add(tweens, entity, POSITION_X, 0, 10, 1.f);
+    Add(tweens, entity, POSITION_Y, 0, 10, 1.f, EASE_IN);
+    To(scene, tweens, entity, SCALE_X, 2.f, 0.5f, EASE_OUT);
+    float alpha = 1.f;
+    Add(tweens, &alpha, 1.f, 0.f, 2.f, SMOOTHSTEP);
+    AssertEqual("Test Tween Add", tweens.entities.size, 4ul);
+
+    Component::AdvanceTick();
+    AssertEqual("Test Tween Update Running", Update(scene, tweens, 0.25f), 4ul);
+    const auto& position =
+      Component::Get(std::as_const(Scene::GetComponentArray<POSITION2D>(scene)), entity);
+    const auto& scale = Component::Get(std::as_const(Scene::GetComponentArray<SCALE>(scene)), entity);
+    Assert("Test Tween Linear", Math::FloatEqual(position.x, 2.5f));
+    Assert("Test Tween Ease In", Math::FloatEqual(position.y, 0.625f));
+    Assert("Test Tween Ease Out", Math::FloatEqual(scale.x, 1.75f));
+    Assert("Test Tween Value", Math::FloatEqual(alpha, 1.f - Ease(SMOOTHSTEP, 0.125f)));
+    const auto& positionArray = Scene::GetComponentArray<POSITION2D>(scene);
+    Assert("Test Tween Marks Changed",
+           positionArray.changed[positionArray.sparseIndices[entity]] == Component::Tick());
+
+    AssertEqual("Test Tween Finished Dropped", Update(scene, tweens, 0.25f), 3ul);
+    Assert("Test Tween Finished Lands On End", scale.x == 2.f);
+
+    // Restarting a property replaces its running tween
+    To(scene, tweens, entity, POSITION_X, -5.f, 1.f);
+    Assert("Test Tween To Starts At Current", tweens.start[tweens.start.size - 1] == position.x);
+    AssertEqual("Test Tween To Replaces", Update(scene, tweens, 0.f), 3ul);
+
+    Stop(tweens, entity);
+    AssertEqual("Test Tween Stop", Update(scene, tweens, 0.f), 1ul);
+    float fade = 1.f;
+    Add(tweens, &fade, 1.f, 0.f, 1.f);
+    AssertEqual("Test Tween Stop Value", Stop(tweens, &fade), 1ul);
+    AssertEqual("Test Tween Stop Value Only Target", tweens.entities.size, 1ul);
+    Update(scene, tweens, 10.f);
+    Assert("Test Tween Value Finished", alpha == 0.f && tweens.entities.size == 0);
+
+    // Tweens of an entity that lost the component are dropped
+    Add(tweens, entity, ROTATION, 0, 1, 1.f);
+    AssertEqual("Test Tween Missing Component", Update(scene, tweens, 0.1f), 0ul);
+
+    // Reused ids don't inherit the tweens of a destroyed entity
+    Add(tweens, entity, POSITION_X, 0, 1, 1.f);
+    Scene::DestroyEntity(scene, entity);
+    entity = Scene::CreateEntity(scene);
+    Scene::AddComponent<POSITION2D>(scene, entity, {0, 0});
+    Scene::AddComponent<SCALE>(scene, entity, {1, 1});
+    AssertEqual("Test Tween Destroy Stops", Update(scene, tweens, 0.5f), 0ul);
+    Assert("Test Tween Destroy Stops Writes",
+           Component::Get(std::as_const(Scene::GetComponentArray<POSITION2D>(scene)), entity).x == 0.f);
+
+    // SIMD batches against the scalar easing
+    constexpr size_t numTweens = 50003;
+    for (size_t i = 0; i < numTweens; ++i)
+    {
+      Add(tweens,
+          entity,
+          i % 2 ? SCALE_Y : POSITION_Y,
+          (float)i,
+          (float)i * 2,
+          1.f + (float)(i % 7),
+          (Easing)(i % 5));
+    }
+    {
+      auto timer = Timer("Tween Update 50k");
+      Update(scene, tweens, 0.5f);
+    }
+    bool isMatching = true;
+    for (size_t i = 0; i < numTweens; ++i)
+    {
+      float t = 0.5f / (1.f + (float)(i % 7));
+      float expected = (float)i + (float)i * Ease((Easing)(i % 5), t);
+      isMatching &= Math::Abs(tweens.values[i] - expected) <= Math::Max(1e-5f * (float)i, 1e-5f);
+    }
+    Assert("Test Tween SIMD Matches Scalar", isMatching);
+
+    Entity::Reset(scene.entityData);
+    Scene::Destroy(scene);
+  }
+}